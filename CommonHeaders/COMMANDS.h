@@ -36,10 +36,33 @@ enum COMMANDS{
     CMD_SET_PWM_LEVEL_MAX_VALUE, /* deprecated */
     CMD_SET_SMOOTH_SLOWDOWN,
     CMD_SET_BRIGHTNESS,
+    CMD_UPDATE_LEDS_DELTA, /* since fw4.5, fw5.2 and fw6.2 */
+    CMD_FRAME_DATA,        /* since fw4.6, fw5.3 and fw6.3 */
+    CMD_FRAME_COMMIT,
+    CMD_UPDATE_LEDS_PACKED, /* since fw4.7, fw5.4 and fw6.4 */
 
     CMD_NOP = 0x0F
 };
 
+// CMD_UPDATE_LEDS_DELTA data: bitmap of changed LEDs (bit i of byte i/8
+// is LED i), then colors of changed LEDs only, in CMD_UPDATE_LEDS format
+#define UPDATE_LEDS_DELTA_BITMAP_SIZE   2
+
+// Frames with more LEDs than one report holds are sent in several reports.
+// CMD_FRAME_DATA data: frame id, index of the first LED (2 bytes, low byte
+// first), count of LEDs, then colors in CMD_UPDATE_LEDS format.
+// CMD_FRAME_COMMIT data: frame id, count of LEDs in frame (2 bytes, low byte
+// first). Device shows frame only if all its LEDs came with the same frame id.
+#define FRAME_DATA_HEADER_SIZE          4
+#define FRAME_DATA_MAX_LEDS             9   /* (64 - 1 - FRAME_DATA_HEADER_SIZE) / 6 */
+
+// CMD_UPDATE_LEDS_PACKED data: 12-bit channels R, G, B of LED 0, then of
+// LED 1 and so on. Each two channels are packed in 3 bytes: 8 high bits of
+// the first, its 4 low bits with 4 high bits of the second, 8 low bits of
+// the second. Device with 8-bit colors (hw < 6) ignores 4 low bits.
+#define UPDATE_LEDS_PACKED_SIZE(ledsCount)  (((ledsCount) * 9 + 1) / 2)
+#define UPDATE_LEDS_PACKED_MAX_LEDS     14  /* (64 - 1) * 2 / 9 */
+
 enum PRESCALLERS{
     CMD_SET_PRESCALLER_1,
     CMD_SET_PRESCALLER_8,
@@ -52,6 +75,8 @@ enum PRESCALLERS{
 enum DATA_VERSION_INDEXES{
     INDEX_FW_VER_MAJOR = 1,
     INDEX_FW_VER_MINOR,
+    INDEX_LEDS_COUNT_LOW,   /* since fw4.6, fw5.3 and fw6.3 */
+    INDEX_LEDS_COUNT_HIGH,
 };
 
 #endif /* COMMANDS_H_INCLUDED */
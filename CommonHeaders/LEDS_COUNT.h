@@ -32,7 +32,10 @@
 
 #if (LIGHTPACK_HW == 6)
 
+/* Daisy-chained LED drivers, 5 LEDs per driver, "make LEDS_COUNT=20" */
+#	ifndef LEDS_COUNT
 #	define LEDS_COUNT  10
+#	endif
 
 #elif (LIGHTPACK_HW == 5)
 
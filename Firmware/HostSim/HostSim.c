@@ -0,0 +1,404 @@
+/*
+ * HostSim.c
+ *
+ *  Created on: 19.10.2026
+ *      Author: Mike Shatohin (brunql)
+ *     Project: Lightpack
+ *
+ *  Lightpack is a content-appropriate ambient lighting system for any computer
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+#include <ucontext.h>
+
+#include "HostSim.h"
+
+#define NO_PIN              0xff
+#define CHAIN_BITS_MAX      (16 * 12 * ((LEDS_COUNT + 4) / 5))
+#define REPORTS_QUEUE_SIZE  16
+#define FIRMWARE_STACK_SIZE (64 * 1024)
+
+/* Firmware functions, main() of Lightpack.c is renamed by makefile */
+extern int Lightpack_Main(void);
+extern void TIMER1_COMPA_vect(void);
+extern USB_ClassInfo_HID_Device_t Generic_HID_Interface;
+
+volatile uint8_t HostSim_Registers[HOSTSIM_REGISTERS_COUNT];
+volatile uint16_t HostSim_Registers16[HOSTSIM_REGISTERS16_COUNT];
+
+/* Shift registers of LED drivers connected to port B */
+typedef struct
+{
+    uint8_t clkPin;
+    uint8_t dataPin;
+    uint8_t latchPin;
+
+    /* Bits shifted since the last latch pulse, in order of shifting */
+    uint8_t bits[CHAIN_BITS_MAX];
+    uint16_t bitsCount;
+
+    uint8_t latched[CHAIN_BITS_MAX];
+    uint16_t latchedCount;
+
+} Chain_t;
+
+#if (LIGHTPACK_HW == 6 || LIGHTPACK_HW == 5)
+/* Data comes from hardware SPI */
+static Chain_t s_chains[] = { { .clkPin = NO_PIN, .dataPin = NO_PIN, .latchPin = 0 } };
+#elif (LIGHTPACK_HW == 4)
+static Chain_t s_chains[] = {
+        { .clkPin = 5, .dataPin = 6, .latchPin = 4 },
+        { .clkPin = 1, .dataPin = 2, .latchPin = 0 } };
+#endif
+
+#define CHAINS_COUNT    (sizeof(s_chains) / sizeof(s_chains[0]))
+
+static volatile uint8_t s_ports[3];
+static uint8_t s_lastPortB = 0;
+
+static volatile uint8_t s_spiData = 0;
+static volatile uint8_t s_spiStatus = 0;
+static uint8_t s_isSpiDataWritten = 0;
+
+static volatile uint16_t s_timer1Counter = 0;
+static uint64_t s_timer1Cycles = 0;
+
+static uint64_t s_cycles = 0;
+static HostSim_Counters_t s_counters;
+static uint32_t s_latchesCount = 0;
+
+static const uint16_t OpsCycles[HostSim_OpsCount] = {
+        [HostSim_OpAdd16] = HOSTSIM_CYCLES_ADD16,
+        [HostSim_OpDiv16] = HOSTSIM_CYCLES_DIV16,
+        [HostSim_OpDiv32] = HOSTSIM_CYCLES_DIV32,
+        [HostSim_OpMul16] = HOSTSIM_CYCLES_MUL16,
+        [HostSim_OpMul32] = HOSTSIM_CYCLES_MUL32 };
+
+static uint8_t s_reports[REPORTS_QUEUE_SIZE][GENERIC_REPORT_SIZE];
+static uint8_t s_reportsHead = 0;
+static uint8_t s_reportsCount = 0;
+
+static ucontext_t s_hostContext;
+static ucontext_t s_firmwareContext;
+static uint8_t s_firmwareStack[FIRMWARE_STACK_SIZE];
+
+static inline void _AddCycles(const uint32_t cycles)
+{
+    s_cycles += cycles;
+    s_counters.cycles += cycles;
+}
+
+static void _ShiftBit(Chain_t *chain, const uint8_t bit)
+{
+    // Shift register keeps only the last bits
+    if (chain->bitsCount == CHAIN_BITS_MAX)
+    {
+        memmove(chain->bits, chain->bits + 1, CHAIN_BITS_MAX - 1);
+        chain->bitsCount--;
+    }
+    chain->bits[chain->bitsCount++] = bit;
+}
+
+static void _Latch(Chain_t *chain)
+{
+    memcpy(chain->latched, chain->bits, chain->bitsCount);
+    chain->latchedCount = chain->bitsCount;
+    chain->bitsCount = 0;
+}
+
+/* Port value is written after HostSim_Port() returns, so edges of the
+ * previous write are found on the next access */
+static void _ProcessPortB(void)
+{
+    uint8_t port = s_ports[HostSim_PortB];
+    uint8_t rising = port & ~s_lastPortB;
+
+    for (uint8_t c = 0; c < CHAINS_COUNT; c++)
+    {
+        Chain_t *chain = &s_chains[c];
+
+        if (chain->clkPin != NO_PIN && (rising & _BV(chain->clkPin)))
+            _ShiftBit(chain, (port >> chain->dataPin) & 0x01);
+
+        if (rising & _BV(chain->latchPin))
+        {
+            _Latch(chain);
+            if (c == 0)
+                s_latchesCount++;
+        }
+    }
+
+    s_lastPortB = port;
+}
+
+volatile uint8_t * HostSim_Port(const uint8_t port)
+{
+    if (port == HostSim_PortB)
+        _ProcessPortB();
+
+    s_counters.portWrites++;
+    _AddCycles(HOSTSIM_CYCLES_PORT_WRITE);
+
+    return &s_ports[port];
+}
+
+volatile uint8_t * HostSim_SpiData(void)
+{
+    // SPDR is only written by firmware, byte is sent on status polling
+    s_isSpiDataWritten = 1;
+    return &s_spiData;
+}
+
+volatile uint8_t * HostSim_SpiStatus(void)
+{
+    if (s_isSpiDataWritten)
+    {
+        s_isSpiDataWritten = 0;
+
+        for (uint8_t bit = 0x80; bit != 0; bit >>= 1)
+            _ShiftBit(&s_chains[0], (s_spiData & bit) ? 1 : 0);
+
+        s_counters.spiBytes++;
+        _AddCycles(HOSTSIM_CYCLES_SPI_BYTE);
+
+        s_spiStatus |= _BV(SPIF);
+    }
+    return &s_spiStatus;
+}
+
+volatile uint16_t * HostSim_Timer1Counter(void)
+{
+    s_counters.timerPolls++;
+    _AddCycles(HOSTSIM_CYCLES_TIMER_POLL);
+
+    // Timer runs without prescaler
+    s_timer1Counter += s_cycles - s_timer1Cycles;
+    s_timer1Cycles = s_cycles;
+
+    return &s_timer1Counter;
+}
+
+void HostSim_CountOps(const uint8_t op, const uint8_t count)
+{
+    s_counters.ops[op] += count;
+    _AddCycles((uint32_t)OpsCycles[op] * count);
+}
+
+/*
+ *  LUFA stubs
+ */
+
+void USB_Init(void)
+{
+}
+
+void USB_USBTask(void)
+{
+}
+
+void USB_Device_EnableSOFEvents(void)
+{
+}
+
+void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+{
+    if (s_reportsCount == 0)
+        return;
+
+    uint8_t *report = s_reports[s_reportsHead];
+
+    s_reportsHead = (s_reportsHead + 1) % REPORTS_QUEUE_SIZE;
+    s_reportsCount--;
+
+    CALLBACK_HID_Device_ProcessHIDReport(HIDInterfaceInfo, 0, HID_REPORT_ITEM_Out, report, GENERIC_REPORT_SIZE);
+}
+
+bool HID_Device_ConfigureEndpoints(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+{
+    return true;
+}
+
+void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+{
+}
+
+void HID_Device_MillisecondElapsed(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+{
+}
+
+/*
+ *  Firmware main loop
+ */
+
+static void _FirmwareMain(void)
+{
+    Lightpack_Main();
+}
+
+void HostSim_WatchdogReset(void)
+{
+    swapcontext(&s_firmwareContext, &s_hostContext);
+}
+
+void HostSim_Init(void)
+{
+    getcontext(&s_firmwareContext);
+    s_firmwareContext.uc_stack.ss_sp = s_firmwareStack;
+    s_firmwareContext.uc_stack.ss_size = sizeof(s_firmwareStack);
+    s_firmwareContext.uc_link = NULL;
+    makecontext(&s_firmwareContext, _FirmwareMain, 0);
+
+    // Hardware setup, returns on the first wdt_reset() of main loop
+    swapcontext(&s_hostContext, &s_firmwareContext);
+}
+
+void HostSim_RunMainLoop(const uint16_t iterations)
+{
+    memset(&s_counters, 0, sizeof(s_counters));
+
+    for (uint16_t i = 0; i < iterations; i++)
+        swapcontext(&s_hostContext, &s_firmwareContext);
+}
+
+void HostSim_SendReport(const uint8_t *data, const uint16_t size)
+{
+    if (s_reportsCount == REPORTS_QUEUE_SIZE)
+        return;
+
+    uint8_t *report = s_reports[(s_reportsHead + s_reportsCount) % REPORTS_QUEUE_SIZE];
+
+    memset(report, 0, GENERIC_REPORT_SIZE);
+    memcpy(report, data, size < GENERIC_REPORT_SIZE ? size : GENERIC_REPORT_SIZE);
+
+    s_reportsCount++;
+}
+
+uint16_t HostSim_GetReport(uint8_t report[GENERIC_REPORT_SIZE])
+{
+    uint8_t reportId = 0;
+    uint16_t reportSize = 0;
+
+    memset(report, 0, GENERIC_REPORT_SIZE);
+    CALLBACK_HID_Device_CreateHIDReport(&Generic_HID_Interface, &reportId, HID_REPORT_ITEM_In, report, &reportSize);
+
+    return reportSize;
+}
+
+void HostSim_Tick(HostSim_Counters_t *counters)
+{
+    memset(&s_counters, 0, sizeof(s_counters));
+
+    TIMER1_COMPA_vect();
+
+    // Last write of the interrupt
+    _ProcessPortB();
+
+    if (counters != NULL)
+        *counters = s_counters;
+}
+
+void HostSim_LastCounters(HostSim_Counters_t *counters)
+{
+    *counters = s_counters;
+}
+
+uint32_t HostSim_LatchesCount(void)
+{
+    return s_latchesCount;
+}
+
+/*
+ *  Decoding of latched data, in order firmware writes it
+ */
+
+static uint16_t _LatchedWord(const Chain_t *chain, const uint16_t firstBit, const uint8_t bitsCount)
+{
+    uint16_t word = 0;
+
+    for (uint8_t b = 0; b < bitsCount; b++)
+    {
+        uint16_t i = firstBit + b;
+        word = (word << 1) | (i < chain->latchedCount ? chain->latched[i] : 0);
+    }
+    return word;
+}
+
+void HostSim_LatchedColors(RGB_t colors[LEDS_COUNT])
+{
+    memset(colors, 0, sizeof(RGB_t) * LEDS_COUNT);
+
+#if (LIGHTPACK_HW == 6)
+
+    // 16 channels of 12 bits per driver, the last driver is written first,
+    // each driver gets unused channel then B, G, R of its 5 LEDs
+    const uint8_t driversCount = (LEDS_COUNT + 5 - 1) / 5;
+    const Chain_t *chain = &s_chains[0];
+
+    for (uint8_t d = 0; d < driversCount; d++)
+    {
+        uint8_t driver = driversCount - 1 - d;
+        uint16_t channel = d * 16 + 1;
+
+        for (uint8_t k = 0; k < 5; k++, channel += 3)
+        {
+            uint8_t i = driver * 5 + k;
+            if (i >= LEDS_COUNT)
+                break;
+
+            colors[i].b = _LatchedWord(chain, (channel + 0) * 12, 12);
+            colors[i].g = _LatchedWord(chain, (channel + 1) * 12, 12);
+            colors[i].r = _LatchedWord(chain, (channel + 2) * 12, 12);
+        }
+    }
+
+#elif (LIGHTPACK_HW == 5)
+
+    // Two 16-bit words, LEDs 5..9 first, then 0..4; R, G, B bits of
+    // each LED starting from the least significant bit
+    const Chain_t *chain = &s_chains[0];
+    uint16_t words[2] = { _LatchedWord(chain, 0, 16), _LatchedWord(chain, 16, 16) };
+
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+    {
+        uint16_t word = (i < 5) ? words[1] : words[0];
+        uint8_t bit = (i % 5) * 3;
+
+        colors[i].r = (word >> (bit + 0)) & 0x01;
+        colors[i].g = (word >> (bit + 1)) & 0x01;
+        colors[i].b = (word >> (bit + 2)) & 0x01;
+    }
+
+#elif (LIGHTPACK_HW == 4)
+
+    // Each driver gets NC, B, G, R bits of its 4 LEDs, the last LED first
+    for (uint8_t c = 0; c < CHAINS_COUNT; c++)
+    {
+        for (uint8_t k = 0; k < 4; k++)
+        {
+            uint8_t i = c * 4 + 3 - k;
+            uint16_t bits = _LatchedWord(&s_chains[c], k * 4, 4);
+
+            colors[i].b = (bits >> 2) & 0x01;
+            colors[i].g = (bits >> 1) & 0x01;
+            colors[i].r = (bits >> 0) & 0x01;
+        }
+    }
+
+#endif
+}
@@ -0,0 +1,90 @@
+/*
+ * HostSim.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: Mike Shatohin (brunql)
+ *     Project: Lightpack
+ *
+ *  Lightpack is a content-appropriate ambient lighting system for any computer
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef HOSTSIM_H_INCLUDED
+#define HOSTSIM_H_INCLUDED
+
+/* Host build of firmware logic. Firmware sources are compiled against
+ * stub AVR and LUFA headers from stubs/, firmware main() runs as
+ * coroutine and timer interrupt is called by test. */
+
+#include <stdint.h>
+#include <avr/io.h>
+
+#include "../datatypes.h"
+#include "../Descriptors.h"
+
+/* Estimated AVR cycles of counted operations. Only I/O and marked
+ * arithmetic are counted, so estimate is a lower bound. */
+#define HOSTSIM_CYCLES_PORT_WRITE   2   /* sbi, cbi */
+#define HOSTSIM_CYCLES_SPI_BYTE     18  /* F_CPU / 2 SPI clock and polling */
+#define HOSTSIM_CYCLES_TIMER_POLL   6   /* one iteration of busy waiting on TCNT1 */
+#define HOSTSIM_CYCLES_ADD16        8   /* with loads and stores */
+#define HOSTSIM_CYCLES_DIV16        230 /* __udivmodhi4 */
+#define HOSTSIM_CYCLES_DIV32        650 /* __udivmodsi4 */
+#define HOSTSIM_CYCLES_MUL16        130 /* __mulhi3 without MUL instruction */
+#define HOSTSIM_CYCLES_MUL32        400 /* __mulsi3 without MUL instruction */
+
+typedef struct
+{
+    uint32_t portWrites;
+    uint32_t spiBytes;
+    uint32_t timerPolls;
+    uint32_t ops[HostSim_OpsCount];
+
+    uint32_t cycles;
+
+} HostSim_Counters_t;
+
+/* Runs firmware main() until its main loop */
+extern void HostSim_Init(void);
+
+/* Runs iterations of firmware main loop, each passes at most one
+ * queued report to firmware */
+extern void HostSim_RunMainLoop(const uint16_t iterations);
+
+/* Queues output report from host, data starts with command byte.
+ * Report is padded with zeros to GENERIC_REPORT_SIZE. */
+extern void HostSim_SendReport(const uint8_t *data, const uint16_t size);
+
+/* Gets input report from firmware, returns its size */
+extern uint16_t HostSim_GetReport(uint8_t report[GENERIC_REPORT_SIZE]);
+
+/* Calls timer interrupt, counters of this tick are stored to counters
+ * if it isn't NULL */
+extern void HostSim_Tick(HostSim_Counters_t *counters);
+
+/* Counters of the last HostSim_RunMainLoop() or HostSim_Tick() */
+extern void HostSim_LastCounters(HostSim_Counters_t *counters);
+
+/* Count of latch pulses of LED drivers since HostSim_Init() */
+extern uint32_t HostSim_LatchesCount(void);
+
+/* Colors latched by LED drivers on the last latch pulse: 12-bit values
+ * for hw6.x, 1 or 0 of the current PWM level for hw4.x and hw5.x */
+extern void HostSim_LatchedColors(RGB_t colors[LEDS_COUNT]);
+
+#endif /* HOSTSIM_H_INCLUDED */
@@ -0,0 +1,684 @@
+/*
+ * HostSimTest.c
+ *
+ *  Created on: 19.10.2026
+ *      Author: Mike Shatohin (brunql)
+ *     Project: Lightpack
+ *
+ *  Lightpack is a content-appropriate ambient lighting system for any computer
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "HostSim.h"
+#include "../version.h"
+#include "../../CommonHeaders/COMMANDS.h"
+
+/* Unit tests of firmware report processing, smoothing and LED driver
+ * output. Run with "--bench" to print operations per timer tick. */
+
+extern Images_t g_Images;
+extern Settings_t g_Settings;
+
+static uint32_t s_checksCount = 0;
+static uint32_t s_failuresCount = 0;
+
+#define CHECK_EQUAL(actual, expected) \
+    do { \
+        long _actual = (long)(actual), _expected = (long)(expected); \
+        s_checksCount++; \
+        if (_actual != _expected) \
+        { \
+            s_failuresCount++; \
+            printf("FAIL %s:%d %s: %s is %ld, expected %ld\n", __FILE__, __LINE__, __func__, #actual, _actual, _expected); \
+        } \
+    } while (0)
+
+#define CHECK(condition)    CHECK_EQUAL((condition) != 0, 1)
+
+#if (LIGHTPACK_HW == 6)
+#   define MAX_COLOR    0x0fff
+#else
+/* Below default maxPwmValue, so PWM duty equals to the color */
+#   define MAX_COLOR    0x7f
+#endif
+
+#define REPORT_LEDS_MAX     ((GENERIC_REPORT_SIZE - 1) / 6)
+
+static RGB_t _TestColor(const uint8_t i, const uint8_t seed)
+{
+    RGB_t color;
+    color.r = (seed * 37 + i * 101 + 1) & MAX_COLOR;
+    color.g = (seed * 53 + i * 67 + 2) & MAX_COLOR;
+    color.b = (seed * 71 + i * 29 + 3) & MAX_COLOR;
+    return color;
+}
+
+/* Color of LED in CMD_UPDATE_LEDS format */
+static void _PutColor(uint8_t *data, const RGB_t color)
+{
+#if (LIGHTPACK_HW == 6)
+    data[0] = color.r >> 4;
+    data[1] = color.g >> 4;
+    data[2] = color.b >> 4;
+    data[3] = color.r & 0x0f;
+    data[4] = color.g & 0x0f;
+    data[5] = color.b & 0x0f;
+#else
+    data[0] = color.r;
+    data[1] = color.g;
+    data[2] = color.b;
+    data[3] = data[4] = data[5] = 0;
+#endif
+}
+
+/* 12-bit channel in CMD_UPDATE_LEDS_PACKED format, hw < 6 gets 8 high bits */
+static void _PutPackedChannel(uint8_t *data, const uint8_t channel, const uint16_t color)
+{
+#if (LIGHTPACK_HW == 6)
+    const uint16_t value = color;
+#else
+    // Low bits are ignored by device
+    const uint16_t value = (color << 4) | (channel & 0x0f);
+#endif
+    uint8_t *bytes = data + (channel / 2) * 3;
+
+    if (channel & 0x01)
+    {
+        bytes[1] |= (value >> 8) & 0x0f;
+        bytes[2] = value & 0xff;
+    } else {
+        bytes[0] = value >> 4;
+        bytes[1] |= (value & 0x0f) << 4;
+    }
+}
+
+static void _SendCommand(const uint8_t cmd, const uint8_t arg1, const uint8_t arg2)
+{
+    uint8_t report[3] = { cmd, arg1, arg2 };
+
+    HostSim_SendReport(report, sizeof(report));
+    HostSim_RunMainLoop(1);
+}
+
+static void _SendUpdateLeds(const uint8_t seed)
+{
+    uint8_t report[GENERIC_REPORT_SIZE] = { CMD_UPDATE_LEDS };
+
+    for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        _PutColor(report + 1 + i * 6, _TestColor(i, seed));
+
+    HostSim_SendReport(report, sizeof(report));
+    HostSim_RunMainLoop(1);
+}
+
+static void _SendFrameData(const uint8_t frameId, const uint8_t first, const uint8_t count, const uint8_t seed)
+{
+    uint8_t report[GENERIC_REPORT_SIZE] = { CMD_FRAME_DATA, frameId, first, 0, count };
+
+    for (uint8_t k = 0; k < count; k++)
+        _PutColor(report + 1 + FRAME_DATA_HEADER_SIZE + k * 6, _TestColor(first + k, seed));
+
+    HostSim_SendReport(report, sizeof(report));
+    HostSim_RunMainLoop(1);
+}
+
+/* Colors shown by LED drivers. For PWM hardware it is count of PWM
+ * levels with LED switched on, i.e. the color. */
+static void _OutputColors(RGB_t colors[LEDS_COUNT])
+{
+#if (LIGHTPACK_HW == 6)
+    // Timer interrupt prepares frame, main loop shifts it to drivers
+    HostSim_Tick(NULL);
+    HostSim_RunMainLoop(1);
+    HostSim_LatchedColors(colors);
+#else
+    RGB_t levels[LEDS_COUNT];
+
+    memset(colors, 0, sizeof(RGB_t) * LEDS_COUNT);
+
+    for (uint16_t pwm = 0; pwm < g_Settings.maxPwmValue; pwm++)
+    {
+        HostSim_Tick(NULL);
+        HostSim_LatchedColors(levels);
+
+        for (uint8_t i = 0; i < LEDS_COUNT; i++)
+        {
+            colors[i].r += levels[i].r;
+            colors[i].g += levels[i].g;
+            colors[i].b += levels[i].b;
+        }
+    }
+#endif
+}
+
+static void _CheckColor(const RGB_t actual, const RGB_t expected, const uint8_t led)
+{
+    if (actual.r != expected.r || actual.g != expected.g || actual.b != expected.b)
+        printf("  LED %d: %d %d %d, expected %d %d %d\n", led,
+               actual.r, actual.g, actual.b, expected.r, expected.g, expected.b);
+
+    CHECK_EQUAL(actual.r, expected.r);
+    CHECK_EQUAL(actual.g, expected.g);
+    CHECK_EQUAL(actual.b, expected.b);
+}
+
+static uint16_t _TicksPerSmoothStep(void)
+{
+#if (LIGHTPACK_HW == 6)
+    return 1;
+#else
+    return g_Settings.maxPwmValue;
+#endif
+}
+
+/*
+ *  Tests
+ */
+
+static void test_GetReport(void)
+{
+    uint8_t report[GENERIC_REPORT_SIZE];
+
+    CHECK_EQUAL(HostSim_GetReport(report), GENERIC_REPORT_SIZE);
+    CHECK_EQUAL(report[INDEX_FW_VER_MAJOR], VERSION_OF_FIRMWARE_MAJOR);
+    CHECK_EQUAL(report[INDEX_FW_VER_MINOR], VERSION_OF_FIRMWARE_MINOR);
+    CHECK_EQUAL(report[INDEX_LEDS_COUNT_LOW] | (report[INDEX_LEDS_COUNT_HIGH] << 8), LEDS_COUNT);
+}
+
+static void test_UpdateLeds(void)
+{
+    RGB_t colors[LEDS_COUNT];
+    RGB_t before[LEDS_COUNT];
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+
+    _OutputColors(before);
+    _SendUpdateLeds(1);
+    _OutputColors(colors);
+
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+    {
+        // LEDs which don't fit to report keep their colors
+        _CheckColor(colors[i], i < REPORT_LEDS_MAX ? _TestColor(i, 1) : before[i], i);
+    }
+}
+
+static void test_UpdateLedsPacked(void)
+{
+    RGB_t colors[LEDS_COUNT];
+    RGB_t before[LEDS_COUNT];
+    uint8_t report[GENERIC_REPORT_SIZE] = { CMD_UPDATE_LEDS_PACKED };
+
+    CHECK_EQUAL(UPDATE_LEDS_PACKED_SIZE(UPDATE_LEDS_PACKED_MAX_LEDS) <= GENERIC_REPORT_SIZE - 1, 1);
+    CHECK_EQUAL(UPDATE_LEDS_PACKED_SIZE(UPDATE_LEDS_PACKED_MAX_LEDS + 1) > GENERIC_REPORT_SIZE - 1, 1);
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _SendUpdateLeds(13);
+    _OutputColors(before);
+
+    for (uint8_t i = 0; i < LEDS_COUNT && i < UPDATE_LEDS_PACKED_MAX_LEDS; i++)
+    {
+        RGB_t color = _TestColor(i, 14);
+
+        _PutPackedChannel(report + 1, i * 3, color.r);
+        _PutPackedChannel(report + 1, i * 3 + 1, color.g);
+        _PutPackedChannel(report + 1, i * 3 + 2, color.b);
+    }
+
+    HostSim_SendReport(report, sizeof(report));
+    HostSim_RunMainLoop(1);
+
+    _OutputColors(colors);
+
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+    {
+        // More LEDs than in CMD_UPDATE_LEDS, the rest keeps its colors
+        _CheckColor(colors[i], i < UPDATE_LEDS_PACKED_MAX_LEDS ? _TestColor(i, 14) : before[i], i);
+    }
+}
+
+static void test_UpdateLedsDelta(void)
+{
+    RGB_t colors[LEDS_COUNT];
+    uint8_t report[GENERIC_REPORT_SIZE] = { CMD_UPDATE_LEDS_DELTA, 0x0a, 0x00 };
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _SendUpdateLeds(2);
+
+    // LEDs 1 and 3 only
+    _PutColor(report + 1 + UPDATE_LEDS_DELTA_BITMAP_SIZE, _TestColor(1, 3));
+    _PutColor(report + 1 + UPDATE_LEDS_DELTA_BITMAP_SIZE + 6, _TestColor(3, 3));
+
+    HostSim_SendReport(report, sizeof(report));
+    HostSim_RunMainLoop(1);
+
+    _OutputColors(colors);
+
+    for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        _CheckColor(colors[i], _TestColor(i, (i == 1 || i == 3) ? 3 : 2), i);
+}
+
+static void test_UpdateLedsDeltaBitmapEnd(void)
+{
+    RGB_t colors[LEDS_COUNT];
+    RGB_t before[LEDS_COUNT];
+    uint8_t report[GENERIC_REPORT_SIZE] = { CMD_UPDATE_LEDS_DELTA };
+    uint8_t last = (LEDS_COUNT < UPDATE_LEDS_DELTA_BITMAP_SIZE * 8) ? LEDS_COUNT - 1 : UPDATE_LEDS_DELTA_BITMAP_SIZE * 8 - 1;
+    RGB_t color = _TestColor(last, 4);
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _OutputColors(before);
+
+    // Only the last LED of bitmap, the first byte of its color follows the
+    // bitmap and must not be read as bits of LEDs after the bitmap end
+    report[1 + last / 8] = 1 << (last % 8);
+    color.r = MAX_COLOR;
+    _PutColor(report + 1 + UPDATE_LEDS_DELTA_BITMAP_SIZE, color);
+
+    for (uint8_t k = 1; k < REPORT_LEDS_MAX; k++)
+        _PutColor(report + 1 + UPDATE_LEDS_DELTA_BITMAP_SIZE + k * 6, _TestColor(k, 5));
+
+    HostSim_SendReport(report, sizeof(report));
+    HostSim_RunMainLoop(1);
+
+    _OutputColors(colors);
+
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+        _CheckColor(colors[i], i == last ? color : before[i], i);
+}
+
+static void test_FrameDataCommit(void)
+{
+    RGB_t colors[LEDS_COUNT];
+    RGB_t before[LEDS_COUNT];
+    uint8_t commit[] = { CMD_FRAME_COMMIT, 7, LEDS_COUNT & 0xff, (LEDS_COUNT >> 8) & 0xff };
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _SendUpdateLeds(4);
+    _OutputColors(before);
+
+    for (uint8_t first = 0; first < LEDS_COUNT; first += FRAME_DATA_MAX_LEDS)
+    {
+        uint8_t count = LEDS_COUNT - first;
+        if (count > FRAME_DATA_MAX_LEDS)
+            count = FRAME_DATA_MAX_LEDS;
+
+        _SendFrameData(7, first, count, 5);
+    }
+
+    // Nothing changes before commit
+    _OutputColors(colors);
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+        _CheckColor(colors[i], before[i], i);
+
+    HostSim_SendReport(commit, sizeof(commit));
+    HostSim_RunMainLoop(1);
+
+    _OutputColors(colors);
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+        _CheckColor(colors[i], _TestColor(i, 5), i);
+}
+
+static void test_FrameLostReport(void)
+{
+    RGB_t colors[LEDS_COUNT];
+    RGB_t before[LEDS_COUNT];
+    uint8_t commit[] = { CMD_FRAME_COMMIT, 8, LEDS_COUNT & 0xff, (LEDS_COUNT >> 8) & 0xff };
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _OutputColors(before);
+
+    // Report with the last LED is lost
+    for (uint8_t first = 0; first < LEDS_COUNT - 1; first += FRAME_DATA_MAX_LEDS)
+    {
+        uint8_t count = LEDS_COUNT - 1 - first;
+        if (count > FRAME_DATA_MAX_LEDS)
+            count = FRAME_DATA_MAX_LEDS;
+
+        _SendFrameData(8, first, count, 6);
+    }
+
+    HostSim_SendReport(commit, sizeof(commit));
+    HostSim_RunMainLoop(1);
+
+    _OutputColors(colors);
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+        _CheckColor(colors[i], before[i], i);
+}
+
+static void test_OffAll(void)
+{
+    RGB_t colors[LEDS_COUNT];
+    RGB_t black = { 0, 0, 0 };
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 10, 0);
+    _SendUpdateLeds(9);
+
+    // Processed in main loop, smoothing is skipped
+    _SendCommand(CMD_OFF_ALL, 0, 0);
+
+    _OutputColors(colors);
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+        _CheckColor(colors[i], black, i);
+}
+
+static void test_Smoothing(void)
+{
+    const uint8_t slowdown = 8;
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _SendCommand(CMD_OFF_ALL, 0, 0);
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, slowdown, 0);
+
+    _SendUpdateLeds(10);
+
+    RGB_t last[LEDS_COUNT];
+    memcpy(last, g_Images.current, sizeof(last));
+
+    for (uint8_t step = 0; step <= slowdown; step++)
+    {
+        for (uint16_t t = 0; t < _TicksPerSmoothStep(); t++)
+            HostSim_Tick(NULL);
+
+        // Colors go up from black to the end colors
+        for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        {
+            CHECK(g_Images.current[i].r >= last[i].r);
+            CHECK(g_Images.current[i].g >= last[i].g);
+            CHECK(g_Images.current[i].b >= last[i].b);
+
+            CHECK(g_Images.current[i].r <= g_Images.end[i].r);
+            CHECK(g_Images.current[i].g <= g_Images.end[i].g);
+            CHECK(g_Images.current[i].b <= g_Images.end[i].b);
+        }
+        memcpy(last, g_Images.current, sizeof(last));
+    }
+
+    for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        _CheckColor(g_Images.current[i], _TestColor(i, 10), i);
+
+#if (LIGHTPACK_HW == 6)
+    // Smoothed colors are sent to LED drivers
+    RGB_t colors[LEDS_COUNT];
+    _OutputColors(colors);
+
+    for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        _CheckColor(colors[i], _TestColor(i, 10), i);
+#endif
+}
+
+/* Smoothing formula of firmware 4.6, 5.3 and 6.3 */
+static uint16_t _ReferenceSmooth(const uint16_t start, const uint16_t end, const uint8_t index, const uint8_t slowdown)
+{
+    if (index >= slowdown)
+        return end;
+
+#if (LIGHTPACK_HW == 6)
+    uint32_t coefEnd = ((uint32_t)index << 16) / slowdown;
+    uint32_t coefStart = (1UL << 16) - coefEnd;
+
+    return (coefStart * start + coefEnd * end) >> 16;
+#else
+    uint16_t coefEnd = ((uint16_t)index << 8) / slowdown;
+    uint16_t coefStart = (1UL << 8) - coefEnd;
+
+    return (coefStart * start + coefEnd * end) >> 8;
+#endif
+}
+
+static void _CheckSmooth(const uint16_t actual, const uint16_t start, const uint16_t end,
+                         const uint8_t index, const uint8_t slowdown)
+{
+    int16_t expected = _ReferenceSmooth(start, end, index, slowdown);
+    int16_t diff = (int16_t)actual - expected;
+
+    if (diff < -1 || diff > 1)
+        printf("  %d -> %d, step %d of %d: %d, expected %d\n", start, end, index, slowdown, actual, expected);
+
+    // Within one LSB
+    CHECK(diff >= -1 && diff <= 1);
+}
+
+static void test_SmoothingCurve(void)
+{
+    const uint8_t slowdowns[] = { 1, 2, 3, 7, 100, 255 };
+
+    for (uint8_t s = 0; s < sizeof(slowdowns); s++)
+    {
+        const uint8_t slowdown = slowdowns[s];
+
+        // Colors go up and down
+        for (uint8_t seed = 20; seed < 22; seed++)
+        {
+            RGB_t start[LEDS_COUNT];
+
+            _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+            _SendUpdateLeds(seed);
+
+            for (uint16_t t = 0; t < _TicksPerSmoothStep(); t++)
+                HostSim_Tick(NULL);
+
+            memcpy(start, g_Images.current, sizeof(start));
+
+            _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, slowdown, 0);
+            _SendUpdateLeds(seed + 30);
+
+            for (uint16_t index = 0; index <= slowdown; index++)
+            {
+                for (uint16_t t = 0; t < _TicksPerSmoothStep(); t++)
+                    HostSim_Tick(NULL);
+
+                for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+                {
+                    _CheckSmooth(g_Images.current[i].r, start[i].r, g_Images.end[i].r, index, slowdown);
+                    _CheckSmooth(g_Images.current[i].g, start[i].g, g_Images.end[i].g, index, slowdown);
+                    _CheckSmooth(g_Images.current[i].b, start[i].b, g_Images.end[i].b, index, slowdown);
+                }
+            }
+        }
+    }
+}
+
+static void test_SmoothSlowdownChanged(void)
+{
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _SendCommand(CMD_OFF_ALL, 0, 0);
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 10, 0);
+    _SendUpdateLeds(11);
+
+    for (uint16_t t = 0; t < 5 * _TicksPerSmoothStep(); t++)
+        HostSim_Tick(NULL);
+
+    // The rest of the way is smoothed slower, colors don't go past the end
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 40, 0);
+
+    for (uint16_t t = 0; t <= 40 * _TicksPerSmoothStep(); t++)
+    {
+        HostSim_Tick(NULL);
+
+        for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        {
+            CHECK(g_Images.current[i].r <= g_Images.end[i].r);
+            CHECK(g_Images.current[i].g <= g_Images.end[i].g);
+            CHECK(g_Images.current[i].b <= g_Images.end[i].b);
+        }
+    }
+
+    for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        _CheckColor(g_Images.current[i], _TestColor(i, 11), i);
+}
+
+#if (LIGHTPACK_HW == 6)
+static void test_FrameShiftedInMainLoop(void)
+{
+    HostSim_Counters_t tick;
+    RGB_t colors[LEDS_COUNT];
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, 0, 0);
+    _SendUpdateLeds(12);
+
+    uint32_t latchesCount = HostSim_LatchesCount();
+
+    // Timer interrupt doesn't touch LED drivers
+    HostSim_Tick(&tick);
+    CHECK_EQUAL(tick.spiBytes, 0);
+    CHECK_EQUAL(HostSim_LatchesCount(), latchesCount);
+
+    // Frame is shifted and latched once
+    HostSim_RunMainLoop(1);
+    HostSim_LastCounters(&tick);
+    CHECK_EQUAL(tick.spiBytes, 24 * ((LEDS_COUNT + 4) / 5));
+    CHECK_EQUAL(HostSim_LatchesCount(), latchesCount + 1);
+
+    HostSim_LatchedColors(colors);
+    for (uint8_t i = 0; i < LEDS_COUNT && i < REPORT_LEDS_MAX; i++)
+        _CheckColor(colors[i], _TestColor(i, 12), i);
+
+    // Nothing new without timer interrupt
+    HostSim_RunMainLoop(1);
+    CHECK_EQUAL(HostSim_LatchesCount(), latchesCount + 1);
+}
+#endif
+
+static void test_TimerOptions(void)
+{
+    _SendCommand(CMD_SET_TIMER_OPTIONS, 0x34, 0x02);
+
+    CHECK_EQUAL(OCR1A, 0x0234);
+
+    _SendCommand(CMD_SET_TIMER_OPTIONS, 100, 0);
+}
+
+/*
+ *  Benchmark
+ */
+
+static void bench_Ticks(const char *name, const uint8_t slowdown)
+{
+    const uint32_t ticksCount = 100 * _TicksPerSmoothStep();
+    // New frame comes before smoothing of the previous one is complete
+    const uint32_t ticksPerFrame = (slowdown / 2 + 1) * _TicksPerSmoothStep();
+
+    HostSim_Counters_t tick;
+    HostSim_Counters_t total;
+    HostSim_Counters_t frames;
+    HostSim_Counters_t loops;
+    uint32_t framesCount = 0;
+    uint32_t maxCycles = 0;
+
+    memset(&total, 0, sizeof(total));
+    memset(&frames, 0, sizeof(frames));
+    memset(&loops, 0, sizeof(loops));
+
+    _SendCommand(CMD_SET_SMOOTH_SLOWDOWN, slowdown, 0);
+
+    for (uint32_t t = 0; t < ticksCount; t++)
+    {
+        if (t % ticksPerFrame == 0)
+        {
+            _SendUpdateLeds(t / ticksPerFrame);
+
+            HostSim_LastCounters(&tick);
+            frames.ops[HostSim_OpDiv16] += tick.ops[HostSim_OpDiv16];
+            frames.cycles += tick.cycles;
+            framesCount++;
+        }
+
+        HostSim_Tick(&tick);
+
+        total.portWrites += tick.portWrites;
+        total.spiBytes   += tick.spiBytes;
+        total.timerPolls += tick.timerPolls;
+        total.cycles     += tick.cycles;
+
+        for (uint8_t op = 0; op < HostSim_OpsCount; op++)
+            total.ops[op] += tick.ops[op];
+
+        if (tick.cycles > maxCycles)
+            maxCycles = tick.cycles;
+
+        // Work left by interrupt for main loop, i.e. frame shifting on hw6
+        HostSim_RunMainLoop(1);
+        HostSim_LastCounters(&tick);
+
+        loops.spiBytes += tick.spiBytes;
+        loops.cycles   += tick.cycles;
+    }
+
+    double avgCycles = (double)total.cycles / ticksCount;
+
+#if (LIGHTPACK_HW == 6)
+    // Timer runs in normal mode, interrupt comes once per overflow
+    double periodCycles = 65536.0;
+#else
+    // Interrupt clears TCNT1, so the next one comes OCR1A cycles later
+    double periodCycles = avgCycles + OCR1A;
+#endif
+
+    printf("%s, hw%d, %d LEDs, %u ticks\n", name, LIGHTPACK_HW, LEDS_COUNT, ticksCount);
+    printf("  per tick: port writes %.1f, SPI bytes %.1f, timer polls %.1f\n",
+           (double)total.portWrites / ticksCount, (double)total.spiBytes / ticksCount,
+           (double)total.timerPolls / ticksCount);
+    printf("  per tick: add16 %.2f, div16 %.2f, div32 %.2f, mul16 %.2f, mul32 %.2f\n",
+           (double)total.ops[HostSim_OpAdd16] / ticksCount, (double)total.ops[HostSim_OpDiv16] / ticksCount, (double)total.ops[HostSim_OpDiv32] / ticksCount,
+           (double)total.ops[HostSim_OpMul16] / ticksCount, (double)total.ops[HostSim_OpMul32] / ticksCount);
+    printf("  estimated cycles per tick: avg %.0f, max %u, %.1f%% of timer period\n",
+           avgCycles, maxCycles, 100.0 * avgCycles / periodCycles);
+    printf("  per tick in main loop: SPI bytes %.1f, estimated cycles %.0f\n",
+           (double)loops.spiBytes / ticksCount, (double)loops.cycles / ticksCount);
+    printf("  per frame in main loop: div16 %.1f, estimated cycles %.0f\n",
+           (double)frames.ops[HostSim_OpDiv16] / framesCount, (double)frames.cycles / framesCount);
+    printf("  LEDs update rate: %.1f Hz\n",
+           F_CPU / periodCycles / (_TicksPerSmoothStep()));
+}
+
+int main(int argc, char **argv)
+{
+    HostSim_Init();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    {
+        bench_Ticks("Smoothing", 100);
+        bench_Ticks("No smoothing", 0);
+        return 0;
+    }
+
+    test_GetReport();
+    test_FrameDataCommit();
+    test_FrameLostReport();
+    test_UpdateLeds();
+    test_UpdateLedsPacked();
+    test_UpdateLedsDelta();
+    test_UpdateLedsDeltaBitmapEnd();
+    test_OffAll();
+    test_Smoothing();
+    test_SmoothingCurve();
+    test_SmoothSlowdownChanged();
+#if (LIGHTPACK_HW == 6)
+    test_FrameShiftedInMainLoop();
+#endif
+    test_TimerOptions();
+
+    printf("hw%d, %d LEDs: %u checks, %u failures\n", LIGHTPACK_HW, LEDS_COUNT, s_checksCount, s_failuresCount);
+
+    return s_failuresCount == 0 ? 0 : 1;
+}
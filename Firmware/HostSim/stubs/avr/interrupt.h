@@ -0,0 +1,34 @@
+/*
+ * avr/interrupt.h
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef HOSTSIM_AVR_INTERRUPT_H_INCLUDED
+#define HOSTSIM_AVR_INTERRUPT_H_INCLUDED
+
+/* Interrupt handlers are plain functions, simulator calls TIMER1_COMPA_vect()
+ * on each timer tick */
+#define ISR(vector) void vector(void); void vector(void)
+
+#define sei()
+#define cli()
+
+#endif /* HOSTSIM_AVR_INTERRUPT_H_INCLUDED */
@@ -0,0 +1,106 @@
+/*
+ * avr/io.h
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef HOSTSIM_AVR_IO_H_INCLUDED
+#define HOSTSIM_AVR_IO_H_INCLUDED
+
+/* Host stub of AVR registers used by firmware. Registers which output
+ * LED driver data or are polled go through HostSim.c functions, so
+ * simulator sees every access. Other registers are plain variables. */
+
+#include <stdint.h>
+
+#define _BV(bit)    (1 << (bit))
+
+enum HostSim_Ports { HostSim_PortB, HostSim_PortC, HostSim_PortD };
+
+extern volatile uint8_t * HostSim_Port(const uint8_t port);
+extern volatile uint8_t * HostSim_SpiData(void);
+extern volatile uint8_t * HostSim_SpiStatus(void);
+extern volatile uint16_t * HostSim_Timer1Counter(void);
+
+extern volatile uint8_t HostSim_Registers[];
+extern volatile uint16_t HostSim_Registers16[];
+
+#define PORTB       (*HostSim_Port(HostSim_PortB))
+#define PORTC       (*HostSim_Port(HostSim_PortC))
+#define PORTD       (*HostSim_Port(HostSim_PortD))
+
+#define SPDR        (*HostSim_SpiData())
+#define SPSR        (*HostSim_SpiStatus())
+#define TCNT1       (*HostSim_Timer1Counter())
+
+#define DDRB        HostSim_Registers[0]
+#define DDRC        HostSim_Registers[1]
+#define DDRD        HostSim_Registers[2]
+#define PINB        HostSim_Registers[3]
+#define PINC        HostSim_Registers[4]
+#define PIND        HostSim_Registers[5]
+#define SPCR        HostSim_Registers[6]
+#define TCCR0A      HostSim_Registers[7]
+#define TCCR0B      HostSim_Registers[8]
+#define TCCR1A      HostSim_Registers[9]
+#define TCCR1B      HostSim_Registers[10]
+#define TCCR1C      HostSim_Registers[11]
+#define TIMSK0      HostSim_Registers[12]
+#define TIMSK1      HostSim_Registers[13]
+#define TIFR1       HostSim_Registers[14]
+#define TCNT0       HostSim_Registers[15]
+#define WDTCSR      HostSim_Registers[16]
+
+#define OCR1A       HostSim_Registers16[0]
+
+#define HOSTSIM_REGISTERS_COUNT     17
+#define HOSTSIM_REGISTERS16_COUNT   1
+
+/* Register bits */
+#define SPIF        7
+#define SPI2X       0
+#define SPE         6
+#define MSTR        4
+#define CS00        0
+#define CS02        2
+#define CS10        0
+#define TOIE0       0
+#define OCIE1A      1
+#define OCF1A       1
+#define WDIE        6
+
+/* Counts arithmetic operations of firmware, divisions and multiplications
+ * are libgcc calls on AVR without hardware multiplier, see HostSim.h */
+enum HostSim_Ops
+{
+    HostSim_OpAdd16,
+    HostSim_OpDiv16,
+    HostSim_OpDiv32,
+    HostSim_OpMul16,
+    HostSim_OpMul32,
+
+    HostSim_OpsCount
+};
+
+#define HOSTSIM_OPS(op, count)  HostSim_CountOps(op, count)
+
+extern void HostSim_CountOps(const uint8_t op, const uint8_t count);
+
+#endif /* HOSTSIM_AVR_IO_H_INCLUDED */
@@ -0,0 +1,37 @@
+/*
+ * avr/wdt.h
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef HOSTSIM_AVR_WDT_H_INCLUDED
+#define HOSTSIM_AVR_WDT_H_INCLUDED
+
+#define WDTO_250MS  4
+
+#define wdt_enable(timeout)
+
+/* Main loop of firmware resets watchdog once per iteration, simulator
+ * switches back to the test there, see HostSim_RunMainLoop() */
+extern void HostSim_WatchdogReset(void);
+
+#define wdt_reset() HostSim_WatchdogReset()
+
+#endif /* HOSTSIM_AVR_WDT_H_INCLUDED */
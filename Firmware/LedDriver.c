@@ -43,22 +43,29 @@
 
 static const uint8_t LedsNumberForOneDriver = 5;
 
-static inline void _SPI_Write12(uint16_t byte)
+// Low 4 bits of odd 12-bit word wait for the next word
+static uint8_t s_spiHalfByte = 0;
+static uint8_t s_isSpiHalfByte = false;
+
+static inline void _SPI_Write8(const uint8_t byte)
 {
-    CLR(MOSI_PIN);
+    SPDR = byte;
+    while ((SPSR & (1 << SPIF)) == false) { }
+}
 
-    // 12-bits
-    for (uint16_t bit = 0x0800; bit != 0; bit >>= 1)
+// Two 12-bit words are sent as three bytes, LED driver gets 16 words,
+// so nothing is left before latch pulse
+static inline void _SPI_Write12(const uint16_t word)
+{
+    if (s_isSpiHalfByte)
     {
-        if (byte & bit)
-        {
-            SET(MOSI_PIN);
-        } else {
-            CLR(MOSI_PIN);
-        }
-
-        SET(SCK_PIN);
-        CLR(SCK_PIN);
+        _SPI_Write8(s_spiHalfByte | ((word >> 8) & 0x0f));
+        _SPI_Write8(word & 0xff);
+        s_isSpiHalfByte = false;
+    } else {
+        _SPI_Write8((word >> 4) & 0xff);
+        s_spiHalfByte = (word & 0x0f) << 4;
+        s_isSpiHalfByte = true;
     }
 }
 
@@ -79,9 +86,17 @@ void LedDriver_Init(void)
     CLR(SCK_PIN);
     CLR(MOSI_PIN);
 
+    // Setup SPI Master with max SPI clock speed (F_CPU / 2), data is
+    // sampled on rising edge of SCK as it was with bit-banging
+    SPSR = (1 << SPI2X);
+    SPCR = (1 << SPE) | (1 << MSTR);
+
     LedDriver_OffLeds();
 }
 
+// LED drivers are daisy-chained, the last one is written first
+static const uint8_t LedDriversCount = (LEDS_COUNT + 5 - 1) / 5;
+
 void LedDriver_Update(const RGB_t imageFrame[LEDS_COUNT])
 {
     // ...
@@ -92,23 +107,25 @@ void LedDriver_Update(const RGB_t imageFrame[LEDS_COUNT])
     //       5     4     3     2     1
     // 0 B G R B G R B G R B G R B G R
 
-    _SPI_Write12(0);
-
-    for (uint8_t i = LedsNumberForOneDriver; i < LEDS_COUNT; i++)
+    for (int8_t driver = LedDriversCount - 1; driver >= 0; driver--)
     {
-        _SPI_Write12(imageFrame[i].b);
-        _SPI_Write12(imageFrame[i].g);
-        _SPI_Write12(imageFrame[i].r);
-    }
+        uint8_t first = driver * LedsNumberForOneDriver;
 
-    _SPI_Write12(0);
+        _SPI_Write12(0);
 
-
-    for (uint8_t i = 0; i < LedsNumberForOneDriver; i++)
-    {
-        _SPI_Write12(imageFrame[i].b);
-        _SPI_Write12(imageFrame[i].g);
-        _SPI_Write12(imageFrame[i].r);
+        for (uint8_t i = first; i < first + LedsNumberForOneDriver; i++)
+        {
+            if (i < LEDS_COUNT)
+            {
+                _SPI_Write12(imageFrame[i].b);
+                _SPI_Write12(imageFrame[i].g);
+                _SPI_Write12(imageFrame[i].r);
+            } else {
+                _SPI_Write12(0);
+                _SPI_Write12(0);
+                _SPI_Write12(0);
+            }
+        }
     }
 
     _LedDriver_LatchPulse();
@@ -116,7 +133,7 @@ void LedDriver_Update(const RGB_t imageFrame[LEDS_COUNT])
 
 void LedDriver_OffLeds(void)
 {
-    for (uint8_t i = 0; i < 16; i++)
+    for (uint8_t i = 0; i < 16 * LedDriversCount; i++)
         _SPI_Write12(0x0000);
 
     _LedDriver_LatchPulse();
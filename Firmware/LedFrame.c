@@ -0,0 +1,106 @@
+/*
+ * LedFrame.c
+ *
+ *  Created on: 19.10.2026
+ *      Author: Mike Shatohin (brunql)
+ *     Project: Lightpack
+ *
+ *  Lightpack is a content-appropriate ambient lighting system for any computer
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include "LedFrame.h"
+#include "../CommonHeaders/COMMANDS.h"
+
+#define COLOR_SIZE  6
+
+static uint8_t s_frameId = 0;
+static uint8_t s_received[(LEDS_COUNT + 7) / 8];
+static uint8_t s_colors[LEDS_COUNT][COLOR_SIZE];
+
+static inline void _ClearReceived(void)
+{
+    memset(s_received, 0, sizeof(s_received));
+}
+
+void LedFrame_ProcessData(const uint8_t *data, const uint16_t size)
+{
+    if (size < FRAME_DATA_HEADER_SIZE)
+        return;
+
+    uint8_t frameId = data[0];
+    uint16_t offset = ((uint16_t)data[2] << 8) | data[1];
+    uint8_t count   = data[3];
+
+    // Data of the new frame, forget the previous one even if it wasn't committed
+    if (frameId != s_frameId)
+    {
+        s_frameId = frameId;
+        _ClearReceived();
+    }
+
+    if (count > (size - FRAME_DATA_HEADER_SIZE) / COLOR_SIZE)
+        count = (size - FRAME_DATA_HEADER_SIZE) / COLOR_SIZE;
+
+    const uint8_t *color = data + FRAME_DATA_HEADER_SIZE;
+
+    for (uint8_t k = 0; k < count && offset + k < LEDS_COUNT; k++)
+    {
+        uint8_t i = offset + k;
+
+        memcpy(s_colors[i], color, COLOR_SIZE);
+        s_received[i >> 3] |= (1 << (i & 0x07));
+
+        color += COLOR_SIZE;
+    }
+}
+
+uint8_t LedFrame_ProcessCommit(const uint8_t *data, const uint16_t size)
+{
+    if (size < 3)
+        return 0;
+
+    uint8_t frameId = data[0];
+    uint16_t count  = ((uint16_t)data[2] << 8) | data[1];
+
+    if (frameId != s_frameId)
+        return 0;
+
+    // Extra LEDs of the host aren't connected to this device
+    if (count > LEDS_COUNT)
+        count = LEDS_COUNT;
+
+    // Show only complete frame, so lost report drops whole frame
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if ((s_received[i >> 3] & (1 << (i & 0x07))) == 0)
+            return 0;
+    }
+
+    // Don't show the same frame twice
+    _ClearReceived();
+
+    return count;
+}
+
+const uint8_t * LedFrame_Color(const uint8_t ledIndex)
+{
+    return s_colors[ledIndex];
+}
@@ -0,0 +1,46 @@
+/*
+ * LedFrame.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: Mike Shatohin (brunql)
+ *     Project: Lightpack
+ *
+ *  Lightpack is a content-appropriate ambient lighting system for any computer
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LEDFRAME_H_INCLUDED
+#define LEDFRAME_H_INCLUDED
+
+#include <stdint.h>
+#include "../CommonHeaders/LEDS_COUNT.h"
+
+/* Assembles frames sent in several reports with CMD_FRAME_DATA and
+ * CMD_FRAME_COMMIT. Doesn't depend on AVR, so it can be built on host. */
+
+/* Stores colors from CMD_FRAME_DATA report, data starts after command byte */
+extern void LedFrame_ProcessData(const uint8_t *data, const uint16_t size);
+
+/* Returns count of LEDs to show from CMD_FRAME_COMMIT report or 0 if frame
+ * isn't complete. Colors of the frame are valid until the next report. */
+extern uint8_t LedFrame_ProcessCommit(const uint8_t *data, const uint16_t size);
+
+/* Color of the LED in CMD_UPDATE_LEDS format, 6 bytes */
+extern const uint8_t * LedFrame_Color(const uint8_t ledIndex);
+
+#endif /* LEDFRAME_H_INCLUDED */
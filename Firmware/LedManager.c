@@ -28,10 +28,6 @@ void LedManager_FillImages(const uint8_t red, const uint8_t green, const uint8_t
 {
     for (uint8_t i = 0; i < LEDS_COUNT; i++)
     {
-        g_Images.start[i].r = red;
-        g_Images.start[i].g = green;
-        g_Images.start[i].b = blue;
-
         g_Images.current[i].r = red;
         g_Images.current[i].g = green;
         g_Images.current[i].b = blue;
@@ -39,51 +35,133 @@ void LedManager_FillImages(const uint8_t red, const uint8_t green, const uint8_t
         g_Images.end[i].r = red;
         g_Images.end[i].g = green;
         g_Images.end[i].b = blue;
+
+        memset(&g_Images.step[i], 0, sizeof(g_Images.step[i]));
     }
 }
 
-#if (LIGHTPACK_HW == 6)
+/*
+ *  Smoothing is DDA: division is done once for new color in main loop,
+ *  timer interrupt only adds steps. Color after k steps is
+ *  start + floor(k * (end - start) / smoothSlowdown).
+ */
 
-void EvalCurrentImage_SmoothlyAlg(void)
+static inline void _StartSmoothStep(SmoothStep_t *smoothStep, const int16_t delta, const uint8_t slowdown)
 {
-    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+    smoothStep->step = 0;
+    smoothStep->remainder = 0;
+    smoothStep->error = 0;
+
+    // Steps are added from the second tick, so slowdown 1 doesn't use them
+    if (delta == 0 || slowdown < 2)
+        return;
+
+    uint16_t absDelta = (delta < 0) ? -delta : delta;
+    uint16_t step = absDelta / slowdown;
+    uint8_t remainder = absDelta % slowdown;
+
+    HOSTSIM_OPS(HostSim_OpDiv16, 1);
+
+    if (delta < 0)
     {
-        if (g_Images.smoothIndex[i] >= g_Settings.smoothSlowdown)
+        // Round down, so remainder is always added
+        if (remainder != 0)
         {
-            // Smooth change colors complete, rewrite start image
-            g_Images.current[i].r = g_Images.start[i].r = g_Images.end[i].r;
-            g_Images.current[i].g = g_Images.start[i].g = g_Images.end[i].g;
-            g_Images.current[i].b = g_Images.start[i].b = g_Images.end[i].b;
+            step++;
+            remainder = slowdown - remainder;
+        }
+        smoothStep->step = -(int16_t)step;
+    } else {
+        smoothStep->step = step;
+    }
+    smoothStep->remainder = remainder;
+}
 
-        } else {
-            uint32_t coefEnd = ((uint32_t)g_Images.smoothIndex[i] << 16) / g_Settings.smoothSlowdown;
-            uint32_t coefStart = (1UL << 16) - coefEnd;
+void LedManager_StartSmoothing(const uint8_t ledIndex)
+{
+    RGBSmoothStep_t step;
+    const uint8_t slowdown = g_Settings.smoothSlowdown;
+
+    _StartSmoothStep(&step.r, (int16_t)g_Images.end[ledIndex].r - g_Images.current[ledIndex].r, slowdown);
+    _StartSmoothStep(&step.g, (int16_t)g_Images.end[ledIndex].g - g_Images.current[ledIndex].g, slowdown);
+    _StartSmoothStep(&step.b, (int16_t)g_Images.end[ledIndex].b - g_Images.current[ledIndex].b, slowdown);
+
+    // Timer interrupt mustn't see half of the new steps
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        g_Images.step[ledIndex] = step;
+        g_Images.smoothIndex[ledIndex] = 0;
+    }
+}
+
+static inline uint16_t _SmoothStep(const uint16_t color, SmoothStep_t *smoothStep, const uint8_t slowdown)
+{
+    uint16_t result = color + smoothStep->step;
+    int16_t error = smoothStep->error + smoothStep->remainder;
 
-            g_Images.current[i].r = (
-                    coefStart * g_Images.start[i].r +
-                    coefEnd   * g_Images.end  [i].r) >> 16;
+    HOSTSIM_OPS(HostSim_OpAdd16, 2);
 
-            g_Images.current[i].g = (
-                    coefStart * g_Images.start[i].g +
-                    coefEnd   * g_Images.end  [i].g) >> 16;
+    if (error >= slowdown)
+    {
+        error -= slowdown;
+        result++;
+    }
+    smoothStep->error = error;
+
+    return result;
+}
 
-            g_Images.current[i].b = (
-                    coefStart * g_Images.start[i].b +
-                    coefEnd   * g_Images.end  [i].b) >> 16;
+void EvalCurrentImage_SmoothlyAlg(void)
+{
+    const uint8_t slowdown = g_Settings.smoothSlowdown;
+
+    for (uint8_t i = 0; i < LEDS_COUNT; i++)
+    {
+        if (g_Images.smoothIndex[i] >= slowdown)
+        {
+            // Smooth change colors complete
+            g_Images.current[i].r = g_Images.end[i].r;
+            g_Images.current[i].g = g_Images.end[i].g;
+            g_Images.current[i].b = g_Images.end[i].b;
+
+        } else {
+            if (g_Images.smoothIndex[i] != 0)
+            {
+                g_Images.current[i].r = _SmoothStep(g_Images.current[i].r, &g_Images.step[i].r, slowdown);
+                g_Images.current[i].g = _SmoothStep(g_Images.current[i].g, &g_Images.step[i].g, slowdown);
+                g_Images.current[i].b = _SmoothStep(g_Images.current[i].b, &g_Images.step[i].b, slowdown);
+            }
 
             g_Images.smoothIndex[i]++;
         }
     }
 }
 
+#if (LIGHTPACK_HW == 6)
+
+// Second buffer of the frame, LED drivers are shifted from it while
+// timer interrupt evaluates g_Images.current
+static RGB_t s_frame[LEDS_COUNT];
+
 void LedManager_UpdateColors(void)
 {
     EvalCurrentImage_SmoothlyAlg();
 
-    if (g_Settings.isSmoothEnabled)
-    	LedDriver_Update(g_Images.current);
-    else
-    	LedDriver_Update(g_Images.end);
+    // Frame is shifted to LED drivers in main loop
+    _FlagSet(Flag_FrameReady);
+}
+
+void LedManager_ShiftFrame(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (g_Settings.isSmoothEnabled)
+            memcpy(s_frame, g_Images.current, sizeof(s_frame));
+        else
+            memcpy(s_frame, g_Images.end, sizeof(s_frame));
+    }
+
+    LedDriver_Update(s_frame);
 }
 
 
@@ -100,38 +178,6 @@ static inline void _EndConstantTime(const uint8_t time)
     while(TCNT1 < time * 256UL) { }
 }
 
-void EvalCurrentImage_SmoothlyAlg(void)
-{
-    for (uint8_t i = 0; i < LEDS_COUNT; i++)
-    {
-        if (g_Images.smoothIndex[i] >= g_Settings.smoothSlowdown)
-        {
-            // Smooth change colors complete, rewrite start image
-            g_Images.current[i].r = g_Images.start[i].r = g_Images.end[i].r;
-            g_Images.current[i].g = g_Images.start[i].g = g_Images.end[i].g;
-            g_Images.current[i].b = g_Images.start[i].b = g_Images.end[i].b;
-
-        } else {
-            uint16_t coefEnd = ((uint16_t)g_Images.smoothIndex[i] << 8) / g_Settings.smoothSlowdown;
-            uint16_t coefStart = (1UL << 8) - coefEnd;
-
-            g_Images.current[i].r = (
-                    coefStart * g_Images.start[i].r +
-                    coefEnd   * g_Images.end  [i].r) >> 8;
-
-            g_Images.current[i].g = (
-                    coefStart * g_Images.start[i].g +
-                    coefEnd   * g_Images.end  [i].g) >> 8;
-
-            g_Images.current[i].b = (
-                    coefStart * g_Images.start[i].b +
-                    coefEnd   * g_Images.end  [i].b) >> 8;
-
-            g_Images.smoothIndex[i]++;
-        }
-    }
-}
-
 static inline void _PulseWidthModulation(void)
 {
     static uint8_t s_pwmIndex = 0; // index of current PWM level
@@ -27,5 +27,13 @@
 extern void LedManager_UpdateColors(void);
 extern void LedManager_FillImages(const uint8_t red, const uint8_t green, const uint8_t blue);
 
+/* Smooths LED from current to its end color, called from main loop */
+extern void LedManager_StartSmoothing(const uint8_t ledIndex);
+
+#if (LIGHTPACK_HW == 6)
+/* Shifts frame prepared by LedManager_UpdateColors to LED drivers, called from main loop */
+extern void LedManager_ShiftFrame(void);
+#endif
+
 #endif /* LEDMANAGER_H_INCLUDED */
 
@@ -143,6 +143,12 @@ static inline void _ProcessFlags(void)
         TCNT1 = 0x0000;
         TIMSK1 = _BV(OCIE1A);
     }
+
+#   if (LIGHTPACK_HW == 6)
+    // Shifting of LED drivers doesn't block USB in timer interrupt
+    if (_FlagProcess(Flag_FrameReady))
+        LedManager_ShiftFrame();
+#   endif
 }
 
 /*
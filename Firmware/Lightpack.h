@@ -48,6 +48,11 @@
 
 #include "../CommonHeaders/LEDS_COUNT.h"
 
+/* Counts arithmetic operations in host simulator, see HostSim/HostSim.h */
+#ifndef HOSTSIM_OPS
+#define HOSTSIM_OPS(op, count)
+#endif
+
 /* LED use with I/O manipulations macroses from iodefs.h */
 #define PINRX   (D,2)
 #define PINTX   (D,3)
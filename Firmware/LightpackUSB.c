@@ -26,6 +26,8 @@
 
 #include "Lightpack.h"
 #include "LightpackUSB.h"
+#include "LedFrame.h"
+#include "LedManager.h"
 #include "version.h"
 
 #include "../CommonHeaders/COMMANDS.h"
@@ -110,6 +112,10 @@ bool CALLBACK_HID_Device_CreateHIDReport(USB_ClassInfo_HID_Device_t* const HIDIn
     ReportData_u8[INDEX_FW_VER_MAJOR] = VERSION_OF_FIRMWARE_MAJOR;
     ReportData_u8[INDEX_FW_VER_MINOR] = VERSION_OF_FIRMWARE_MINOR;
 
+    // Host sends frames up to this size
+    ReportData_u8[INDEX_LEDS_COUNT_LOW]  = LEDS_COUNT & 0xff;
+    ReportData_u8[INDEX_LEDS_COUNT_HIGH] = (LEDS_COUNT >> 8) & 0xff;
+
     *ReportSize = GENERIC_REPORT_SIZE;
     return true;
 }
@@ -119,6 +125,67 @@ inline void UpdateUsbLed(void)
     TOGGLE(USBLED);
 }
 
+/** Sets new end color of the LED from 6 bytes of CMD_UPDATE_LEDS data
+ *  and restarts smooth algorithm for this LED from its current color.
+ */
+static inline void SetLedEndColor(const uint8_t i, const uint8_t *data)
+{
+#   if (LIGHTPACK_HW == 6)
+
+    g_Images.end[i].r = ((uint16_t)data[0] << 4);
+    g_Images.end[i].g = ((uint16_t)data[1] << 4);
+    g_Images.end[i].b = ((uint16_t)data[2] << 4);
+
+    g_Images.end[i].r |= (uint16_t)(data[3] & 0x0f);
+    g_Images.end[i].g |= (uint16_t)(data[4] & 0x0f);
+    g_Images.end[i].b |= (uint16_t)(data[5] & 0x0f);
+
+
+#   else /* (LIGHTPACK_HW == 6) */
+
+    g_Images.end[i].r = data[0];
+    g_Images.end[i].g = data[1];
+    g_Images.end[i].b = data[2];
+#endif
+
+    // Smooth from current color, unchanged pixel gets zero steps
+    LedManager_StartSmoothing(i);
+}
+
+/** Unpacks 12-bit channel of CMD_UPDATE_LEDS_PACKED data, two channels
+ *  take 3 bytes. For hw < 6 only 8 high bits are returned.
+ */
+static inline uint16_t PackedChannel(const uint8_t *data, const uint8_t channel)
+{
+    const uint8_t *bytes = data + (uint16_t)(channel >> 1) * 3;
+
+#   if (LIGHTPACK_HW == 6)
+    if (channel & 0x01)
+        return ((uint16_t)(bytes[1] & 0x0f) << 8) | bytes[2];
+    else
+        return ((uint16_t)bytes[0] << 4) | (bytes[1] >> 4);
+#   else
+    if (channel & 0x01)
+        return ((bytes[1] & 0x0f) << 4) | (bytes[2] >> 4);
+    else
+        return bytes[0];
+#   endif
+}
+
+/** Sets new end color of the LED from CMD_UPDATE_LEDS_PACKED data
+ *  and restarts smooth algorithm for this LED from its current color.
+ */
+static inline void SetLedEndColorPacked(const uint8_t i, const uint8_t *data)
+{
+    const uint8_t channel = i * 3;
+
+    g_Images.end[i].r = PackedChannel(data, channel);
+    g_Images.end[i].g = PackedChannel(data, channel + 1);
+    g_Images.end[i].b = PackedChannel(data, channel + 2);
+
+    LedManager_StartSmoothing(i);
+}
+
 /** HID class driver callback function for the processing of HID reports from the host.
  *
  *  \param[in] HIDInterfaceInfo  Pointer to the HID class interface configuration structure being referenced
@@ -149,42 +216,51 @@ void CALLBACK_HID_Device_ProcessHIDReport(USB_ClassInfo_HID_Device_t* const HIDI
 
         uint8_t reportDataIndex = 1; // new data starts form ReportData_u8[1]
 
-        for (uint8_t i = 0; i < LEDS_COUNT; i++)
+        // With more LEDs than one report holds the rest keeps its colors
+        for (uint8_t i = 0; i < LEDS_COUNT && reportDataIndex + 6 <= ReportSize; i++)
         {
-            g_Images.start[i].r = g_Images.current[i].r;
-            g_Images.start[i].g = g_Images.current[i].g;
-            g_Images.start[i].b = g_Images.current[i].b;
+            SetLedEndColor(i, ReportData_u8 + reportDataIndex);
+            reportDataIndex += 6;
+        }
 
+        _FlagClear(Flag_ChangingColors);
+        _FlagSet(Flag_HaveNewColors);
 
-#           if (LIGHTPACK_HW == 6)
+        break;
+    }
+    case CMD_UPDATE_LEDS_PACKED:
+    {
 
-            g_Images.end[i].r = ((uint16_t)ReportData_u8[reportDataIndex++] << 4);
-            g_Images.end[i].g = ((uint16_t)ReportData_u8[reportDataIndex++] << 4);
-            g_Images.end[i].b = ((uint16_t)ReportData_u8[reportDataIndex++] << 4);
+        _FlagSet(Flag_ChangingColors);
 
-            g_Images.end[i].r |= (uint16_t)(ReportData_u8[reportDataIndex++] & 0x0f);
-            g_Images.end[i].g |= (uint16_t)(ReportData_u8[reportDataIndex++] & 0x0f);
-            g_Images.end[i].b |= (uint16_t)(ReportData_u8[reportDataIndex++] & 0x0f);
+        // Data of LED ends in the middle of byte, so check size of whole data
+        for (uint8_t i = 0; i < LEDS_COUNT && UPDATE_LEDS_PACKED_SIZE((uint16_t)i + 1) < ReportSize; i++)
+        {
+            SetLedEndColorPacked(i, ReportData_u8 + 1);
+        }
 
+        _FlagClear(Flag_ChangingColors);
+        _FlagSet(Flag_HaveNewColors);
 
-#           else /* (LIGHTPACK_HW == 6) */
+        break;
+    }
+    case CMD_UPDATE_LEDS_DELTA:
+    {
 
-            g_Images.end[i].r = ReportData_u8[reportDataIndex++];
-            g_Images.end[i].g = ReportData_u8[reportDataIndex++];
-            g_Images.end[i].b = ReportData_u8[reportDataIndex++];
+        _FlagSet(Flag_ChangingColors);
 
-            reportDataIndex++;
-            reportDataIndex++;
-            reportDataIndex++;
-#endif
+        const uint8_t *bitmap = ReportData_u8 + 1;
+        uint8_t reportDataIndex = 1 + UPDATE_LEDS_DELTA_BITMAP_SIZE;
 
-            // If pixel changed, then restart smooth algorithm
-            // for current pixel by clearing smoothIndex
-            if (g_Images.start[i].r != g_Images.end[i].r ||
-                g_Images.start[i].g != g_Images.end[i].g ||
-                g_Images.start[i].b != g_Images.end[i].b)
+        // Unchanged LEDs keep smoothing to their current end color, LEDs
+        // after the end of bitmap can't be changed by this command
+        for (uint8_t i = 0; i < LEDS_COUNT && i < UPDATE_LEDS_DELTA_BITMAP_SIZE * 8
+                && reportDataIndex + 6 <= ReportSize; i++)
+        {
+            if (bitmap[i >> 3] & (1 << (i & 0x07)))
             {
-                g_Images.smoothIndex[i] = 0;
+                SetLedEndColor(i, ReportData_u8 + reportDataIndex);
+                reportDataIndex += 6;
             }
         }
 
@@ -193,6 +269,32 @@ void CALLBACK_HID_Device_ProcessHIDReport(USB_ClassInfo_HID_Device_t* const HIDI
 
         break;
     }
+    case CMD_FRAME_DATA:
+
+        LedFrame_ProcessData(ReportData_u8 + 1, ReportSize - 1);
+
+        break;
+
+    case CMD_FRAME_COMMIT:
+    {
+        uint8_t ledsCount = LedFrame_ProcessCommit(ReportData_u8 + 1, ReportSize - 1);
+
+        if (ledsCount == 0)
+            break;
+
+        // Show all LEDs of the frame at once
+        _FlagSet(Flag_ChangingColors);
+
+        for (uint8_t i = 0; i < ledsCount; i++)
+        {
+            SetLedEndColor(i, LedFrame_Color(i));
+        }
+
+        _FlagClear(Flag_ChangingColors);
+        _FlagSet(Flag_HaveNewColors);
+
+        break;
+    }
     case CMD_OFF_ALL:
 
         _FlagSet(Flag_LedsOffAll);
@@ -219,6 +321,10 @@ void CALLBACK_HID_Device_ProcessHIDReport(USB_ClassInfo_HID_Device_t* const HIDI
         g_Settings.isSmoothEnabled = ReportData_u8[1];
         g_Settings.smoothSlowdown  = ReportData_u8[1]; /* not a bug */
 
+        // Smoothing steps depend on slowdown, recalculate them for the rest of the way
+        for (uint8_t i = 0; i < LEDS_COUNT; i++)
+            LedManager_StartSmoothing(i);
+
         break;
 
     case CMD_SET_BRIGHTNESS:
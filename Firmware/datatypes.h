@@ -48,9 +48,32 @@ typedef struct
 } RGB_t;
 #endif
 
+/* Smoothing of one color channel without division in timer interrupt:
+ * each tick color changes by step and by one more when accumulated
+ * remainders reach smoothSlowdown */
 typedef struct
 {
-    RGB_t start[LEDS_COUNT];
+#if (LIGHTPACK_HW == 6)
+    int16_t step;
+#else
+    int8_t step;
+#endif
+    uint8_t remainder;
+    uint8_t error;
+
+} SmoothStep_t;
+
+typedef struct
+{
+    SmoothStep_t r;
+    SmoothStep_t g;
+    SmoothStep_t b;
+
+} RGBSmoothStep_t;
+
+typedef struct
+{
+    RGBSmoothStep_t step[LEDS_COUNT];
     RGB_t current[LEDS_COUNT];
     RGB_t end[LEDS_COUNT];
 
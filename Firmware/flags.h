@@ -35,6 +35,7 @@ typedef enum FLAGS
     Flag_LedsOffAll             = (1 << 1),
     Flag_TimerOptionsChanged    = (1 << 2),
     Flag_ChangingColors         = (1 << 3),
+    Flag_FrameReady             = (1 << 4),
 
 } Flag_t;
 
@@ -0,0 +1,152 @@
+/*
+ * AbstractLedDevice.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "AbstractLedDevice.hpp"
+#include "Settings.hpp"
+#include "debug.h"
+
+using namespace SettingsScope;
+
+AbstractLedDevice::AbstractLedDevice(const QString & deviceName, int maximumLedsCount, int colorDepth, QObject * parent)
+    : ILedDevice(parent)
+{
+    m_deviceName = deviceName;
+    m_maximumLedsCount = maximumLedsCount;
+    m_colorDepth = colorDepth;
+
+    m_colorsSaved.reserve(maximumLedsCount);
+
+    readCorrectionSettings();
+}
+
+void AbstractLedDevice::setColors(const QList<QRgb> & frameColors)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << m_deviceName << frameColors.count();
+
+    // Save colors for showing changes of the brightness. Device has fixed
+    // maximum of LEDs, the rest of frame is dropped
+    LedFrameMailbox::copyColors(frameColors, m_colorsSaved, 0, m_maximumLedsCount);
+
+    resizeColorsBuffer(m_colorsSaved.count());
+
+    m_gammaTable.gammaCorrection(m_gamma, m_colorsSaved, m_colorsBuffer, m_colorDepth);
+    LightpackMath::brightnessCorrection(m_brightness, m_colorsBuffer);
+
+    bool ok = writeColors(m_colorsBuffer);
+
+    emit commandCompleted(ok);
+}
+
+void AbstractLedDevice::offLeds()
+{
+    for (int i = 0; i < m_colorsSaved.count(); i++)
+        m_colorsSaved[i] = 0;
+
+    setColors(m_colorsSaved);
+}
+
+void AbstractLedDevice::setRefreshDelay(int /*value*/)
+{
+    emit commandCompleted(true);
+}
+
+void AbstractLedDevice::setColorDepth(int /*value*/)
+{
+    emit commandCompleted(true);
+}
+
+void AbstractLedDevice::setSmoothSlowdown(int /*value*/)
+{
+    emit commandCompleted(true);
+}
+
+void AbstractLedDevice::setGamma(double value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+
+    m_gamma = value;
+    setColors(m_colorsSaved);
+}
+
+void AbstractLedDevice::setBrightness(int percent)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << percent;
+
+    m_brightness = percent;
+    setColors(m_colorsSaved);
+}
+
+void AbstractLedDevice::requestFirmwareVersion()
+{
+    emit firmwareVersion("unknown (" + m_deviceName + " device)");
+    emit commandCompleted(true);
+}
+
+void AbstractLedDevice::updateDeviceSettings()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    m_gammaTable.setLinearLight(Settings::isGrabLinearLightEnabled());
+
+    setSettings(Settings::getDeviceRefreshDelay(), Settings::getDeviceColorDepth(), Settings::getDeviceSmooth(),
+                Settings::getDeviceGamma(), Settings::getDeviceBrightness());
+}
+
+void AbstractLedDevice::setSettings(int /*refreshDelay*/, int /*colorDepth*/, int /*smoothSlowdown*/, double gamma, int brightness)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << gamma << brightness;
+
+    if (gamma == m_gamma && brightness == m_brightness)
+    {
+        emit commandCompleted(true);
+        return;
+    }
+
+    m_gamma = gamma;
+    m_brightness = brightness;
+
+    // One frame for both changes
+    setColors(m_colorsSaved);
+}
+
+void AbstractLedDevice::readCorrectionSettings()
+{
+    m_gamma = Settings::getDeviceGamma();
+    m_brightness = Settings::getDeviceBrightness();
+    m_gammaTable.setLinearLight(Settings::isGrabLinearLightEnabled());
+}
+
+void AbstractLedDevice::resizeColorsBuffer(int buffSize)
+{
+    if (m_colorsBuffer.count() == buffSize)
+        return;
+
+    m_colorsBuffer.clear();
+
+    for (int i = 0; i < buffSize; i++)
+    {
+        m_colorsBuffer << StructRgb();
+    }
+}
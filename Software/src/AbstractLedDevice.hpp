@@ -0,0 +1,78 @@
+/*
+ * AbstractLedDevice.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "ILedDevice.hpp"
+#include "StructRgb.hpp"
+#include "LightpackMath.hpp"
+
+// Gamma and brightness correction common for devices which get whole frame
+// of colors at once and have no own settings (serial and network strips).
+// Protocol of device is writeColors().
+class AbstractLedDevice : public ILedDevice
+{
+    Q_OBJECT
+public:
+    // Longer frames are cut to maximumLedsCount, colorDepth is passed to
+    // GammaTable::gammaCorrection(), deviceName is shown as firmware version
+    AbstractLedDevice(const QString & deviceName, int maximumLedsCount, int colorDepth, QObject * parent);
+
+public slots:
+    void setColors(const QList<QRgb> & colors);
+    void offLeds();
+    void setRefreshDelay(int /*value*/);
+    void setColorDepth(int /*value*/);
+    void setSmoothSlowdown(int /*value*/);
+    void setGamma(double value);
+    void setBrightness(int percent);
+    void requestFirmwareVersion();
+    void updateDeviceSettings();
+    void setSettings(int /*refreshDelay*/, int /*colorDepth*/, int /*smoothSlowdown*/, double gamma, int brightness);
+
+protected:
+    // Writes corrected colors to device, returns false on fail
+    virtual bool writeColors(const QList<StructRgb> & colors) = 0;
+
+    // Called by open() of devices, device settings could be changed while it was closed
+    void readCorrectionSettings();
+
+    const QString & deviceName() const { return m_deviceName; }
+
+private:
+    void resizeColorsBuffer(int buffSize);
+
+private:
+    QString m_deviceName;
+    int m_maximumLedsCount;
+    int m_colorDepth;
+
+    double m_gamma;
+    GammaTable m_gammaTable;
+    int m_brightness;
+
+    QList<QRgb> m_colorsSaved;
+    QList<StructRgb> m_colorsBuffer;
+};
@@ -358,7 +358,7 @@ void ApiServer::clientProcessCommands()
         {
             API_DEBUG_OUT << CmdGetCountLeds;
 
-            result = QString("%1%2\r\n").arg(CmdResultCountLeds).arg(Settings::getNumberOfLeds(Settings::getConnectedDevice()));
+            result = QString("%1%2\r\n").arg(CmdResultCountLeds).arg(Settings::getNumberOfLedsInFrame());
         }
         else if (cmdBuffer == CmdLock)
         {
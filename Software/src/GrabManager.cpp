@@ -25,6 +25,7 @@
  */
 
 #include "GrabManager.hpp"
+#include "LightpackMath.hpp"
 #include <QtCore/qmath.h>
 #include "debug.h"
 
@@ -46,8 +47,15 @@ GrabManager::GrabManager(QWidget *parent) : QObject(parent)
     m_isGrabEnabled = false;
 
     m_isSendDataOnlyIfColorsChanged = Settings::isSendDataOnlyIfColorsChanges();
+    m_colorsChangeThreshold = Settings::getGrabColorsChangeThreshold();
+    m_isLinearLightEnabled = Settings::isGrabLinearLightEnabled();
+
+    m_countWritesSent = 0;
+    m_countWritesSuppressed = 0;
+    m_countLedChangesSuppressed = 0;
 
     m_grabber = createGrabber(Settings::getGrabberType());
+    m_grabber->setLinearLightAveraging(m_isLinearLightEnabled);
 
     m_timerUpdateFPS = new QTimer(this);
     connect(m_timerUpdateFPS, SIGNAL(timeout()), this, SLOT(timeoutUpdateFPS()));
@@ -57,8 +65,12 @@ GrabManager::GrabManager(QWidget *parent) : QObject(parent)
     m_isPauseGrabWhileResizeOrMoving = false;
     m_isGrabWidgetsVisible = false;
 
+    m_isSamplingMatrixDirty = true;
+    m_isExtraZonesUsed = false;
+
     initColorLists(MaximumNumberOfLeds::Default);
     initLedWidgets(MaximumNumberOfLeds::Default);
+    initOverlays();
 
     connect(m_timerGrab, SIGNAL(timeout()), this, SLOT(timeoutUpdateColors()));
     connect(QApplication::desktop(), SIGNAL(resized(int)), this, SLOT(scaleLedWidgets(int)));
@@ -76,11 +88,18 @@ GrabManager::~GrabManager()
     delete m_timeEval;
     delete m_grabber;
 
-    for (int i = 0; i < m_ledWidgets.size(); i++)
+    // Overlays draw m_ledZones, so they are deleted first
+    for (int i = 0; i < m_overlays.size(); i++)
+    {
+        delete m_overlays[i];
+    }
+    m_overlays.clear();
+
+    for (int i = 0; i < m_ledZones.size(); i++)
     {
-        m_ledWidgets[i]->deleteLater();
+        delete m_ledZones[i];
     }
-    m_ledWidgets.clear();
+    m_ledZones.clear();
 
     for (int i = 0; i < Grab::GrabbersCount; i++)
         delete m_grabbers[i];
@@ -113,6 +132,7 @@ void GrabManager::setGrabber(Grab::GrabberType grabberType)
     }
 
     m_grabber = m_grabbers[grabberType];
+    m_grabber->setLinearLightAveraging(m_isLinearLightEnabled);
 
     firstWidgetPositionChanged();
 }
@@ -129,6 +149,12 @@ void GrabManager::setMinLevelOfSensivity(int value)
     m_minLevelOfSensivity = value;
 }
 
+void GrabManager::setColorsChangeThreshold(int value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+    m_colorsChangeThreshold = value;
+}
+
 void GrabManager::setAvgColorsOnAllLeds(bool state)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
@@ -148,11 +174,13 @@ void GrabManager::setNumberOfLeds(int numberOfLeds)
     initColorLists(numberOfLeds);
     initLedWidgets(numberOfLeds);
 
-    for (int i = 0; i < m_ledWidgets.size(); i++)
+    for (int i = 0; i < m_ledZones.size(); i++)
     {
-        m_ledWidgets[i]->settingsProfileChanged();
-        m_ledWidgets[i]->setVisible(m_isGrabWidgetsVisible);
+        m_ledZones[i]->settingsProfileChanged();
     }
+
+    applyEdgeLayout();
+    ledZonesChanged();
 }
 
 void GrabManager::reset()
@@ -167,12 +195,21 @@ void GrabManager::settingsProfileChanged()
     m_isSendDataOnlyIfColorsChanged = Settings::isSendDataOnlyIfColorsChanges();
     m_avgColorsOnAllLeds = Settings::isGrabAvgColorsEnabled();
     m_minLevelOfSensivity = Settings::getGrabMinimumLevelOfSensitivity();
+    m_colorsChangeThreshold = Settings::getGrabColorsChangeThreshold();
+    m_isLinearLightEnabled = Settings::isGrabLinearLightEnabled();
     m_slowdownTime = Settings::getGrabSlowdown();
 
-    for (int i = 0; i < m_ledWidgets.size(); i++)
+    if (m_grabber != NULL)
+        m_grabber->setLinearLightAveraging(m_isLinearLightEnabled);
+
+    for (int i = 0; i < m_ledZones.size(); i++)
     {
-        m_ledWidgets[i]->settingsProfileChanged();
+        m_ledZones[i]->settingsProfileChanged();
     }
+
+    applyEdgeLayout();
+    ledZonesChanged();
+    firstWidgetPositionChanged();
 }
 
 void GrabManager::setVisibleLedWidgets(bool state)
@@ -181,14 +218,9 @@ void GrabManager::setVisibleLedWidgets(bool state)
 
     m_isGrabWidgetsVisible = state;
 
-    for (int i = 0; i < m_ledWidgets.size(); i++)
+    for (int i = 0; i < m_overlays.size(); i++)
     {
-        if (state)
-        {
-            m_ledWidgets[i]->show();
-        } else {
-            m_ledWidgets[i]->hide();
-        }
+        m_overlays[i]->setOverlayVisible(state);
     }
 }
 
@@ -199,8 +231,10 @@ void GrabManager::setColoredLedWidgets(bool state)
     // This slot is directly connected to radioButton toggled(bool) signal
     if (state)
     {
-        for (int i = 0; i < m_ledWidgets.size(); i++)
-            m_ledWidgets[i]->fillBackgroundColored();
+        for (int i = 0; i < m_ledZones.size(); i++)
+            m_ledZones[i]->fillBackgroundColored();
+
+        updateOverlays();
     }
 }
 
@@ -211,8 +245,10 @@ void GrabManager::setWhiteLedWidgets(bool state)
     // This slot is directly connected to radioButton toggled(bool) signal
     if (state)
     {
-        for (int i = 0; i < m_ledWidgets.size(); i++)
-            m_ledWidgets[i]->fillBackgroundWhite();
+        for (int i = 0; i < m_ledZones.size(); i++)
+            m_ledZones[i]->fillBackgroundWhite();
+
+        updateOverlays();
     }
 }
 
@@ -246,11 +282,29 @@ void GrabManager::timeoutUpdateColors()
     QTime t; t.start();
 #endif
 
-    QList<QRgb> widgetsColors = m_grabber->grabWidgetsColors(m_ledWidgets);
+    QList<QRgb> widgetsColors;
+
+    if (m_isSamplingMatrixDirty)
+        updateSamplingMatrix();
+
+    // Grabbers which capture the whole screen at once average each cell
+    // of the sampling matrix. Others grab each LED zone, unless LEDs blend
+    // extra zones, then they grab cells too.
+    if (m_grabber->isWholeScreenCaptured() || m_isExtraZonesUsed)
+    {
+        m_grabber->grabRectsColors(m_samplingMatrix.cells(), m_cellsColors);
+        m_samplingMatrix.multiply(m_cellsColors, widgetsColors);
+    } else {
+        m_ledsRects.clear();
+        for (int i = 0; i < m_ledZones.size(); i++)
+            m_ledsRects << m_ledZones[i]->getRect();
+
+        m_grabber->grabRectsColors(m_ledsRects, widgetsColors);
+    }
 
-    for (int i = 0; i < m_ledWidgets.size(); i++)
+    for (int i = 0; i < m_ledZones.size(); i++)
     {
-        if (m_ledWidgets[i]->isAreaEnabled())
+        if (m_ledZones[i]->isAreaEnabled())
         {
             QRgb rgb = widgetsColors[i];
 
@@ -281,9 +335,9 @@ void GrabManager::timeoutUpdateColors()
             avgB /= countGrabEnabled;
         }
         // Set one AVG color to all LEDs
-        for (int ledIndex = 0; ledIndex < m_ledWidgets.size(); ledIndex++)
+        for (int ledIndex = 0; ledIndex < m_ledZones.size(); ledIndex++)
         {
-            if (m_ledWidgets[ledIndex]->isAreaEnabled())
+            if (m_ledZones[ledIndex]->isAreaEnabled())
             {
                 m_colorsNew[ledIndex] = qRgb(avgR, avgG, avgB);
             }
@@ -291,13 +345,13 @@ void GrabManager::timeoutUpdateColors()
     }
 
     // White balance
-    for (int i = 0; i < m_ledWidgets.size(); i++)
+    for (int i = 0; i < m_ledZones.size(); i++)
     {
         QRgb rgb = m_colorsNew[i];
 
-        unsigned r = qRed(rgb)   * m_ledWidgets[i]->getCoefRed();
-        unsigned g = qGreen(rgb) * m_ledWidgets[i]->getCoefGreen();
-        unsigned b = qBlue(rgb)  * m_ledWidgets[i]->getCoefBlue();
+        unsigned r = qRed(rgb)   * m_ledZones[i]->getCoefRed();
+        unsigned g = qGreen(rgb) * m_ledZones[i]->getCoefGreen();
+        unsigned b = qBlue(rgb)  * m_ledZones[i]->getCoefBlue();
 
         if (r > 0xff) r = 0xff;
         if (g > 0xff) g = 0xff;
@@ -307,7 +361,7 @@ void GrabManager::timeoutUpdateColors()
     }
 
     // Check minimum level of sensivity
-    for (int i = 0; i < m_ledWidgets.size(); i++)
+    for (int i = 0; i < m_ledZones.size(); i++)
     {
         QRgb rgb = m_colorsNew[i];
         int avg = round((qRed(rgb) + qGreen(rgb) + qBlue(rgb)) / 3.0);
@@ -318,18 +372,14 @@ void GrabManager::timeoutUpdateColors()
         }
     }
 
-    for (int i = 0; i < m_ledWidgets.size(); i++)
-    {
-        if (m_colorsCurrent[i] != m_colorsNew[i])
-        {
-            m_colorsCurrent[i] = m_colorsNew[i];
-            isColorsChanged = true;
-        }
-    }
+    isColorsChanged = updateColorsCurrent();
 
     if ((m_isSendDataOnlyIfColorsChanged == false) || isColorsChanged)
     {
+        m_countWritesSent++;
         emit updateLedsColors(m_colorsCurrent);
+    } else {
+        m_countWritesSuppressed++;
     }
 
     m_fpsMs = m_timeEval->howLongItEnd();
@@ -341,7 +391,11 @@ void GrabManager::timeoutUpdateColors()
 
 void GrabManager::timeoutUpdateFPS()
 {
-    DEBUG_MID_LEVEL << Q_FUNC_INFO;
+    DEBUG_MID_LEVEL << Q_FUNC_INFO
+                    << "writes sent:" << m_countWritesSent
+                    << "suppressed:" << m_countWritesSuppressed
+                    << "led changes suppressed:" << m_countLedChangesSuppressed;
+
     emit ambilightTimeOfUpdatingColors(m_fpsMs);
 }
 
@@ -361,7 +415,9 @@ void GrabManager::firstWidgetPositionChanged()
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
-    m_screenSavedIndex = QApplication::desktop()->screenNumber(m_ledWidgets[0]);
+    GrabOverlay * overlay = overlayOfFirstZone();
+
+    m_screenSavedIndex = overlay->getScreen();
     m_screenSavedRect = QApplication::desktop()->screenGeometry(m_screenSavedIndex);
 
     if (m_grabber == NULL)
@@ -370,14 +426,17 @@ void GrabManager::firstWidgetPositionChanged()
         return;
     }
 
-    m_grabber->updateGrabScreenFromWidget(m_ledWidgets[0]);
+    m_grabber->updateGrabScreenFromWidget(overlay);
 }
 
 void GrabManager::scaleLedWidgets(int screenIndexResized)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << "screenIndexResized:" << screenIndexResized;
 
-    int screenIndexOfFirstLedWidget = QApplication::desktop()->screenNumber(m_ledWidgets[0]);
+    // Number of screens or their geometry could change
+    initOverlays();
+
+    int screenIndexOfFirstLedWidget = QApplication::desktop()->screenNumber(m_ledZones[0]->getRect().center());
 
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << "LedWidgets[0] index of screen:" << screenIndexOfFirstLedWidget;
 
@@ -406,13 +465,13 @@ void GrabManager::scaleLedWidgets(int screenIndexResized)
     m_screenSavedRect = screen;
     m_screenSavedIndex = screenIndexOfFirstLedWidget;
 
-    for(int i=0; i < m_ledWidgets.size(); i++){
+    for(int i=0; i < m_ledZones.size(); i++){
 
-        int width  = round(scaleX * m_ledWidgets[i]->width());
-        int height = round(scaleY * m_ledWidgets[i]->height());
+        int width  = round(scaleX * m_ledZones[i]->getRect().width());
+        int height = round(scaleY * m_ledZones[i]->getRect().height());
 
-        int x = m_ledWidgets[i]->x();
-        int y = m_ledWidgets[i]->y();
+        int x = m_ledZones[i]->getRect().x();
+        int y = m_ledZones[i]->getRect().y();
 
         x -= screen.x();
         y -= screen.y();
@@ -426,14 +485,16 @@ void GrabManager::scaleLedWidgets(int screenIndexResized)
         x -= deltaX;
         y -= deltaY;
 
-        m_ledWidgets[i]->move(x,y);
-        m_ledWidgets[i]->resize(width, height);
+        m_ledZones[i]->setRect(QRect(x, y, width, height));
 
-        m_ledWidgets[i]->saveSizeAndPosition();
+        m_ledZones[i]->saveSizeAndPosition();
 
         DEBUG_LOW_LEVEL << Q_FUNC_INFO << "new values [" << i << "]" << "x =" << x << "y =" << y << "w =" << width << "h =" << height;
     }
 
+    applyEdgeLayout();
+    ledZonesChanged();
+
     // Update grab buffer if screen resized
     firstWidgetPositionChanged();
 }
@@ -470,17 +531,83 @@ IGrabber * GrabManager::createGrabber(Grab::GrabberType grabberType)
     }   
 }
 
+void GrabManager::applyEdgeLayout()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    if (Settings::isEdgeLayoutEnabled() == false || m_ledZones.isEmpty())
+        return;
+
+    int ledsPerSide[EdgeLayout::SidesCount];
+
+    for (int side = 0; side < EdgeLayout::SidesCount; side++)
+        ledsPerSide[side] = Settings::getEdgeLayoutLeds((EdgeLayout::Side)side);
+
+    QRect screen = QApplication::desktop()->screenGeometry(m_ledZones[0]->getRect().center());
+
+    QList<QRect> zones = LedLayout::edges(screen, ledsPerSide,
+                                          Settings::getEdgeLayoutDepth(), Settings::getEdgeLayoutInset());
+
+    if (zones.size() != m_ledZones.size())
+    {
+        qWarning() << Q_FUNC_INFO << "LEDs in edge layout:" << zones.size() << "!= number of LEDs:" << m_ledZones.size();
+    }
+
+    for (int i = 0; i < m_ledZones.size() && i < zones.size(); i++)
+    {
+        m_ledZones[i]->setRect(zones[i]);
+    }
+
+    // Geometry of zones changed
+    m_isSamplingMatrixDirty = true;
+}
+
+void GrabManager::updateSamplingMatrix()
+{
+    DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
+
+    QList< QList<SamplingZone> > ledsZones;
+
+    m_isExtraZonesUsed = false;
+
+    // Zone of LED is blended with extra zones from profile by their weights
+    for (int i = 0; i < m_ledZones.size(); i++)
+    {
+        QList<SamplingZone> zones;
+
+        if (m_ledZones[i]->isAreaEnabled())
+        {
+            if (m_ledZones[i]->getRect().isEmpty() == false)
+                zones << SamplingZone(m_ledZones[i]->getRect(), m_ledZones[i]->getWeight());
+
+            if (m_ledZones[i]->getExtraZones().isEmpty() == false)
+            {
+                zones << m_ledZones[i]->getExtraZones();
+                m_isExtraZonesUsed = true;
+            }
+        }
+
+        ledsZones << zones;
+    }
+
+    m_samplingMatrix.build(ledsZones);
+
+    m_isSamplingMatrixDirty = false;
+}
+
 void GrabManager::initColorLists(int numberOfLeds)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << numberOfLeds;
 
     m_colorsCurrent.clear();
     m_colorsNew.clear();
+    m_isLedColorChanging.clear();
 
     for (int i = 0; i < numberOfLeds; i++)
     {
         m_colorsCurrent << 0;
         m_colorsNew     << 0;
+        m_isLedColorChanging << false;
     }
 }
 
@@ -504,54 +631,139 @@ void GrabManager::clearColorsCurrent()
     }
 }
 
-void GrabManager::initLedWidgets(int numberOfLeds)
+//
+// Copy m_colorsNew to m_colorsCurrent skipping changes which are not visible,
+// returns true if at least one LED color has been changed.
+//
+// Threshold works with hysteresis: LED which is still in the middle of changing
+// its color follows the half of threshold, so slow fades don't step, and only
+// LED at rest must exceed the full threshold. Sensor noise and video grain on
+// static content stay below it and don't wake up the device.
+//
+bool GrabManager::updateColorsCurrent()
 {
-    DEBUG_LOW_LEVEL << Q_FUNC_INFO << numberOfLeds;
+    DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+    bool isColorsChanged = false;
 
-    if (m_ledWidgets.size() == 0)
+    for (int i = 0; i < m_colorsNew.size(); i++)
     {
-        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "First widget initialization";
+        if (m_colorsCurrent[i] == m_colorsNew[i])
+        {
+            m_isLedColorChanging[i] = false;
+            continue;
+        }
 
-        GrabWidget * ledWidget = new GrabWidget(m_ledWidgets.size(), m_parentWidget);
+        int threshold = m_colorsChangeThreshold * LightpackMath::PerceptualDeltaScale;
 
-        connect(ledWidget, SIGNAL(resizeOrMoveStarted()), this, SLOT(pauseWhileResizeOrMoving()));
-        connect(ledWidget, SIGNAL(resizeOrMoveCompleted(int)), this, SLOT(resumeAfterResizeOrMoving()));
+        if (m_isLedColorChanging[i])
+            threshold /= 2;
 
-        // First LED widget using to determine grabbing-monitor in WinAPI version of Grab
-        connect(ledWidget, SIGNAL(resizeOrMoveCompleted(int)), this, SLOT(firstWidgetPositionChanged()));
+        // Always send switching off (zero color) and all changes if filter is disabled
+        if (m_isSendDataOnlyIfColorsChanged == false || m_colorsNew[i] == 0 ||
+                LightpackMath::perceptualDelta(m_colorsCurrent[i], m_colorsNew[i]) > threshold)
+        {
+            m_colorsCurrent[i] = m_colorsNew[i];
+            m_isLedColorChanging[i] = true;
+            isColorsChanged = true;
+        } else {
+            m_isLedColorChanging[i] = false;
+            m_countLedChangesSuppressed++;
+        }
+    }
 
-        m_ledWidgets << ledWidget;
+    return isColorsChanged;
+}
 
-        // TODO: Check out this line!
-        // firstWidgetPositionChanged();
-    }
+void GrabManager::initLedWidgets(int numberOfLeds)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << numberOfLeds;
 
-    int diff = numberOfLeds - m_ledWidgets.size();
+    int diff = numberOfLeds - m_ledZones.size();
 
     if (diff > 0)
     {
-        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Append" << diff << "grab widgets";
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Append" << diff << "LED zones";
 
         for (int i = 0; i < diff; i++)
         {
-            GrabWidget * ledWidget = new GrabWidget(m_ledWidgets.size(), m_parentWidget);
-
-            connect(ledWidget, SIGNAL(resizeOrMoveStarted()), this, SLOT(pauseWhileResizeOrMoving()));
-            connect(ledWidget, SIGNAL(resizeOrMoveCompleted(int)), this, SLOT(resumeAfterResizeOrMoving()));
-
-            m_ledWidgets << ledWidget;
+            m_ledZones << new LedZone(m_ledZones.size());
         }
     } else {
         diff *= -1;
-        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Remove last" << diff << "grab widgets";
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Remove last" << diff << "LED zones";
 
         while (diff --> 0)
         {
-            m_ledWidgets.last()->deleteLater();
-            m_ledWidgets.removeLast();
+            delete m_ledZones.takeLast();
         }
     }
 
-    if (m_ledWidgets.size() != numberOfLeds)
-        qCritical() << Q_FUNC_INFO << "Fail: m_ledWidgets.size()" << m_ledWidgets.size() << " != numberOfLeds" << numberOfLeds;
+    if (m_ledZones.size() != numberOfLeds)
+        qCritical() << Q_FUNC_INFO << "Fail: m_ledZones.size()" << m_ledZones.size() << " != numberOfLeds" << numberOfLeds;
+}
+
+void GrabManager::initOverlays()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    int screenCount = QApplication::desktop()->screenCount();
+
+    while (m_overlays.size() < screenCount)
+    {
+        GrabOverlay * overlay = new GrabOverlay(m_overlays.size(), &m_ledZones, m_parentWidget);
+
+        connect(overlay, SIGNAL(resizeOrMoveStarted()), this, SLOT(pauseWhileResizeOrMoving()));
+        connect(overlay, SIGNAL(resizeOrMoveCompleted(int)), this, SLOT(resumeAfterResizeOrMoving()));
+        connect(overlay, SIGNAL(resizeOrMoveCompleted(int)), this, SLOT(ledZonesChanged()));
+        connect(overlay, SIGNAL(zonesChanged()), this, SLOT(ledZonesChanged()));
+
+        // First LED zone using to determine grabbing-monitor in WinAPI version of Grab
+        connect(overlay, SIGNAL(resizeOrMoveCompleted(int)), this, SLOT(firstWidgetPositionChanged()));
+
+        m_overlays << overlay;
+    }
+
+    while (m_overlays.size() > screenCount)
+    {
+        m_overlays.last()->deleteLater();
+        m_overlays.removeLast();
+    }
+
+    for (int i = 0; i < m_overlays.size(); i++)
+    {
+        m_overlays[i]->setOverlayVisible(m_isGrabWidgetsVisible);
+        m_overlays[i]->updateScreenGeometry();
+    }
+}
+
+void GrabManager::updateOverlays()
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+    for (int i = 0; i < m_overlays.size(); i++)
+    {
+        m_overlays[i]->updateZones();
+    }
+}
+
+void GrabManager::ledZonesChanged()
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+    // Zones were moved, resized, enabled or disabled
+    m_isSamplingMatrixDirty = true;
+
+    updateOverlays();
+}
+
+GrabOverlay * GrabManager::overlayOfFirstZone()
+{
+    int screen = QApplication::desktop()->screenNumber(m_ledZones[0]->getRect().center());
+
+    // Zone is out of all screens, use primary
+    if (screen < 0 || screen >= m_overlays.size())
+        screen = QApplication::desktop()->primaryScreen();
+
+    return m_overlays[screen];
 }
@@ -29,7 +29,8 @@
 #include "Settings.hpp"
 #include "SettingsWindow.hpp"
 #include "TimeEvaluations.hpp"
-#include "GrabWidget.hpp"
+#include "LedZone.hpp"
+#include "GrabOverlay.hpp"
 #include "WinAPIGrabber.hpp"
 #include "WinAPIGrabberEachWidget.hpp"
 #include "QtGrabber.hpp"
@@ -38,6 +39,9 @@
 #include "MacOSGrabber.hpp"
 #include "D3D9Grabber.hpp"
 
+#include "LedSamplingMatrix.hpp"
+#include "LedLayout.hpp"
+
 #include "enums.hpp"
 
 class GrabManager : public QObject
@@ -59,6 +63,7 @@ public:
     void setGrabber(Grab::GrabberType grabber);
     void setSlowdownTime(int ms);
     void setMinLevelOfSensivity(int value);
+    void setColorsChangeThreshold(int value);
     void setAvgColorsOnAllLeds(bool state);
 
     // Common options
@@ -79,6 +84,8 @@ private slots:
     void resumeAfterResizeOrMoving();
     void firstWidgetPositionChanged();
     void scaleLedWidgets(int screenIndexResized);
+    void updateOverlays();
+    void ledZonesChanged();
 
 private:
     IGrabber *createGrabber(Grab::GrabberType grabber);
@@ -86,6 +93,11 @@ private:
     void clearColorsNew();
     void clearColorsCurrent();
     void initLedWidgets(int numberOfLeds);
+    void initOverlays();
+    GrabOverlay * overlayOfFirstZone();
+    bool updateColorsCurrent();
+    void updateSamplingMatrix();
+    void applyEdgeLayout();
 
 private:
     QList<IGrabber*> m_grabbers;
@@ -93,12 +105,20 @@ private:
     QTimer *m_timerGrab;
     QTimer *m_timerUpdateFPS;
     QWidget *m_parentWidget;
-    QList<GrabWidget *> m_ledWidgets;
+    QList<LedZone *> m_ledZones;
+    QList<GrabOverlay *> m_overlays; // one per screen, draws m_ledZones
     const static QColor m_backgroundAndTextColors[10][2];
     TimeEvaluations *m_timeEval;
 
     QList<QRgb> m_colorsCurrent;
     QList<QRgb> m_colorsNew;       
+    QList<bool> m_isLedColorChanging; // hysteresis state of each LED
+
+    LedSamplingMatrix m_samplingMatrix;
+    bool m_isSamplingMatrixDirty; // LED zones changed, m_samplingMatrix is rebuilt on next grab
+    bool m_isExtraZonesUsed;      // some LEDs blend extra zones, so zones are grabbed by matrix cells
+    QList<QRect> m_ledsRects;
+    QList<QRgb> m_cellsColors;
 
     QRect m_screenSavedRect;
     int m_screenSavedIndex;
@@ -108,6 +128,13 @@ private:
     bool m_isSendDataOnlyIfColorsChanged;
     bool m_avgColorsOnAllLeds;
     int m_minLevelOfSensivity;
+    int m_colorsChangeThreshold;
+    bool m_isLinearLightEnabled;
+
+    // Statistics of skipped device writes, printed with FPS
+    unsigned m_countWritesSent;
+    unsigned m_countWritesSuppressed;
+    unsigned m_countLedChangesSuppressed;
 
     // Store last grabbing time in milliseconds
     double m_fpsMs;
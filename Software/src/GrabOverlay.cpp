@@ -0,0 +1,449 @@
+/*
+ * GrabOverlay.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtGui>
+#include "GrabOverlay.hpp"
+#include "debug.h"
+
+GrabOverlay::GrabOverlay(int screen, const QList<LedZone *> * zones, QWidget *parent) :
+    QWidget(parent)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << screen;
+
+    m_screen = screen;
+    m_zones = zones;
+    m_isOverlayVisible = false;
+
+    m_cmd = NOP;
+    m_activeZone = -1;
+
+    m_configWidget = new GrabConfigWidget();
+    m_configZone = -1;
+
+    // Loaded once, each zone draws them on every paint
+    m_configButtonLight = QPixmap(":/buttons/arrow_right_light_24px.png");
+    m_configButtonDark = QPixmap(":/buttons/arrow_right_dark_24px.png");
+    m_resizeIconLight = QPixmap(":/icons/res_light.png");
+    m_resizeIconDark = QPixmap(":/icons/res_dark.png");
+
+    setWindowFlags(Qt::FramelessWindowHint | Qt::ToolTip);
+    setFocusPolicy(Qt::NoFocus);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setCursor(Qt::OpenHandCursor);
+
+    setMouseTracking(true);
+
+    updateScreenGeometry();
+
+    connect(m_configWidget, SIGNAL(isAreaEnabled_Toggled(bool)), this, SLOT(onIsAreaEnabled_Toggled(bool)));
+    connect(m_configWidget, SIGNAL(coefRed_ValueChanged(double)),   this, SLOT(onRedCoef_ValueChanged(double)));
+    connect(m_configWidget, SIGNAL(coefGreen_ValueChanged(double)), this, SLOT(onGreenCoef_ValueChanged(double)));
+    connect(m_configWidget, SIGNAL(coefBlue_ValueChanged(double)),  this, SLOT(onBlueCoef_ValueChanged(double)));
+}
+
+GrabOverlay::~GrabOverlay()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_screen;
+
+    delete m_configWidget;
+}
+
+void GrabOverlay::setOverlayVisible(bool isVisible)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_screen << isVisible;
+
+    m_isOverlayVisible = isVisible;
+
+    if (isVisible == false)
+    {
+        m_configWidget->hide();
+        m_configZone = -1;
+    }
+
+    updateZones();
+}
+
+void GrabOverlay::updateScreenGeometry()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_screen;
+
+    setGeometry(QApplication::desktop()->screenGeometry(m_screen));
+
+    updateZones();
+}
+
+void GrabOverlay::updateZones()
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << m_screen;
+
+    if (m_configZone >= m_zones->count())
+    {
+        m_configWidget->hide();
+        m_configZone = -1;
+    }
+
+    QRegion region;
+    for (int i = 0; i < m_zones->count(); i++)
+        region += m_zones->at(i)->getRect();
+
+    region = region.intersected(geometry()).translated(-pos());
+
+    // Empty mask means no mask at all, so hide overlay without zones
+    if (m_isOverlayVisible == false || region.isEmpty())
+    {
+        hide();
+        return;
+    }
+
+    setMask(region);
+    show();
+    update();
+}
+
+void GrabOverlay::closeEvent(QCloseEvent *event)
+{
+    qWarning() << Q_FUNC_INFO << "event->type():" << event->type() << "Screen:" << m_screen;
+
+    event->ignore();
+}
+
+void GrabOverlay::paintEvent(QPaintEvent *event)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+    QPainter painter(this);
+    painter.translate(-pos());
+
+    QRect dirty = event->rect().translated(pos());
+
+    for (int i = 0; i < m_zones->count(); i++)
+    {
+        if (m_zones->at(i)->getRect().intersects(dirty))
+            paintZone(painter, m_zones->at(i));
+    }
+}
+
+void GrabOverlay::paintZone(QPainter & painter, const LedZone * zone)
+{
+    const QRect & r = zone->getRect();
+    QColor textColor = zone->getTextColor();
+    bool isLight = (textColor == Qt::white);
+
+    painter.save();
+    painter.setClipRect(r);
+
+    painter.fillRect(r, zone->getBackgroundColor());
+
+    painter.setPen(QColor(0x77, 0x77, 0x77));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(r.adjusted(0, 0, -1, -1));
+
+    painter.drawPixmap(configButtonRect(r), isLight ? m_configButtonLight : m_configButtonDark);
+
+    // Icon 'resize' opacity
+    painter.setOpacity(0.4);
+
+    // Draw icon 12x12px with 3px padding from the bottom right corner
+    painter.drawPixmap(r.right() - 17, r.bottom() - 17, 12, 12, isLight ? m_resizeIconLight : m_resizeIconDark);
+
+    // Self ID and size text opacity
+    painter.setOpacity(0.25);
+
+    QFont font = painter.font();
+    font.setBold(true);
+    font.setPixelSize(qMax(1, qMin(r.height(), r.width()) / 3));
+    painter.setFont(font);
+
+    painter.setPen(textColor);
+    painter.drawText(r, zone->getIdString(), QTextOption(Qt::AlignCenter));
+
+    font.setBold(false);
+    font.setPointSize(10);
+    painter.setFont(font);
+
+    QRect rectWidthHeight = r;
+    rectWidthHeight.setBottom(r.bottom() - 3);
+    painter.drawText(rectWidthHeight, QString::number(r.width()) + "x" + QString::number(r.height()),
+                     QTextOption(Qt::AlignHCenter | Qt::AlignBottom));
+
+    painter.restore();
+}
+
+QRect GrabOverlay::configButtonRect(const QRect & zoneRect)
+{
+    return QRect(zoneRect.right() + 1 - ConfigButtonMargin - ConfigButtonSize,
+                 zoneRect.top() + ConfigButtonMargin, ConfigButtonSize, ConfigButtonSize);
+}
+
+int GrabOverlay::zoneAt(const QPoint & pos)
+{
+    // Last zone drawn over others, so check it first
+    for (int i = m_zones->count() - 1; i >= 0; i--)
+    {
+        if (m_zones->at(i)->getRect().contains(pos))
+            return i;
+    }
+    return -1;
+}
+
+int GrabOverlay::cmdAt(const QRect & zoneRect, const QPoint & pos)
+{
+    int cmd = NOP;
+
+    if (pos.x() - zoneRect.left() < BorderWidth)
+        cmd |= RESIZE_LEFT;
+    else if (zoneRect.right() - pos.x() < BorderWidth)
+        cmd |= RESIZE_RIGHT;
+
+    if (pos.y() - zoneRect.top() < BorderWidth)
+        cmd |= RESIZE_UP;
+    else if (zoneRect.bottom() - pos.y() < BorderWidth)
+        cmd |= RESIZE_DOWN;
+
+    return (cmd == NOP) ? MOVE : cmd;
+}
+
+void GrabOverlay::setCursorForCmd(int cmd, bool isPressed)
+{
+    DEBUG_HIGH_LEVEL << Q_FUNC_INFO << cmd << isPressed;
+
+    switch (cmd)
+    {
+    case RESIZE_LEFT | RESIZE_UP:
+    case RESIZE_RIGHT | RESIZE_DOWN:
+        setCursor(Qt::SizeFDiagCursor);
+        break;
+    case RESIZE_LEFT | RESIZE_DOWN:
+    case RESIZE_RIGHT | RESIZE_UP:
+        setCursor(Qt::SizeBDiagCursor);
+        break;
+    case RESIZE_LEFT:
+    case RESIZE_RIGHT:
+        setCursor(Qt::SizeHorCursor);
+        break;
+    case RESIZE_UP:
+    case RESIZE_DOWN:
+        setCursor(Qt::SizeVerCursor);
+        break;
+    default:
+        setCursor(isPressed ? Qt::ClosedHandCursor : Qt::OpenHandCursor);
+        break;
+    }
+}
+
+void GrabOverlay::mousePressEvent(QMouseEvent *pe)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << pe->globalPos();
+
+    m_cmd = NOP;
+    m_activeZone = zoneAt(pe->globalPos());
+
+    if (m_activeZone < 0)
+        return;
+
+    const QRect & zoneRect = m_zones->at(m_activeZone)->getRect();
+
+    if (pe->buttons() == Qt::RightButton
+            || (pe->buttons() == Qt::LeftButton && configButtonRect(zoneRect).contains(pe->globalPos())))
+    {
+        showConfigFor(m_activeZone);
+        m_activeZone = -1;
+    }
+    else if (pe->buttons() == Qt::LeftButton)
+    {
+        m_cmd = cmdAt(zoneRect, pe->globalPos());
+        m_mousePressZoneRect = zoneRect;
+        m_mousePressGlobalPosition = pe->globalPos();
+
+        setCursorForCmd(m_cmd, true);
+
+        // Mask follows only the active zone while moving or resizing
+        m_otherZonesMask = QRegion();
+        for (int i = 0; i < m_zones->count(); i++)
+        {
+            if (i != m_activeZone)
+                m_otherZonesMask += m_zones->at(i)->getRect();
+        }
+        m_otherZonesMask = m_otherZonesMask.intersected(geometry()).translated(-pos());
+
+        // Grab all mouse input, cursor can leave the zone while moving
+        grabMouse();
+
+        emit resizeOrMoveStarted();
+    }
+}
+
+void GrabOverlay::mouseMoveEvent(QMouseEvent *pe)
+{
+    DEBUG_HIGH_LEVEL << Q_FUNC_INFO << "pe->globalPos() =" << pe->globalPos();
+
+    if (m_cmd == NOP || m_activeZone < 0 || m_activeZone >= m_zones->count())
+    {
+        int zone = zoneAt(pe->globalPos());
+        if (zone >= 0 && configButtonRect(m_zones->at(zone)->getRect()).contains(pe->globalPos()))
+            setCursor(Qt::ArrowCursor);
+        else
+            setCursorForCmd(zone >= 0 ? cmdAt(m_zones->at(zone)->getRect(), pe->globalPos()) : NOP, false);
+        return;
+    }
+
+    QPoint delta = pe->globalPos() - m_mousePressGlobalPosition;
+    QRect r = m_mousePressZoneRect;
+    QRect screen = geometry();
+
+    if (m_cmd == MOVE)
+    {
+        r.translate(delta);
+
+        if (qAbs(r.left() - screen.left()) < StickyCloserPixels)
+            r.moveLeft(screen.left());
+
+        if (qAbs(r.top() - screen.top()) < StickyCloserPixels)
+            r.moveTop(screen.top());
+
+        if (qAbs(r.right() - screen.right()) < StickyCloserPixels)
+            r.moveRight(screen.right());
+
+        if (qAbs(r.bottom() - screen.bottom()) < StickyCloserPixels)
+            r.moveBottom(screen.bottom());
+    } else {
+        if (m_cmd & RESIZE_LEFT)
+            r.setLeft(qMin(r.left() + delta.x(), r.right() + 1 - MinimumWidth));
+        if (m_cmd & RESIZE_RIGHT)
+            r.setRight(qMax(r.right() + delta.x(), r.left() - 1 + MinimumWidth));
+        if (m_cmd & RESIZE_UP)
+            r.setTop(qMin(r.top() + delta.y(), r.bottom() + 1 - MinimumHeight));
+        if (m_cmd & RESIZE_DOWN)
+            r.setBottom(qMax(r.bottom() + delta.y(), r.top() - 1 + MinimumHeight));
+    }
+
+    QRect oldRect = m_zones->at(m_activeZone)->getRect();
+
+    if (r == oldRect)
+        return;
+
+    m_zones->at(m_activeZone)->setRect(r);
+
+    // Overlays of all screens rebuild masks on resizeOrMoveCompleted(),
+    // here only the active zone is added to the mask and repainted.
+    // Empty mask means no mask at all, keep the last one then.
+    QRegion region = m_otherZonesMask + r.intersected(geometry()).translated(-pos());
+
+    if (region.isEmpty() == false)
+        setMask(region);
+
+    update((oldRect | r).translated(-pos()));
+}
+
+void GrabOverlay::mouseReleaseEvent(QMouseEvent *pe)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+    // Release mouse after grab in mouse press event
+    releaseMouse();
+
+    int zone = m_activeZone;
+    bool isResizeOrMove = (m_cmd != NOP);
+
+    m_cmd = NOP;
+    m_activeZone = -1;
+
+    setCursorForCmd(NOP, false);
+    mouseMoveEvent(pe);
+
+    if (isResizeOrMove && zone >= 0 && zone < m_zones->count())
+    {
+        m_zones->at(zone)->saveSizeAndPosition();
+
+        emit resizeOrMoveCompleted(m_zones->at(zone)->getId());
+    }
+}
+
+void GrabOverlay::wheelEvent(QWheelEvent *pe)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+    int zone = zoneAt(pe->globalPos());
+
+    // Do nothing if area disabled
+    if (zone < 0 || m_zones->at(zone)->isAreaEnabled() == false)
+        return;
+
+    m_zones->at(zone)->fillBackgroundNext(pe->delta() > 0 ? 1 : -1);
+
+    update(m_zones->at(zone)->getRect().translated(-pos()));
+}
+
+void GrabOverlay::showConfigFor(int zoneIndex)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << zoneIndex;
+
+    LedZone * zone = m_zones->at(zoneIndex);
+    m_configZone = zoneIndex;
+
+    m_configWidget->setIsAreaEnabled(zone->isAreaEnabled());
+    m_configWidget->setCoefs(zone->getCoefRed(), zone->getCoefGreen(), zone->getCoefBlue());
+
+    // Find y-coordinate for center of the button
+    int buttonCenter = ConfigButtonMargin + ConfigButtonSize / 2;
+
+    m_configWidget->showConfigFor(zone->getRect(), buttonCenter);
+}
+
+void GrabOverlay::onIsAreaEnabled_Toggled(bool state)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
+
+    if (m_configZone < 0 || m_configZone >= m_zones->count())
+        return;
+
+    m_zones->at(m_configZone)->setAreaEnabled(state);
+
+    emit zonesChanged();
+}
+
+void GrabOverlay::onRedCoef_ValueChanged(double value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+
+    if (m_configZone >= 0 && m_configZone < m_zones->count())
+        m_zones->at(m_configZone)->setCoefRed(value);
+}
+
+void GrabOverlay::onGreenCoef_ValueChanged(double value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+
+    if (m_configZone >= 0 && m_configZone < m_zones->count())
+        m_zones->at(m_configZone)->setCoefGreen(value);
+}
+
+void GrabOverlay::onBlueCoef_ValueChanged(double value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+
+    if (m_configZone >= 0 && m_configZone < m_zones->count())
+        m_zones->at(m_configZone)->setCoefBlue(value);
+}
@@ -0,0 +1,113 @@
+/*
+ * GrabOverlay.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QWidget>
+#include "LedZone.hpp"
+#include "GrabConfigWidget.hpp"
+
+//
+// One frameless window per screen which draws all LED zones of the screen
+// and moves or resizes them. Window is shaped by the union of zones, so the
+// rest of the screen stays visible and clickable.
+//
+class GrabOverlay : public QWidget
+{
+    Q_OBJECT
+public:
+    GrabOverlay(int screen, const QList<LedZone *> * zones, QWidget *parent = 0);
+    ~GrabOverlay();
+
+    int getScreen() const { return m_screen; }
+
+    void setOverlayVisible(bool isVisible);
+    void updateScreenGeometry();
+    void updateZones();
+
+signals:
+    void resizeOrMoveStarted();
+    void resizeOrMoveCompleted(int id);
+    // Zone could be moved to or from other screens, their overlays should be updated too
+    void zonesChanged();
+
+protected:
+    virtual void closeEvent(QCloseEvent *event);
+    virtual void paintEvent(QPaintEvent *event);
+    virtual void mousePressEvent(QMouseEvent *pe);
+    virtual void mouseMoveEvent(QMouseEvent *pe);
+    virtual void mouseReleaseEvent(QMouseEvent *pe);
+    virtual void wheelEvent(QWheelEvent *pe);
+
+private slots:
+    void onIsAreaEnabled_Toggled(bool state);
+    void onRedCoef_ValueChanged(double value);
+    void onGreenCoef_ValueChanged(double value);
+    void onBlueCoef_ValueChanged(double value);
+
+private:
+    int zoneAt(const QPoint & pos);
+    int cmdAt(const QRect & zoneRect, const QPoint & pos);
+    QRect configButtonRect(const QRect & zoneRect);
+    void setCursorForCmd(int cmd, bool isPressed);
+    void showConfigFor(int zoneIndex);
+    void paintZone(QPainter & painter, const LedZone * zone);
+
+private:
+    // Flags of the zone border under the cursor, MOVE if none
+    enum {
+        NOP          = 0,
+        RESIZE_LEFT  = (1 << 0),
+        RESIZE_RIGHT = (1 << 1),
+        RESIZE_UP    = (1 << 2),
+        RESIZE_DOWN  = (1 << 3),
+        MOVE         = (1 << 4)
+    };
+
+    int m_screen;
+    const QList<LedZone *> * m_zones;
+    bool m_isOverlayVisible;
+
+    GrabConfigWidget * m_configWidget;
+    int m_configZone; // index of zone which edited by m_configWidget
+
+    int m_cmd;
+    int m_activeZone; // index of zone which moving or resizing
+    QRect m_mousePressZoneRect;
+    QPoint m_mousePressGlobalPosition;
+    QRegion m_otherZonesMask; // mask of zones except active one, while moving or resizing
+
+    QPixmap m_configButtonLight;
+    QPixmap m_configButtonDark;
+    QPixmap m_resizeIconLight;
+    QPixmap m_resizeIconDark;
+
+    static const int MinimumWidth = 50;
+    static const int MinimumHeight = 50;
+    static const int BorderWidth = 10;
+    static const int StickyCloserPixels = 10; // Sticky to screen when closer N pixels
+    static const int ConfigButtonSize = 24;
+    static const int ConfigButtonMargin = 9;
+};
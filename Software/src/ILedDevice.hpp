@@ -27,18 +27,26 @@
 #pragma once
 
 #include <QtGui>
-
+#include "LedFrameMailbox.hpp"
+#include "LedFrameLog.hpp"
 
 class ILedDevice : public QObject
 {
     Q_OBJECT
 public:
-    ILedDevice(QObject * parent) : QObject(parent) {}
+    ILedDevice(QObject * parent) : QObject(parent), m_frameMailbox(NULL), m_frameLog(NULL) {}
+
+    void setFrameMailbox(LedFrameMailbox * mailbox) { m_frameMailbox = mailbox; }
+
+    // Frames taken from mailbox are recorded to this log, NULL disables it
+    void setFrameLog(LedFrameLogWriter * frameLog) { m_frameLog = frameLog; }
 
 signals:
     void openDeviceSuccess(bool isSuccess);
     void ioDeviceSuccess(bool isSuccess);
     void firmwareVersion(const QString & fwVersion);
+    // Number of LEDs device can show, sent before firmwareVersion(QString) by devices which know it
+    void ledsCountReported(int ledsCount);
     // Signal commandCompleted(bool) must be sent at the completion of each command
     // (setColors, setTimerOptions, setColorDepth, setSmoothSlowdown, etc.)
     void commandCompleted(bool ok);
@@ -55,6 +63,28 @@ public slots:
     virtual void requestFirmwareVersion() = 0;
     virtual void updateDeviceSettings() = 0;
 
+    // Applies all options at once, unchanged ones are not sent to device and
+    // colors are resent at most once, commandCompleted(bool) emitted once
+    virtual void setSettings(int refreshDelay, int colorDepth, int smoothSlowdown, double gamma, int brightness) = 0;
+
     // deprecated, but may be usable for lightpack hw <= 5.5
     virtual void setColorDepth(int value) = 0;
+
+    // Sends the latest frame from mailbox, older frames are already dropped
+    void setLatestColors()
+    {
+        if (m_frameMailbox != NULL && m_frameMailbox->takeLatest())
+        {
+            if (m_frameLog != NULL)
+                m_frameLog->write(m_frameMailbox->latest());
+
+            setColors(m_frameMailbox->latest());
+        } else {
+            emit commandCompleted(true);
+        }
+    }
+
+private:
+    LedFrameMailbox * m_frameMailbox;
+    LedFrameLogWriter * m_frameLog;
 };
@@ -26,43 +26,15 @@
 
 #pragma once
 
-#include "ILedDevice.hpp"
-#include "StructRgb.hpp"
-#include "abstractserial.h"
+#include "LedDeviceSerial.hpp"
 
-class LedDeviceAdalight : public ILedDevice
+class LedDeviceAdalight : public LedDeviceSerial
 {
     Q_OBJECT
 public:
-    LedDeviceAdalight(QObject * parent = 0);
-    ~LedDeviceAdalight();
+    // Empty port name and baud rate mean using of connected device settings
+    LedDeviceAdalight(const QString & portName = QString(), const QString & baudRate = QString(), QObject * parent = 0);
 
-public slots:
-    void open();
-    void setColors(const QList<QRgb> & /*colors*/);
-    void offLeds();
-    void setRefreshDelay(int /*value*/);
-    void setColorDepth(int /*value*/);
-    void setSmoothSlowdown(int /*value*/);
-    void setGamma(double /*value*/);
-    void setBrightness(int /*value*/);
-    void requestFirmwareVersion();
-    void updateDeviceSettings();
-
-private:
-    bool writeBuffer(const QByteArray & buff);
-    void resizeColorsBuffer(int buffSize);
-    void reinitBufferHeader(int ledsCount);
-
-private:
-    AbstractSerial *m_AdalightDevice;
-
-    QByteArray m_writeBufferHeader;
-    QByteArray m_writeBuffer;
-
-    double m_gamma;
-    int m_brightness;
-
-    QList<QRgb> m_colorsSaved;
-    QList<StructRgb> m_colorsBuffer;
+protected:
+    void encodeFrame(const QList<StructRgb> & colors, QByteArray & frame);
 };
@@ -178,8 +178,14 @@ void LedDeviceAlienFx::updateDeviceSettings()
     DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
     // TODO
-    setGamma(Settings::getDeviceGamma());
-    setBrightness(Settings::getDeviceBrightness());
+    setSettings(Settings::getDeviceRefreshDelay(), Settings::getDeviceColorDepth(), Settings::getDeviceSmooth(),
+                Settings::getDeviceGamma(), Settings::getDeviceBrightness());
+}
+
+void LedDeviceAlienFx::setSettings(int /*refreshDelay*/, int /*colorDepth*/, int /*smoothSlowdown*/, double /*gamma*/, int /*brightness*/)
+{
+    // TODO
+    emit commandCompleted(true);
 }
 
 void LedDeviceAlienFx::open()
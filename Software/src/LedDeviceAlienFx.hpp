@@ -50,6 +50,7 @@ public slots:
     void setBrightness(int /*value*/);
     void requestFirmwareVersion();
     void updateDeviceSettings();
+    void setSettings(int /*refreshDelay*/, int /*colorDepth*/, int /*smoothSlowdown*/, double /*gamma*/, int /*brightness*/);
 
 private:
     HINSTANCE m_hLfxLibrary;
@@ -25,202 +25,16 @@
  */
 
 #include "LedDeviceArdulight.hpp"
-#include "LightpackMath.hpp"
-#include "Settings.hpp"
-#include "debug.h"
-#include "stdio.h"
+#include "SerialFrameEncoder.hpp"
+#include "enums.hpp"
 
-using namespace SettingsScope;
-
-LedDeviceArdulight::LedDeviceArdulight(QObject * parent) : ILedDevice(parent)
-{
-    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
-
-    m_gamma = Settings::getDeviceGamma();
-    m_brightness = Settings::getDeviceBrightness();
-
-    m_writeBufferHeader.append((char)255);
-
-    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "initialized";
-}
-
-LedDeviceArdulight::~LedDeviceArdulight()
-{
-    if (m_ArdulightDevice != NULL)
-        m_ArdulightDevice->close();
-
-    delete m_ArdulightDevice;
-}
-
-void LedDeviceArdulight::setColors(const QList<QRgb> & colors)
-{
-    DEBUG_MID_LEVEL << Q_FUNC_INFO << colors;
-
-    // Save colors for showing changes of the brightness
-    m_colorsSaved = colors;
-
-    resizeColorsBuffer(colors.count());
-
-    LightpackMath::gammaCorrection(m_gamma, colors, m_colorsBuffer);
-    LightpackMath::brightnessCorrection(m_brightness, m_colorsBuffer);
-
-    m_writeBuffer.clear();
-    m_writeBuffer.append(m_writeBufferHeader);
-
-    for (int i = 0; i < m_colorsBuffer.count(); i++)
-    {
-        StructRgb color = m_colorsBuffer[i];
-
-        m_writeBuffer.append(color.r);
-        m_writeBuffer.append(color.g);
-        m_writeBuffer.append(color.b);
-    }
-
-    bool ok = writeBuffer(m_writeBuffer);
-
-    emit commandCompleted(ok);
-}
-
-void LedDeviceArdulight::offLeds()
-{
-    int count = m_colorsSaved.count();
-    m_colorsSaved.clear();
-
-    for (int i = 0; i < count; i++)
-        m_colorsSaved << 0;
-
-    setColors(m_colorsSaved);
-}
-
-void LedDeviceArdulight::setRefreshDelay(int /*value*/)
-{
-    emit commandCompleted(true);
-}
-
-void LedDeviceArdulight::setColorDepth(int /*value*/)
-{
-    emit commandCompleted(true);
-}
-
-void LedDeviceArdulight::setSmoothSlowdown(int /*value*/)
-{
-    emit commandCompleted(true);
-}
-
-void LedDeviceArdulight::setGamma(double value)
+LedDeviceArdulight::LedDeviceArdulight(const QString & portName, const QString & baudRate, QObject * parent)
+    : LedDeviceSerial("ardulight", MaximumNumberOfLeds::Ardulight, ArdulightEncoder::ColorDepth, portName, baudRate, parent)
 {
-    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
-
-    m_gamma = value;
-    setColors(m_colorsSaved);
-}
-
-void LedDeviceArdulight::setBrightness(int percent)
-{
-    DEBUG_LOW_LEVEL << Q_FUNC_INFO << percent;
-
-    m_brightness = percent;
-    setColors(m_colorsSaved);
-}
-
-void LedDeviceArdulight::requestFirmwareVersion()
-{
-    emit firmwareVersion("unknown (ardulight device)");
-    emit commandCompleted(true);
-}
-
-void LedDeviceArdulight::updateDeviceSettings()
-{
-    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
-
-    setGamma(Settings::getDeviceGamma());
-    setBrightness(Settings::getDeviceBrightness());
-}
-
-void LedDeviceArdulight::open()
-{
-    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
-
-    m_gamma = Settings::getDeviceGamma();
-    m_brightness = Settings::getDeviceBrightness();
-
-    m_ArdulightDevice = new AbstractSerial();
-
-    m_ArdulightDevice->setDeviceName(Settings::getSerialPortName());
-
-    bool ok = m_ArdulightDevice->open(AbstractSerial::WriteOnly | AbstractSerial::Unbuffered);
-
-    // Ubuntu 10.04: on every second attempt to open the device leads to failure
-    if (ok == false)
-    {
-        // Try one more time
-        ok = m_ArdulightDevice->open(AbstractSerial::WriteOnly | AbstractSerial::Unbuffered);
-    }
-
-    if (ok)
-    {
-        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Serial device" << m_ArdulightDevice->deviceName() << "open";
-
-        ok = m_ArdulightDevice->setBaudRate(Settings::getSerialPortBaudRate());
-        if (ok)
-        {
-            ok = m_ArdulightDevice->setDataBits(AbstractSerial::DataBits8);
-            if (ok)
-            {
-                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Baud rate  :" << m_ArdulightDevice->baudRate();
-                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Data bits  :" << m_ArdulightDevice->dataBits();
-                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Parity     :" << m_ArdulightDevice->parity();
-                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Stop bits  :" << m_ArdulightDevice->stopBits();
-                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Flow       :" << m_ArdulightDevice->flowControl();
-            } else {
-                qWarning() << Q_FUNC_INFO << "Set data bits 8 fail";
-            }
-        } else {
-            qWarning() << Q_FUNC_INFO << "Set baud rate" << Settings::getSerialPortBaudRate() << "fail";
-        }
-
-    } else {
-        qWarning() << Q_FUNC_INFO << "Serial device" << m_ArdulightDevice->deviceName() << "open fail";
-    }
-
-    emit openDeviceSuccess(ok);
-}
-
-bool LedDeviceArdulight::writeBuffer(const QByteArray & buff)
-{
-    DEBUG_MID_LEVEL << Q_FUNC_INFO << "Hex:" << buff.toHex();
-
-    if (m_ArdulightDevice->isOpen() == false)
-        return false;
-
-    int bytesWritten = m_ArdulightDevice->write(buff);
-
-    if (bytesWritten != buff.count())
-    {
-        qWarning() << Q_FUNC_INFO << "bytesWritten != buff.count():" << bytesWritten << buff.count();
-        return false;
-    }
-
-    return true;
 }
 
-void LedDeviceArdulight::resizeColorsBuffer(int buffSize)
+// Start byte, then RGB colors of all LEDs of the sketch
+void LedDeviceArdulight::encodeFrame(const QList<StructRgb> & colors, QByteArray & frame)
 {
-    if (m_colorsBuffer.count() == buffSize)
-        return;
-
-    m_colorsBuffer.clear();
-
-    if (buffSize > MaximumNumberOfLeds::Ardulight)
-    {
-        qCritical() << Q_FUNC_INFO << "buffSize > MaximumNumberOfLeds::Ardulight" << buffSize << ">" << MaximumNumberOfLeds::Ardulight;
-
-        buffSize = MaximumNumberOfLeds::Ardulight;
-    }
-
-    for (int i = 0; i < buffSize; i++)
-    {
-        m_colorsBuffer << StructRgb();
-    }
+    ArdulightEncoder::encodeFrame(colors, frame);
 }
-
@@ -0,0 +1,317 @@
+/*
+ * LedDeviceDmx.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedDeviceDmx.hpp"
+#include "LightpackMath.hpp"
+#include "Settings.hpp"
+#include "debug.h"
+
+#include <QUuid>
+#include <string.h>
+
+using namespace SettingsScope;
+
+const int LedDeviceDmx::LedsPerUniverse = 170;
+const int LedDeviceDmx::MaximumUniverses = 64;
+
+const quint16 LedDeviceDmx::E131Port = 5568;
+const quint16 LedDeviceDmx::ArtNetPort = 6454;
+
+// ANSI E1.31-2016: root layer 38, framing layer 77, DMP layer 10 bytes + start code
+const int LedDeviceDmx::E131HeaderSize = 126;
+const int LedDeviceDmx::E131SyncPacketSize = 49;
+// Art-Net 4: ArtDmx and ArtSync
+const int LedDeviceDmx::ArtNetHeaderSize = 18;
+const int LedDeviceDmx::ArtNetSyncPacketSize = 14;
+
+static const int DmxChannelsMax = 512;
+
+// E1.31 offsets and values
+static const int E131RootFlagsLength = 16;
+static const int E131RootVector = 18;
+static const int E131Cid = 22;
+static const int E131FramingFlagsLength = 38;
+static const int E131FramingVector = 40;
+static const int E131SourceName = 44;
+static const int E131Priority = 108;
+static const int E131SyncAddress = 109;
+static const int E131Sequence = 111;
+static const int E131Options = 112;
+static const int E131Universe = 113;
+static const int E131DmpFlagsLength = 115;
+static const int E131SyncSequence = 44;
+static const int E131SyncSyncAddress = 45;
+
+static const quint32 VectorRootE131Data = 0x00000004;
+static const quint32 VectorRootE131Extended = 0x00000008;
+static const quint32 VectorE131DataPacket = 0x00000002;
+static const quint32 VectorE131ExtendedSynchronization = 0x00000001;
+
+// Art-Net offsets and values
+static const int ArtNetSequence = 12;
+static const quint16 ArtNetOpDmx = 0x5000;
+static const quint16 ArtNetOpSync = 0x5200;
+static const quint16 ArtNetProtocolVersion = 14;
+
+static inline void writeUInt16(char * buffer, quint16 value)
+{
+    buffer[0] = (char)(value >> 8);
+    buffer[1] = (char)(value & 0xff);
+}
+
+static inline void writeUInt32(char * buffer, quint32 value)
+{
+    writeUInt16(buffer, value >> 16);
+    writeUInt16(buffer + 2, value & 0xffff);
+}
+
+static inline void writeFlagsLength(char * buffer, int length)
+{
+    writeUInt16(buffer, 0x7000 | (length & 0x0fff));
+}
+
+LedDeviceDmx::LedDeviceDmx(Protocol protocol, const QString & host, const QString & startUniverse, QObject * parent)
+    : AbstractLedDevice(protocol == ProtocolE131 ? "E1.31" : "Art-Net", MaximumUniverses * LedsPerUniverse, 256, parent)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << protocol << host << startUniverse;
+
+    m_protocol = protocol;
+    m_host = host;
+    m_startUniverseString = startUniverse;
+    m_startUniverse = 1;
+
+    m_cid = QUuid::createUuid().toRfc4122();
+    m_sequence = 0;
+
+    m_packetsLedsCount = -1;
+    m_universesCount = 0;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "initialized";
+}
+
+LedDeviceDmx::~LedDeviceDmx()
+{
+    m_sender.close();
+}
+
+bool LedDeviceDmx::writeColors(const QList<StructRgb> & colors)
+{
+    if (m_packetsLedsCount != colors.count())
+        initPackets(colors.count());
+
+    int packetsCount = encodeFrame(colors);
+
+    // Lost datagrams are not an error, next frame overwrites all universes
+    bool ok = m_sender.send(packetsCount) >= 0;
+
+    if (ok == false)
+        qWarning() << Q_FUNC_INFO << "Send frame fail";
+
+    return ok;
+}
+
+void LedDeviceDmx::open()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    readCorrectionSettings();
+
+    QString host = m_host.isEmpty() ? Settings::getDmxHost() : m_host;
+    QString startUniverse = m_startUniverseString.isEmpty() ? QString::number(Settings::getDmxStartUniverse()) : m_startUniverseString;
+
+    // E1.31 universes are 1..63999, Art-Net 15-bit port address
+    int minimum = (m_protocol == ProtocolE131) ? 1 : 0;
+    int maximum = (m_protocol == ProtocolE131) ? 63999 : 0x7fff;
+
+    bool ok = false;
+    m_startUniverse = startUniverse.toInt(&ok);
+
+    if (ok == false || m_startUniverse < minimum || m_startUniverse + MaximumUniverses - 1 > maximum)
+    {
+        qWarning() << Q_FUNC_INFO << "Invalid start universe:" << startUniverse;
+        emit openDeviceSuccess(false);
+        return;
+    }
+
+    ok = m_sender.open(host, (m_protocol == ProtocolE131) ? E131Port : ArtNetPort);
+
+    if (ok == false)
+        qWarning() << Q_FUNC_INFO << "DMX device" << host << "open fail";
+
+    // Headers contain start universe
+    m_packetsLedsCount = -1;
+
+    emit openDeviceSuccess(ok);
+}
+
+void LedDeviceDmx::initPackets(int ledsCount)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << ledsCount;
+
+    m_universesCount = (ledsCount + LedsPerUniverse - 1) / LedsPerUniverse;
+
+    int headerSize = (m_protocol == ProtocolE131) ? E131HeaderSize : ArtNetHeaderSize;
+
+    // Universes and sync packet
+    m_sender.reserve(m_universesCount + 1, headerSize + DmxChannelsMax);
+
+    for (int i = 0; i < m_universesCount; i++)
+    {
+        int channelsCount = qMin(LedsPerUniverse, ledsCount - i * LedsPerUniverse) * 3;
+        char *packet = m_sender.packetData(i);
+
+        if (m_protocol == ProtocolE131)
+        {
+            initE131DataPacket(packet, m_startUniverse + i, channelsCount);
+        } else {
+            // ArtDmx length must be even
+            if (channelsCount % 2)
+                packet[headerSize + channelsCount++] = 0;
+
+            initArtNetDataPacket(packet, m_startUniverse + i, channelsCount);
+        }
+
+        m_sender.setPacketSize(i, headerSize + channelsCount);
+    }
+
+    char *syncPacket = m_sender.packetData(m_universesCount);
+
+    if (m_protocol == ProtocolE131)
+    {
+        initE131SyncPacket(syncPacket);
+        m_sender.setPacketSize(m_universesCount, E131SyncPacketSize);
+    } else {
+        initArtNetSyncPacket(syncPacket);
+        m_sender.setPacketSize(m_universesCount, ArtNetSyncPacketSize);
+    }
+
+    m_packetsLedsCount = ledsCount;
+}
+
+static void initE131RootLayer(char * packet, int packetSize, quint32 vector, const QByteArray & cid)
+{
+    writeUInt16(packet, 0x0010);    // preamble size
+    writeUInt16(packet + 2, 0x0000);// post-amble size
+    memcpy(packet + 4, "ASC-E1.17\0\0\0", 12);
+
+    writeFlagsLength(packet + E131RootFlagsLength, packetSize - E131RootFlagsLength);
+    writeUInt32(packet + E131RootVector, vector);
+    memcpy(packet + E131Cid, cid.constData(), qMin(16, cid.size()));
+}
+
+void LedDeviceDmx::initE131DataPacket(char * packet, int universe, int channelsCount)
+{
+    int packetSize = E131HeaderSize + channelsCount;
+
+    memset(packet, 0, E131HeaderSize);
+
+    initE131RootLayer(packet, packetSize, VectorRootE131Data, m_cid);
+
+    writeFlagsLength(packet + E131FramingFlagsLength, packetSize - E131FramingFlagsLength);
+    writeUInt32(packet + E131FramingVector, VectorE131DataPacket);
+    strncpy(packet + E131SourceName, "Lightpack", 63);
+    packet[E131Priority] = 100;
+    writeUInt16(packet + E131SyncAddress, m_startUniverse);
+    packet[E131Sequence] = 0;
+    packet[E131Options] = 0;
+    writeUInt16(packet + E131Universe, universe);
+
+    writeFlagsLength(packet + E131DmpFlagsLength, packetSize - E131DmpFlagsLength);
+    packet[E131DmpFlagsLength + 2] = 0x02;              // vector, set property
+    packet[E131DmpFlagsLength + 3] = (char)0xa1;        // address type and data type
+    writeUInt16(packet + E131DmpFlagsLength + 4, 0);    // first property address
+    writeUInt16(packet + E131DmpFlagsLength + 6, 1);    // address increment
+    writeUInt16(packet + E131DmpFlagsLength + 8, 1 + channelsCount);
+    packet[E131HeaderSize - 1] = 0;                     // DMX512 start code
+}
+
+void LedDeviceDmx::initE131SyncPacket(char * packet)
+{
+    memset(packet, 0, E131SyncPacketSize);
+
+    initE131RootLayer(packet, E131SyncPacketSize, VectorRootE131Extended, m_cid);
+
+    writeFlagsLength(packet + E131FramingFlagsLength, E131SyncPacketSize - E131FramingFlagsLength);
+    writeUInt32(packet + E131FramingVector, VectorE131ExtendedSynchronization);
+    writeUInt16(packet + E131SyncSyncAddress, m_startUniverse);
+}
+
+void LedDeviceDmx::initArtNetDataPacket(char * packet, int universe, int channelsCount)
+{
+    memset(packet, 0, ArtNetHeaderSize);
+
+    memcpy(packet, "Art-Net\0", 8);
+    packet[8] = (char)(ArtNetOpDmx & 0xff);     // OpCode is little-endian
+    packet[9] = (char)(ArtNetOpDmx >> 8);
+    writeUInt16(packet + 10, ArtNetProtocolVersion);
+    packet[14] = (char)(universe & 0xff);       // SubUni
+    packet[15] = (char)((universe >> 8) & 0x7f);// Net
+    writeUInt16(packet + 16, channelsCount);
+}
+
+void LedDeviceDmx::initArtNetSyncPacket(char * packet)
+{
+    memset(packet, 0, ArtNetSyncPacketSize);
+
+    memcpy(packet, "Art-Net\0", 8);
+    packet[8] = (char)(ArtNetOpSync & 0xff);
+    packet[9] = (char)(ArtNetOpSync >> 8);
+    writeUInt16(packet + 10, ArtNetProtocolVersion);
+}
+
+int LedDeviceDmx::encodeFrame(const QList<StructRgb> & colors)
+{
+    // Art-Net sequence 0 disables reordering on receiver
+    m_sequence++;
+    if (m_protocol == ProtocolArtNet && m_sequence == 0)
+        m_sequence = 1;
+
+    int headerSize = (m_protocol == ProtocolE131) ? E131HeaderSize : ArtNetHeaderSize;
+    int sequenceOffset = (m_protocol == ProtocolE131) ? E131Sequence : ArtNetSequence;
+
+    for (int i = 0; i < m_universesCount; i++)
+    {
+        char *packet = m_sender.packetData(i);
+        packet[sequenceOffset] = (char)m_sequence;
+
+        int first = i * LedsPerUniverse;
+        int last = qMin(first + LedsPerUniverse, colors.count());
+
+        char *data = packet + headerSize;
+        for (int led = first; led < last; led++)
+        {
+            const StructRgb & color = colors[led];
+
+            *data++ = (char)color.r;
+            *data++ = (char)color.g;
+            *data++ = (char)color.b;
+        }
+    }
+
+    if (m_protocol == ProtocolE131)
+        m_sender.packetData(m_universesCount)[E131SyncSequence] = (char)m_sequence;
+
+    return m_universesCount + 1;
+}
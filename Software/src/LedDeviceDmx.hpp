@@ -0,0 +1,88 @@
+/*
+ * LedDeviceDmx.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "AbstractLedDevice.hpp"
+#include "UdpPacketSender.hpp"
+
+// DMX over IP controllers: E1.31 (sACN) or Art-Net, unicast to one host.
+// LEDs are mapped to consecutive universes starting from startUniverse,
+// each frame is all universes and sync packet in one batch, so controllers
+// latch outputs of all universes together.
+class LedDeviceDmx : public AbstractLedDevice
+{
+    Q_OBJECT
+public:
+    enum Protocol
+    {
+        ProtocolE131,
+        ProtocolArtNet
+    };
+
+    // Empty host and start universe mean using of connected device settings
+    LedDeviceDmx(Protocol protocol, const QString & host = QString(), const QString & startUniverse = QString(), QObject * parent = 0);
+    ~LedDeviceDmx();
+
+    static const int LedsPerUniverse;   // 170 * 3 = 510 of 512 channels
+    static const int MaximumUniverses;
+
+    static const quint16 E131Port;
+    static const quint16 ArtNetPort;
+
+    static const int E131HeaderSize;
+    static const int E131SyncPacketSize;
+    static const int ArtNetHeaderSize;
+    static const int ArtNetSyncPacketSize;
+
+public slots:
+    void open();
+
+protected:
+    bool writeColors(const QList<StructRgb> & colors);
+
+private:
+    // Headers are written once for current LEDs count, frames update sequence and data only
+    void initPackets(int ledsCount);
+    void initE131DataPacket(char * packet, int universe, int channelsCount);
+    void initE131SyncPacket(char * packet);
+    void initArtNetDataPacket(char * packet, int universe, int channelsCount);
+    void initArtNetSyncPacket(char * packet);
+    int encodeFrame(const QList<StructRgb> & colors);
+
+private:
+    Protocol m_protocol;
+    UdpPacketSender m_sender;
+
+    QString m_host;
+    QString m_startUniverseString;
+    int m_startUniverse;
+
+    QByteArray m_cid;   // E1.31 source identifier
+    quint8 m_sequence;
+
+    int m_packetsLedsCount;
+    int m_universesCount;
+};
@@ -32,15 +32,101 @@
 #include "LedDeviceAdalight.hpp"
 #include "LedDeviceArdulight.hpp"
 #include "LedDeviceVirtual.hpp"
+#include "LedDeviceUdp.hpp"
+#include "LedDeviceDmx.hpp"
+#include "LedDeviceSerial.hpp"
 #include "Settings.hpp"
+#ifdef Q_OS_LINUX
+#   include "serialdeviceenumerator.h"
+#endif
 
 using namespace SettingsScope;
 
 LedDeviceFactory::LedDeviceFactory(QObject *parent)
     : QObject(parent)
+{
+    m_isExtraDevice = false;
+    m_ledsCount = Settings::getNumberOfLeds(Settings::getConnectedDevice());
+    m_frameLog = NULL;
+
+#ifdef Q_OS_LINUX
+    m_serialDeviceEnumerator = new SerialDeviceEnumerator(this);
+#else
+    m_serialDeviceEnumerator = NULL;
+#endif
+
+    init();
+    initExtraDevices();
+}
+
+LedDeviceFactory::LedDeviceFactory(const ExtraLedDevice & extraDevice, LedDeviceFactory *parent)
+    : QObject(parent)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << extraDevice.type << extraDevice.firstLed << extraDevice.ledsCount;
+
+    m_isExtraDevice = true;
+    m_extraDevice = extraDevice;
+    m_ledsCount = extraDevice.ledsCount;
+    m_frameLog = NULL;
+    m_serialDeviceEnumerator = parent->m_serialDeviceEnumerator;
+
+    init();
+
+    connect(this, SIGNAL(openDeviceSuccess(bool)), this, SLOT(extraDeviceSuccess(bool)));
+    connect(this, SIGNAL(ioDeviceSuccess(bool)), this, SLOT(extraDeviceSuccess(bool)));
+}
+
+LedDeviceFactory::~LedDeviceFactory()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    // Devices live in m_ledDeviceThread, they will be deleted there before it finished
+    for (int i = 0; i < m_ledDevices.size(); i++)
+        if (m_ledDevices[i] != NULL)
+            m_ledDevices[i]->deleteLater();
+
+    m_ledDeviceThread->quit();
+    m_ledDeviceThread->wait();
+
+    delete m_ledDeviceThread;
+
+    // Devices are deleted, nobody writes to log
+    delete m_frameLog;
+}
+
+bool LedDeviceFactory::recordFrames(const QString & fileName)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << fileName;
+
+    if (m_frameLog == NULL)
+        m_frameLog = new LedFrameLogWriter();
+
+    if (m_frameLog->open(fileName) == false)
+        return false;
+
+    // Called before backlight is started, so devices don't write frames yet
+    for (int i = 0; i < m_ledDevices.size(); i++)
+        if (m_ledDevices[i] != NULL)
+            m_ledDevices[i]->setFrameLog(m_frameLog);
+
+    return true;
+}
+
+void LedDeviceFactory::init()
 {
     m_isLastCommandCompleted = true;
 
+    m_savedRefreshDelay = Settings::getDeviceRefreshDelay();
+    m_savedColorDepth = Settings::getDeviceColorDepth();
+    m_savedSmoothSlowdown = Settings::getDeviceSmooth();
+    m_savedGamma = Settings::getDeviceGamma();
+    m_savedBrightness = Settings::getDeviceBrightness();
+
+    m_timerSettingsBurst = new QTimer(this);
+    m_timerSettingsBurst->setSingleShot(true);
+    m_timerSettingsBurst->setInterval(0);
+    connect(m_timerSettingsBurst, SIGNAL(timeout()), this, SLOT(settingsBurstTimeout()));
+
     m_ledDeviceThread = new QThread();
 
     for (int i = 0; i < SupportedDevices::DevicesCount; i++)
@@ -55,19 +141,87 @@ void LedDeviceFactory::recreateLedDevice()
 
     disconnectSignalSlotsLedDevice();
 
+    m_publishMutex.lock();
+    m_ledsCount = Settings::getNumberOfLeds(Settings::getConnectedDevice());
+    m_publishMutex.unlock();
+
     initLedDevice();
+
+    // This slot is called directly from another thread, so recreate
+    // extra devices later in own thread
+    QMetaObject::invokeMethod(this, "initExtraDevices", Qt::QueuedConnection);
 }
 
-void LedDeviceFactory::setColors(const QList<QRgb> & colors)
+void LedDeviceFactory::updateNumberOfLeds()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    QMutexLocker locker(&m_publishMutex);
+
+    m_ledsCount = Settings::getNumberOfLeds(Settings::getConnectedDevice());
+}
+
+void LedDeviceFactory::initExtraDevices()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    QMutexLocker locker(&m_publishMutex);
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        delete m_extraDevices[i];
+
+    m_extraDevices.clear();
+
+    QList<ExtraLedDevice> extraDevices = Settings::getExtraLedDevices();
+
+    for (int i = 0; i < extraDevices.size(); i++)
+    {
+        m_extraDevices << new LedDeviceFactory(extraDevices[i], this);
+    }
+}
+
+void LedDeviceFactory::extraDeviceSuccess(bool isSuccess)
+{
+    if (isSuccess == false)
+        qWarning() << Q_FUNC_INFO << "Extra device" << m_extraDevice.type << m_extraDevice.serialPortName << m_extraDevice.host << "fail";
+}
+
+void LedDeviceFactory::publishColors(const QList<QRgb> & colors)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << "frames published:" << m_frameMailbox.countPublished()
+                    << "overwritten:" << m_frameMailbox.countOverwritten();
+
+    QMutexLocker locker(&m_publishMutex);
+
+    // Device takes the latest frame when it is ready, so frames published
+    // while it is busy are just replaced
+    if (m_isExtraDevice)
+        m_frameMailbox.publish(colors, m_extraDevice.firstLed, m_ledsCount);
+    else if (m_extraDevices.isEmpty())
+        m_frameMailbox.publish(colors);
+    else
+        m_frameMailbox.publish(colors, 0, m_ledsCount);
+
+    // Each extra device sends frames at its own pace
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->publishColors(colors);
+
+    // One wakeup is enough for any number of frames published before it
+    if (m_isPublishPending.testAndSetOrdered(0, 1))
+        QMetaObject::invokeMethod(this, "processPublishedColors", Qt::QueuedConnection);
+}
+
+void LedDeviceFactory::processPublishedColors()
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << "Is last command completed:" << m_isLastCommandCompleted;
 
+    m_isPublishPending.fetchAndStoreOrdered(0);
+
     if (m_isLastCommandCompleted)
     {
         m_isLastCommandCompleted = false;
-        emit ledDeviceSetColors(colors);
+        emit ledDeviceSetLatestColors();
     } else {
-        m_savedColors = colors;
         cmdQueueAppend(LedDeviceCommands::SetColors);
     }
 }
@@ -83,6 +237,9 @@ void LedDeviceFactory::offLeds()
     } else {
         cmdQueueAppend(LedDeviceCommands::OffLeds);
     }
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->offLeds();
 }
 
 void LedDeviceFactory::setRefreshDelay(int value)
@@ -90,70 +247,55 @@ void LedDeviceFactory::setRefreshDelay(int value)
     DEBUG_MID_LEVEL << Q_FUNC_INFO << value
                     << "Is last command completed:" << m_isLastCommandCompleted;
 
-    if (m_isLastCommandCompleted)
-    {
-        m_isLastCommandCompleted = false;
-        emit ledDeviceSetRefreshDelay(value);
-    } else {
-        m_savedRefreshDelay = value;
-        cmdQueueAppend(LedDeviceCommands::SetRefreshDelay);
-    }
+    m_savedRefreshDelay = value;
+    settingsChanged();
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->setRefreshDelay(value);
 }
 
 void LedDeviceFactory::setColorDepth(int value)
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << value << "Is last command completed:" << m_isLastCommandCompleted;
 
-    if (m_isLastCommandCompleted)
-    {
-        m_isLastCommandCompleted = false;
-        emit ledDeviceSetColorDepth(value);
-    } else {
-        m_savedColorDepth = value;
-        cmdQueueAppend(LedDeviceCommands::SetColorDepth);
-    }
+    m_savedColorDepth = value;
+    settingsChanged();
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->setColorDepth(value);
 }
 
 void LedDeviceFactory::setSmoothSlowdown(int value)
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << value << "Is last command completed:" << m_isLastCommandCompleted;
 
-    if (m_isLastCommandCompleted)
-    {
-        m_isLastCommandCompleted = false;
-        emit ledDeviceSetSmoothSlowdown(value);
-    } else {
-        m_savedSmoothSlowdown = value;
-        cmdQueueAppend(LedDeviceCommands::SetSmoothSlowdown);
-    }
+    m_savedSmoothSlowdown = value;
+    settingsChanged();
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->setSmoothSlowdown(value);
 }
 
 void LedDeviceFactory::setGamma(double value)
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << value << "Is last command completed:" << m_isLastCommandCompleted;
 
-    if (m_isLastCommandCompleted)
-    {
-        m_isLastCommandCompleted = false;
-        emit ledDeviceSetGamma(value);
-    } else {
-        m_savedGamma = value;
-        cmdQueueAppend(LedDeviceCommands::SetGamma);
-    }
+    m_savedGamma = value;
+    settingsChanged();
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->setGamma(value);
 }
 
 void LedDeviceFactory::setBrightness(int value)
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << value << "Is last command completed:" << m_isLastCommandCompleted;
 
-    if (m_isLastCommandCompleted)
-    {
-        m_isLastCommandCompleted = false;
-        emit ledDeviceSetBrightness(value);
-    } else {
-        m_savedBrightness = value;
-        cmdQueueAppend(LedDeviceCommands::SetBrightness);
-    }
+    m_savedBrightness = value;
+    settingsChanged();
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->setBrightness(value);
 }
 
 void LedDeviceFactory::requestFirmwareVersion()
@@ -173,6 +315,16 @@ void LedDeviceFactory::updateDeviceSettings()
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << "Is last command completed:" << m_isLastCommandCompleted;
 
+    // Device reads new profile itself, but keep values for the next changes
+    m_savedRefreshDelay = Settings::getDeviceRefreshDelay();
+    m_savedColorDepth = Settings::getDeviceColorDepth();
+    m_savedSmoothSlowdown = Settings::getDeviceSmooth();
+    m_savedGamma = Settings::getDeviceGamma();
+    m_savedBrightness = Settings::getDeviceBrightness();
+
+    // Single update covers all options changed before it
+    m_cmdQueue.removeAll(LedDeviceCommands::SetSettings);
+
     if (m_isLastCommandCompleted)
     {
         m_isLastCommandCompleted = false;
@@ -180,6 +332,31 @@ void LedDeviceFactory::updateDeviceSettings()
     } else {
         cmdQueueAppend(LedDeviceCommands::UpdateDeviceSettings);
     }
+
+    for (int i = 0; i < m_extraDevices.size(); i++)
+        m_extraDevices[i]->updateDeviceSettings();
+}
+
+void LedDeviceFactory::settingsChanged()
+{
+    cmdQueueAppend(LedDeviceCommands::SetSettings);
+
+    // Wait for the end of burst (slider drag, several options changed at once)
+    // and send one update with the latest values
+    if (m_isLastCommandCompleted && m_timerSettingsBurst->isActive() == false)
+        m_timerSettingsBurst->start();
+}
+
+void LedDeviceFactory::settingsBurstTimeout()
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << "Is last command completed:" << m_isLastCommandCompleted;
+
+    // Otherwise queue will be processed on completion of the current command
+    if (m_isLastCommandCompleted && m_cmdQueue.isEmpty() == false)
+    {
+        m_isLastCommandCompleted = false;
+        cmdQueueProcessNext();
+    }
 }
 
 void LedDeviceFactory::ledDeviceCommandCompleted(bool ok)
@@ -208,11 +385,13 @@ void LedDeviceFactory::initLedDevice()
 
     m_isLastCommandCompleted = true;
 
-    SupportedDevices::DeviceType connectedDevice = Settings::getConnectedDevice();
+    SupportedDevices::DeviceType connectedDevice = m_isExtraDevice ? m_extraDevice.type : Settings::getConnectedDevice();
 
     if (m_ledDevices[connectedDevice] == NULL)
     {
         m_ledDevice = m_ledDevices[connectedDevice] = createLedDevice(connectedDevice);
+        m_ledDevice->setFrameMailbox(&m_frameMailbox);
+        m_ledDevice->setFrameLog(m_frameLog);
 
         connectSignalSlotsLedDevice();
 
@@ -232,7 +411,7 @@ void LedDeviceFactory::initLedDevice()
 ILedDevice * LedDeviceFactory::createLedDevice(SupportedDevices::DeviceType deviceType)
 {    
 
-    if (deviceType == SupportedDevices::AlienFxDevice){
+    if (deviceType == SupportedDevices::AlienFxDevice && m_isExtraDevice == false){
 #       if !defined(Q_WS_WIN)
         qWarning() << Q_FUNC_INFO << "AlienFx not supported on current platform";
 
@@ -258,12 +437,36 @@ ILedDevice * LedDeviceFactory::createLedDevice(SupportedDevices::DeviceType devi
 
     case SupportedDevices::AdalightDevice:
         DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::AdalightDevice";
+        if (m_isExtraDevice)
+            return (ILedDevice *)new LedDeviceAdalight(m_extraDevice.serialPortName, m_extraDevice.serialPortBaudRate);
         return (ILedDevice *)new LedDeviceAdalight();
 
     case SupportedDevices::ArdulightDevice:
         DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::ArdulightDevice";
+        if (m_isExtraDevice)
+            return (ILedDevice *)new LedDeviceArdulight(m_extraDevice.serialPortName, m_extraDevice.serialPortBaudRate);
         return (ILedDevice *)new LedDeviceArdulight();
 
+    case SupportedDevices::UdpDevice:
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::UdpDevice";
+        if (m_isExtraDevice)
+            return (ILedDevice *)new LedDeviceUdp(m_extraDevice.host, m_extraDevice.port > 0 ? QString::number(m_extraDevice.port) : QString());
+        return (ILedDevice *)new LedDeviceUdp();
+
+    case SupportedDevices::E131Device:
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::E131Device";
+        if (m_isExtraDevice)
+            return (ILedDevice *)new LedDeviceDmx(LedDeviceDmx::ProtocolE131, m_extraDevice.host,
+                                                  m_extraDevice.startUniverse > 0 ? QString::number(m_extraDevice.startUniverse) : QString());
+        return (ILedDevice *)new LedDeviceDmx(LedDeviceDmx::ProtocolE131);
+
+    case SupportedDevices::ArtNetDevice:
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::ArtNetDevice";
+        if (m_isExtraDevice)
+            return (ILedDevice *)new LedDeviceDmx(LedDeviceDmx::ProtocolArtNet, m_extraDevice.host,
+                                                  m_extraDevice.startUniverse > 0 ? QString::number(m_extraDevice.startUniverse) : QString());
+        return (ILedDevice *)new LedDeviceDmx(LedDeviceDmx::ProtocolArtNet);
+
     case SupportedDevices::VirtualDevice:
         DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::VirtualDevice";
         return (ILedDevice *)new LedDeviceVirtual();
@@ -289,21 +492,25 @@ void LedDeviceFactory::connectSignalSlotsLedDevice()
 
     connect(m_ledDevice, SIGNAL(commandCompleted(bool)),        this, SLOT(ledDeviceCommandCompleted(bool)), Qt::QueuedConnection);
 
+    connect(m_ledDevice, SIGNAL(ledsCountReported(int)),        this, SIGNAL(ledsCountReported(int)), Qt::QueuedConnection);
     connect(m_ledDevice, SIGNAL(firmwareVersion(QString)),      this, SIGNAL(firmwareVersion(QString)), Qt::QueuedConnection);
     connect(m_ledDevice, SIGNAL(ioDeviceSuccess(bool)),         this, SIGNAL(ioDeviceSuccess(bool)), Qt::QueuedConnection);
     connect(m_ledDevice, SIGNAL(openDeviceSuccess(bool)),       this, SIGNAL(openDeviceSuccess(bool)), Qt::QueuedConnection);    
     connect(m_ledDevice, SIGNAL(setColors_VirtualDeviceCallback(QList<QRgb>)), this, SIGNAL(setColors_VirtualDeviceCallback(QList<QRgb>)), Qt::QueuedConnection);    
 
     connect(this, SIGNAL(ledDeviceOpen()),                      m_ledDevice, SLOT(open()), Qt::QueuedConnection);
-    connect(this, SIGNAL(ledDeviceSetColors(QList<QRgb>)),      m_ledDevice, SLOT(setColors(QList<QRgb>)), Qt::QueuedConnection);
+    connect(this, SIGNAL(ledDeviceSetLatestColors()),           m_ledDevice, SLOT(setLatestColors()), Qt::QueuedConnection);
     connect(this, SIGNAL(ledDeviceOffLeds()),                   m_ledDevice, SLOT(offLeds()), Qt::QueuedConnection);
-    connect(this, SIGNAL(ledDeviceSetRefreshDelay(int)),        m_ledDevice, SLOT(setRefreshDelay(int)), Qt::QueuedConnection);
-    connect(this, SIGNAL(ledDeviceSetColorDepth(int)),          m_ledDevice, SLOT(setColorDepth(int)), Qt::QueuedConnection);
-    connect(this, SIGNAL(ledDeviceSetSmoothSlowdown(int)),      m_ledDevice, SLOT(setSmoothSlowdown(int)), Qt::QueuedConnection);
-    connect(this, SIGNAL(ledDeviceSetGamma(double)),            m_ledDevice, SLOT(setGamma(double)), Qt::QueuedConnection);
-    connect(this, SIGNAL(ledDeviceSetBrightness(int)),          m_ledDevice, SLOT(setBrightness(int)), Qt::QueuedConnection);
+    connect(this, SIGNAL(ledDeviceSetSettings(int,int,int,double,int)), m_ledDevice, SLOT(setSettings(int,int,int,double,int)), Qt::QueuedConnection);
     connect(this, SIGNAL(ledDeviceRequestFirmwareVersion()),    m_ledDevice, SLOT(requestFirmwareVersion()), Qt::QueuedConnection);
     connect(this, SIGNAL(ledDeviceUpdateDeviceSettings()),      m_ledDevice, SLOT(updateDeviceSettings()), Qt::QueuedConnection);
+
+    // Only connected device follows hotplug, the rest keep their ports closed
+    if (m_serialDeviceEnumerator != NULL && qobject_cast<LedDeviceSerial *>(m_ledDevice) != NULL)
+    {
+        connect(m_serialDeviceEnumerator, SIGNAL(deviceAdded(QString,QString,QString)),   m_ledDevice, SLOT(serialDeviceAdded(QString)), Qt::QueuedConnection);
+        connect(m_serialDeviceEnumerator, SIGNAL(deviceRemoved(QString,QString,QString)), m_ledDevice, SLOT(serialDeviceRemoved(QString)), Qt::QueuedConnection);
+    }
 }
 
 void LedDeviceFactory::disconnectSignalSlotsLedDevice()
@@ -316,20 +523,20 @@ void LedDeviceFactory::disconnectSignalSlotsLedDevice()
 
     disconnect(m_ledDevice, SIGNAL(commandCompleted(bool)),     this, SLOT(ledDeviceCommandCompleted(bool)));
 
+    disconnect(m_ledDevice, SIGNAL(ledsCountReported(int)),     this, SIGNAL(ledsCountReported(int)));
     disconnect(m_ledDevice, SIGNAL(firmwareVersion(QString)),   this, SIGNAL(firmwareVersion(QString)));
     disconnect(m_ledDevice, SIGNAL(ioDeviceSuccess(bool)),      this, SIGNAL(ioDeviceSuccess(bool)));
     disconnect(m_ledDevice, SIGNAL(openDeviceSuccess(bool)),    this, SIGNAL(openDeviceSuccess(bool)));
 
     disconnect(this, SIGNAL(ledDeviceOpen()),                   m_ledDevice, SLOT(open()));
-    disconnect(this, SIGNAL(ledDeviceSetColors(QList<QRgb>)),   m_ledDevice, SLOT(setColors(QList<QRgb>)));
+    disconnect(this, SIGNAL(ledDeviceSetLatestColors()),        m_ledDevice, SLOT(setLatestColors()));
     disconnect(this, SIGNAL(ledDeviceOffLeds()),                m_ledDevice, SLOT(offLeds()));
-    disconnect(this, SIGNAL(ledDeviceSetRefreshDelay(int)),     m_ledDevice, SLOT(setRefreshDelay(int)));
-    disconnect(this, SIGNAL(ledDeviceSetColorDepth(int)),       m_ledDevice, SLOT(setColorDepth(int)));
-    disconnect(this, SIGNAL(ledDeviceSetSmoothSlowdown(int)),   m_ledDevice, SLOT(setSmoothSlowdown(int)));
-    disconnect(this, SIGNAL(ledDeviceSetGamma(double)),         m_ledDevice, SLOT(setGamma(double)));
-    disconnect(this, SIGNAL(ledDeviceSetBrightness(int)),       m_ledDevice, SLOT(setBrightness(int)));
+    disconnect(this, SIGNAL(ledDeviceSetSettings(int,int,int,double,int)), m_ledDevice, SLOT(setSettings(int,int,int,double,int)));
     disconnect(this, SIGNAL(ledDeviceRequestFirmwareVersion()), m_ledDevice, SLOT(requestFirmwareVersion()));
     disconnect(this, SIGNAL(ledDeviceUpdateDeviceSettings()),   m_ledDevice, SLOT(updateDeviceSettings()));
+
+    if (m_serialDeviceEnumerator != NULL)
+        disconnect(m_serialDeviceEnumerator, 0, m_ledDevice, 0);
 }
 
 void LedDeviceFactory::cmdQueueAppend(LedDeviceCommands::Cmd cmd)
@@ -357,27 +564,12 @@ void LedDeviceFactory::cmdQueueProcessNext()
             break;
 
         case LedDeviceCommands::SetColors:
-            emit ledDeviceSetColors(m_savedColors);
-            break;
-
-        case LedDeviceCommands::SetRefreshDelay:
-            emit ledDeviceSetRefreshDelay(m_savedRefreshDelay);
-            break;
-
-        case LedDeviceCommands::SetColorDepth:
-            emit ledDeviceSetColorDepth(m_savedColorDepth);
-            break;
-
-        case LedDeviceCommands::SetSmoothSlowdown:
-            emit ledDeviceSetSmoothSlowdown(m_savedSmoothSlowdown);
-            break;
-
-        case LedDeviceCommands::SetGamma:
-            emit ledDeviceSetGamma(m_savedGamma);
+            emit ledDeviceSetLatestColors();
             break;
 
-        case LedDeviceCommands::SetBrightness:
-            emit ledDeviceSetBrightness(m_savedBrightness);
+        case LedDeviceCommands::SetSettings:
+            emit ledDeviceSetSettings(m_savedRefreshDelay, m_savedColorDepth, m_savedSmoothSlowdown,
+                                      m_savedGamma, m_savedBrightness);
             break;
 
         case LedDeviceCommands::RequestFirmwareVersion:
@@ -27,7 +27,11 @@
 #pragma once
 
 #include "enums.hpp"
+#include "Settings.hpp"
 #include "ILedDevice.hpp"
+#include "LedFrameMailbox.hpp"
+
+class SerialDeviceEnumerator;
 
 class LedDeviceFactory : public QObject
 {
@@ -35,30 +39,35 @@ class LedDeviceFactory : public QObject
 
 public:
     explicit LedDeviceFactory(QObject *parent = 0);
+    ~LedDeviceFactory();
+
+private:
+    // Extra device, it has own thread and gets only its LEDs of each frame
+    LedDeviceFactory(const SettingsScope::ExtraLedDevice & extraDevice, LedDeviceFactory *parent);
 
 signals:
     void openDeviceSuccess(bool isSuccess);
     void ioDeviceSuccess(bool isSuccess);
     void firmwareVersion(const QString & fwVersion);
+    void ledsCountReported(int ledsCount);
     void setColors_VirtualDeviceCallback(const QList<QRgb> & colors);
 
     // This signals are directly connected to ILedDevice. Don't use outside.
     void ledDeviceOpen();
-    void ledDeviceSetColors(const QList<QRgb> & colors);
+    void ledDeviceSetLatestColors();
     void ledDeviceOffLeds();
-    void ledDeviceSetRefreshDelay(int value);
-    void ledDeviceSetColorDepth(int value);
-    void ledDeviceSetSmoothSlowdown(int value);
-    void ledDeviceSetGamma(double value);
-    void ledDeviceSetBrightness(int value);
+    void ledDeviceSetSettings(int refreshDelay, int colorDepth, int smoothSlowdown, double gamma, int brightness);
     void ledDeviceRequestFirmwareVersion();
     void ledDeviceUpdateDeviceSettings();
 
 public slots:
     void recreateLedDevice();
 
+    // Thread-safe, connected directly to producers of frames (GUI and API
+    // server threads): copies frame into mailbox and wakes device thread
+    void publishColors(const QList<QRgb> & colors);
+
     // This slots are protected from the overflow of queries
-    void setColors(const QList<QRgb> & colors);
     void offLeds();
     void setRefreshDelay(int value);
     void setColorDepth(int value);
@@ -67,24 +76,42 @@ public slots:
     void setBrightness(int value);
     void requestFirmwareVersion();
     void updateDeviceSettings();
+    void updateNumberOfLeds();
+
+public:
+    // Records frames sent to connected device, see LedFrameLog.hpp
+    bool recordFrames(const QString & fileName);
 
 private slots:
     void ledDeviceCommandCompleted(bool ok);
+    void extraDeviceSuccess(bool isSuccess);
+    void initExtraDevices();
+    void settingsBurstTimeout();
+    void processPublishedColors();
 
 private:    
+    void init();
     void initLedDevice();
     ILedDevice * createLedDevice(SupportedDevices::DeviceType deviceType);
     void connectSignalSlotsLedDevice();
     void disconnectSignalSlotsLedDevice();
     void cmdQueueAppend(LedDeviceCommands::Cmd);
     void cmdQueueProcessNext();
+    void settingsChanged();
 
 private:
     bool m_isLastCommandCompleted;
 
     QList<LedDeviceCommands::Cmd> m_cmdQueue;
 
-    QList<QRgb> m_savedColors;
+    // Settings changed in one pass of event loop are sent to device once
+    QTimer *m_timerSettingsBurst;
+
+    LedFrameMailbox m_frameMailbox;
+    // Producers publish one by one, it guards m_ledsCount and m_extraDevices too
+    QMutex m_publishMutex;
+    QAtomicInt m_isPublishPending;
+    LedFrameLogWriter *m_frameLog;
     int m_savedRefreshDelay;
     int m_savedColorDepth;
     int m_savedSmoothSlowdown;
@@ -94,4 +121,15 @@ private:
     QList<ILedDevice *> m_ledDevices;
     ILedDevice *m_ledDevice;
     QThread *m_ledDeviceThread;
+
+    // Created once in GUI thread by main factory and shared with extra ones,
+    // NULL if serial devices hotplug isn't supported on current platform
+    SerialDeviceEnumerator *m_serialDeviceEnumerator;
+
+    // Connected device shows LEDs [0, m_ledsCount) of frame, if there are extra devices
+    int m_ledsCount;
+
+    bool m_isExtraDevice;
+    SettingsScope::ExtraLedDevice m_extraDevice;
+    QList<LedDeviceFactory *> m_extraDevices;
 };
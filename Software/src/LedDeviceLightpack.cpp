@@ -25,6 +25,7 @@
  */
 
 #include "LedDeviceLightpack.hpp"
+#include "LedFrameEncoder.hpp"
 
 #include <unistd.h>
 
@@ -45,6 +46,23 @@ LedDeviceLightpack::LedDeviceLightpack(QObject *parent) :
 
     m_hidDevice = NULL;
 
+    m_gamma = Settings::getDeviceGamma();
+    m_brightness = Settings::getDeviceBrightness();
+    m_gammaTable.setLinearLight(Settings::isGrabLinearLightEnabled());
+
+    m_refreshDelay = -1;
+    m_colorDepth = -1;
+    m_smoothSlowdown = -1;
+
+    m_isDeltaSupported = false;
+    m_isPackedSupported = false;
+    m_changedMaskSent = 0;
+    m_maximumLedsCount = MaximumLedsCount;
+    m_frameId = 0;
+
+    // Framed firmware can report more LEDs than one report holds
+    m_colorsSaved.reserve(MaximumNumberOfLeds::AbsoluteMaximum);
+
     memset(m_writeBuffer, 0, sizeof(m_writeBuffer));
     memset(m_readBuffer, 0, sizeof(m_readBuffer));
 
@@ -54,6 +72,11 @@ LedDeviceLightpack::LedDeviceLightpack(QObject *parent) :
     connect(this, SIGNAL(ioDeviceSuccess(bool)), this, SLOT(restartPingDevice(bool)));
     connect(this, SIGNAL(openDeviceSuccess(bool)), this, SLOT(restartPingDevice(bool)));
 
+    m_hotplugMonitor = new UsbHotplugMonitor(USB_VENDOR_ID, USB_PRODUCT_ID, this);
+
+    connect(m_hotplugMonitor, SIGNAL(deviceArrived()), this, SLOT(hotplugDeviceArrived()));
+    connect(m_hotplugMonitor, SIGNAL(deviceRemoved()), this, SLOT(hotplugDeviceRemoved()));
+
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << "initialized";
 }
 
@@ -70,38 +93,147 @@ void LedDeviceLightpack::setColors(const QList<QRgb> & colors)
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << "thread id: " << this->thread()->currentThreadId();
 #endif
 
-    resizeColorsBuffer(colors.count());
+    bool ok = writeColors(colors);
+
+    // WARNING: LedDeviceFactory sends data only when the arrival of this signal
+    emit commandCompleted(ok);
+}
+
+bool LedDeviceLightpack::writeColors(const QList<QRgb> & frameColors)
+{
+    // Save colors for showing changes of the brightness. Frame could have
+    // more LEDs than device reported, they are dropped
+    LedFrameMailbox::copyColors(frameColors, m_colorsSaved, 0, m_maximumLedsCount);
 
-    // Save colors for showing changes of the brightness
-    m_colorsSaved = colors;
+    resizeColorsBuffer(m_colorsSaved.count());
 
-    LightpackMath::gammaCorrection(m_gamma, colors, m_colorsBuffer, 4096 /* 12-bit result */);
+    m_gammaTable.gammaCorrection(m_gamma, m_colorsSaved, m_colorsBuffer, 4096 /* 12-bit result */);
     LightpackMath::brightnessCorrection(m_brightness, m_colorsBuffer);
 
+    int reportLedsCount = m_isPackedSupported ? (int)UPDATE_LEDS_PACKED_MAX_LEDS : MaximumLedsCount;
+
+    if (m_colorsBuffer.count() > reportLedsCount)
+        return writeFrame();
+
+    int fullFrameSize = m_isPackedSupported ? UPDATE_LEDS_PACKED_SIZE(m_colorsBuffer.count())
+                                            : m_colorsBuffer.count() * 6;
+
+    if (m_isDeltaSupported && m_hidDevice != NULL && m_colorsSent.count() == m_colorsBuffer.count())
+    {
+        unsigned changedMask = 0;
+        for (int i = 0; i < m_colorsBuffer.count(); i++)
+        {
+            if (m_colorsBuffer[i].r != m_colorsSent[i].r ||
+                m_colorsBuffer[i].g != m_colorsSent[i].g ||
+                m_colorsBuffer[i].b != m_colorsSent[i].b)
+            {
+                changedMask |= 1 << i;
+            }
+        }
+
+        // Previous frame is still queued and will be replaced by this one,
+        // so this frame also carries the LEDs changed by previous frame
+        if (hid_write_async_pending(m_hidDevice))
+            changedMask |= m_changedMaskSent;
+
+        if (changedMask == 0)
+        {
+            DEBUG_MID_LEVEL << Q_FUNC_INFO << "colors not changed, skip frame";
+            return true;
+        }
+
+        int changedCount = 0;
+        for (unsigned mask = changedMask; mask != 0; mask &= mask - 1)
+            changedCount++;
+
+        // Both frames fill the whole HID report, but delta frame touches only
+        // changed LEDs in device, so use it while it isn't bigger than full one
+        if (UPDATE_LEDS_DELTA_BITMAP_SIZE + changedCount * 6 < fullFrameSize)
+        {
+            m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START] = changedMask & 0xff;
+            m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START + 1] = (changedMask >> 8) & 0xff;
+
+            int buffIndex = WRITE_BUFFER_INDEX_DATA_START + UPDATE_LEDS_DELTA_BITMAP_SIZE;
+            for (int i = 0; i < m_colorsBuffer.count(); i++)
+            {
+                if (changedMask & (1 << i))
+                    buffIndex = writeColorToBuffer(m_colorsBuffer[i], buffIndex);
+            }
+
+            if (!writeBufferToDeviceAsync(CMD_UPDATE_LEDS_DELTA))
+            {
+                m_colorsSent.clear();
+                return false;
+            }
+
+            // Device reopened while writing (colors sent are cleared by open()),
+            // delta could be lost, so send full frame
+            if (!m_colorsSent.isEmpty())
+            {
+                m_colorsSent = m_colorsBuffer;
+                m_changedMaskSent = changedMask;
+                return true;
+            }
+        }
+    }
+
     // First write_buffer[0] == 0x00 - ReportID, i have problems with using it
     // Second byte of usb buffer is command (write_buffer[1] == CMD_UPDATE_LEDS, see below)
-    int buffIndex = WRITE_BUFFER_INDEX_DATA_START;
+    int command = CMD_UPDATE_LEDS;
+
+    if (m_isPackedSupported)
+    {
+        // Two 12-bit channels in 3 bytes instead of 4
+        memset(m_writeBuffer + WRITE_BUFFER_INDEX_DATA_START, 0, sizeof(m_writeBuffer) - WRITE_BUFFER_INDEX_DATA_START);
+        LedFrameEncoder::encodePackedColors(m_colorsBuffer, m_writeBuffer + WRITE_BUFFER_INDEX_DATA_START);
+        command = CMD_UPDATE_LEDS_PACKED;
+    } else {
+        int buffIndex = WRITE_BUFFER_INDEX_DATA_START;
 
-    for (int i = 0; i < m_colorsBuffer.count(); i++)
+        for (int i = 0; i < m_colorsBuffer.count(); i++)
+        {
+            buffIndex = writeColorToBuffer(m_colorsBuffer[i], buffIndex);
+        }
+    }
+
+    bool ok = writeBufferToDeviceAsync(command);
+    if (ok)
     {
-        StructRgb color = m_colorsBuffer[i];
-
-        // Send main 8 bits for compability with existing devices
-        m_writeBuffer[buffIndex++] = (color.r & 0x0FF0) >> 4;
-        m_writeBuffer[buffIndex++] = (color.g & 0x0FF0) >> 4;
-        m_writeBuffer[buffIndex++] = (color.b & 0x0FF0) >> 4;
-
-        // Send over 4 bits for devices revision >= 6
-        // All existing devices ignore it
-        m_writeBuffer[buffIndex++] = (color.r & 0x000F);
-        m_writeBuffer[buffIndex++] = (color.g & 0x000F);
-        m_writeBuffer[buffIndex++] = (color.b & 0x000F);
+        m_colorsSent = m_colorsBuffer;
+        m_changedMaskSent = (1 << m_colorsBuffer.count()) - 1;
+    } else {
+        m_colorsSent.clear();
     }
+    return ok;
+}
 
-    bool ok = writeBufferToDeviceWithCheck(CMD_UPDATE_LEDS);
+int LedDeviceLightpack::writeColorToBuffer(const StructRgb & color, int buffIndex)
+{
+    LedFrameEncoder::encodeColor(color, m_writeBuffer + buffIndex);
 
-    // WARNING: LedDeviceFactory sends data only when the arrival of this signal
-    emit commandCompleted(ok);
+    return buffIndex + LedFrameEncoder::ColorSize;
+}
+
+bool LedDeviceLightpack::writeFrame()
+{
+    // Frame doesn't fit in one report. Reports are written synchronously,
+    // because async writes could replace one part of the frame by another
+    QList<QByteArray> reports = LedFrameEncoder::encodeFrame(m_colorsBuffer, ++m_frameId);
+
+    for (int i = 0; i < reports.count(); i++)
+    {
+        const QByteArray & report = reports[i];
+        memcpy(m_writeBuffer + WRITE_BUFFER_INDEX_COMMAND, report.constData(), report.size());
+
+        if (!writeBufferToDeviceWithCheck(report[0]))
+        {
+            m_colorsSent.clear();
+            return false;
+        }
+    }
+
+    m_colorsSent = m_colorsBuffer;
+    return true;
 }
 
 void LedDeviceLightpack::offLeds()
@@ -110,7 +242,7 @@ void LedDeviceLightpack::offLeds()
 
     if (m_colorsSaved.count() == 0)
     {
-        for (int i = 0; i < MaximumLedsCount; i++)
+        for (int i = 0; i < m_maximumLedsCount; i++)
             m_colorsSaved << 0;
     } else {
         for (int i = 0; i < m_colorsSaved.count(); i++)
@@ -127,10 +259,7 @@ void LedDeviceLightpack::setRefreshDelay(int value)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
 
-    m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START] = value & 0xff;
-    m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START+1] = (value >> 8);
-
-    bool ok = writeBufferToDeviceWithCheck(CMD_SET_TIMER_OPTIONS);
+    bool ok = writeRefreshDelay(value);
     emit commandCompleted(ok);
 }
 
@@ -138,9 +267,7 @@ void LedDeviceLightpack::setColorDepth(int value)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
 
-    m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START] = (unsigned char)value;
-
-    bool ok = writeBufferToDeviceWithCheck(CMD_SET_PWM_LEVEL_MAX_VALUE);
+    bool ok = writeColorDepth(value);
     emit commandCompleted(ok);
 }
 
@@ -148,10 +275,36 @@ void LedDeviceLightpack::setSmoothSlowdown(int value)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
 
+    bool ok = writeSmoothSlowdown(value);
+    emit commandCompleted(ok);
+}
+
+bool LedDeviceLightpack::writeRefreshDelay(int value)
+{
+    m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START] = value & 0xff;
+    m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START+1] = (value >> 8);
+
+    bool ok = writeBufferToDeviceWithCheck(CMD_SET_TIMER_OPTIONS);
+    m_refreshDelay = ok ? value : -1;
+    return ok;
+}
+
+bool LedDeviceLightpack::writeColorDepth(int value)
+{
+    m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START] = (unsigned char)value;
+
+    bool ok = writeBufferToDeviceWithCheck(CMD_SET_PWM_LEVEL_MAX_VALUE);
+    m_colorDepth = ok ? value : -1;
+    return ok;
+}
+
+bool LedDeviceLightpack::writeSmoothSlowdown(int value)
+{
     m_writeBuffer[WRITE_BUFFER_INDEX_DATA_START] = (unsigned char)value;
 
     bool ok = writeBufferToDeviceWithCheck(CMD_SET_SMOOTH_SLOWDOWN);
-    emit commandCompleted(ok);
+    m_smoothSlowdown = ok ? value : -1;
+    return ok;
 }
 
 void LedDeviceLightpack::setGamma(double value)
@@ -192,6 +345,18 @@ void LedDeviceLightpack::requestFirmwareVersion()
         int fw_major = m_readBuffer[INDEX_FW_VER_MAJOR];
         int fw_minor = m_readBuffer[INDEX_FW_VER_MINOR];
         fwVersion = QString::number(fw_major) + "." + QString::number(fw_minor);
+
+        m_isDeltaSupported = isDeltaSupported(fw_major, fw_minor);
+        m_isPackedSupported = isPackedSupported(fw_major, fw_minor);
+
+        if (isFramesSupported(fw_major, fw_minor))
+        {
+            int ledsCount = m_readBuffer[INDEX_LEDS_COUNT_LOW] | (m_readBuffer[INDEX_LEDS_COUNT_HIGH] << 8);
+            if (ledsCount > 0)
+                m_maximumLedsCount = qMin(ledsCount, (int)MaximumNumberOfLeds::AbsoluteMaximum);
+        }
+
+        emit ledsCountReported(m_maximumLedsCount);
     } else {
         fwVersion = QApplication::tr("read device fail");
     }
@@ -206,15 +371,49 @@ void LedDeviceLightpack::updateDeviceSettings()
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
-    setRefreshDelay(Settings::getDeviceRefreshDelay());
-    setColorDepth(Settings::getDeviceColorDepth());
-    setSmoothSlowdown(Settings::getDeviceSmooth());
-    setGamma(Settings::getDeviceGamma());
-    setBrightness(Settings::getDeviceBrightness());
+    m_gammaTable.setLinearLight(Settings::isGrabLinearLightEnabled());
+
+    applySettings(Settings::getDeviceRefreshDelay(), Settings::getDeviceColorDepth(), Settings::getDeviceSmooth(),
+                  Settings::getDeviceGamma(), Settings::getDeviceBrightness());
 
     requestFirmwareVersion();
 }
 
+void LedDeviceLightpack::setSettings(int refreshDelay, int colorDepth, int smoothSlowdown, double gamma, int brightness)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << refreshDelay << colorDepth << smoothSlowdown << gamma << brightness;
+
+    bool ok = applySettings(refreshDelay, colorDepth, smoothSlowdown, gamma, brightness);
+    emit commandCompleted(ok);
+}
+
+bool LedDeviceLightpack::applySettings(int refreshDelay, int colorDepth, int smoothSlowdown, double gamma, int brightness)
+{
+    bool ok = true;
+
+    // Write only options which differ from the values already in device
+    if (refreshDelay != m_refreshDelay)
+        ok = writeRefreshDelay(refreshDelay) && ok;
+
+    if (colorDepth != m_colorDepth)
+        ok = writeColorDepth(colorDepth) && ok;
+
+    if (smoothSlowdown != m_smoothSlowdown)
+        ok = writeSmoothSlowdown(smoothSlowdown) && ok;
+
+    if (gamma != m_gamma || brightness != m_brightness)
+    {
+        m_gamma = gamma;
+        m_brightness = brightness;
+
+        // Show changes of gamma and brightness with one frame
+        if (Settings::isBacklightEnabled())
+            ok = writeColors(m_colorsSaved) && ok;
+    }
+
+    return ok;
+}
+
 
 void LedDeviceLightpack::open()
 {
@@ -241,6 +440,15 @@ void LedDeviceLightpack::open()
     // Immediately return from hid_read() if no data available
     hid_set_nonblocking(m_hidDevice, 1);
 
+    // Device could be reset, so send all options and colors again
+    m_refreshDelay = -1;
+    m_colorDepth = -1;
+    m_smoothSlowdown = -1;
+    m_colorsSent.clear();
+    m_isDeltaSupported = false;
+    m_isPackedSupported = false;
+    m_maximumLedsCount = MaximumLedsCount;
+
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Lightpack opened";
 
     updateDeviceSettings();
@@ -288,6 +496,42 @@ bool LedDeviceLightpack::writeBufferToDevice(int command)
     return true;
 }
 
+bool LedDeviceLightpack::writeBufferToDeviceAsync(int command)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << command;
+
+    if (m_hidDevice == NULL && !tryToReopenDevice())
+        return false;
+
+    m_writeBuffer[WRITE_BUFFER_INDEX_REPORT_ID] = 0x00;
+    m_writeBuffer[WRITE_BUFFER_INDEX_COMMAND] = command;
+
+    // Doesn't wait for USB transfer, newer frame replaces one which is still queued.
+    // Error here means that one of previous frames is failed, so reopen device
+    // and send this frame again.
+    int error = hid_write_async(m_hidDevice, m_writeBuffer, sizeof(m_writeBuffer));
+    if (error < 0)
+    {
+        qWarning() << "Error writing data:" << error;
+
+        // Device options are sent through m_writeBuffer on reopen
+        unsigned char frame[sizeof(m_writeBuffer)];
+        memcpy(frame, m_writeBuffer, sizeof(frame));
+
+        if (!tryToReopenDevice())
+            return false;
+
+        error = hid_write_async(m_hidDevice, frame, sizeof(frame));
+        if (error < 0)
+        {
+            emit ioDeviceSuccess(false);
+            return false;
+        }
+    }
+    emit ioDeviceSuccess(true);
+    return true;
+}
+
 bool LedDeviceLightpack::tryToReopenDevice()
 {
     open();
@@ -355,11 +599,11 @@ void LedDeviceLightpack::resizeColorsBuffer(int buffSize)
 
     m_colorsBuffer.clear();
 
-    if (buffSize > MaximumLedsCount)
+    if (buffSize > m_maximumLedsCount)
     {
-        qCritical() << Q_FUNC_INFO << "buffSize > MaximumLedsCount" << buffSize << ">" << MaximumLedsCount;
+        qCritical() << Q_FUNC_INFO << "buffSize > m_maximumLedsCount" << buffSize << ">" << m_maximumLedsCount;
 
-        buffSize = MaximumLedsCount;
+        buffSize = m_maximumLedsCount;
     }
 
     for (int i = 0; i < buffSize; i++)
@@ -376,11 +620,61 @@ void LedDeviceLightpack::closeDevice()
     m_hidDevice = NULL;
 }
 
+bool LedDeviceLightpack::isDeltaSupported(int fwMajor, int fwMinor)
+{
+    // CMD_UPDATE_LEDS_DELTA added in fw4.5, fw5.2 and fw6.2
+    switch (fwMajor)
+    {
+    case 4:
+        return fwMinor >= 5;
+    case 5:
+    case 6:
+        return fwMinor >= 2;
+    default:
+        return fwMajor > 6;
+    }
+}
+
+bool LedDeviceLightpack::isFramesSupported(int fwMajor, int fwMinor)
+{
+    // CMD_FRAME_DATA and CMD_FRAME_COMMIT added in fw4.6, fw5.3 and fw6.3
+    switch (fwMajor)
+    {
+    case 4:
+        return fwMinor >= 6;
+    case 5:
+    case 6:
+        return fwMinor >= 3;
+    default:
+        return fwMajor > 6;
+    }
+}
+
+bool LedDeviceLightpack::isPackedSupported(int fwMajor, int fwMinor)
+{
+    // CMD_UPDATE_LEDS_PACKED added in fw4.7, fw5.4 and fw6.4
+    switch (fwMajor)
+    {
+    case 4:
+        return fwMinor >= 7;
+    case 5:
+    case 6:
+        return fwMinor >= 4;
+    default:
+        return fwMajor > 6;
+    }
+}
+
 void LedDeviceLightpack::restartPingDevice(bool isSuccess)
 {
     Q_UNUSED(isSuccess);
 
-    if (Settings::isBacklightEnabled() && Settings::isPingDeviceEverySecond())
+    if (m_hidDevice == NULL && m_hotplugMonitor->isAvailable())
+    {
+        // Device will be opened on hotplug event, don't poll it
+        m_timerPingDevice->stop();
+    }
+    else if (Settings::isBacklightEnabled() && Settings::isPingDeviceEverySecond())
     {
         // Start ping device with PingDeviceInterval ms after last data transfer complete
         m_timerPingDevice->start(PingDeviceInterval);
@@ -429,3 +723,25 @@ void LedDeviceLightpack::timerPingDeviceTimeout()
 
     emit ioDeviceSuccess(true);
 }
+
+void LedDeviceLightpack::hotplugDeviceArrived()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    // Arrival is reported for USB device and for its hidraw node
+    if (m_hidDevice != NULL || Settings::isBacklightEnabled() == false)
+        return;
+
+    open();
+}
+
+void LedDeviceLightpack::hotplugDeviceRemoved()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    if (m_hidDevice == NULL)
+        return;
+
+    closeDevice();
+    emit ioDeviceSuccess(false);
+}
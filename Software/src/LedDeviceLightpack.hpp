@@ -31,6 +31,7 @@
 #include "ILedDevice.hpp"
 #include "TimeEvaluations.hpp"
 #include "LightpackMath.hpp"
+#include "UsbHotplugMonitor.hpp"
 
 #include "../../CommonHeaders/USB_ID.h"     /* For device VID, PID, vendor name and product name */
 #include "hidapi.h" /* USB HID API */
@@ -61,19 +62,35 @@ public slots:
     void setBrightness(int percent);
     void requestFirmwareVersion();
     void updateDeviceSettings();
+    void setSettings(int refreshDelay, int colorDepth, int smoothSlowdown, double gamma, int brightness);
+
+public:
+    static bool isDeltaSupported(int fwMajor, int fwMinor);
+    static bool isFramesSupported(int fwMajor, int fwMinor);
+    static bool isPackedSupported(int fwMajor, int fwMinor);
 
 private: 
+    bool writeColors(const QList<QRgb> & colors);
+    int writeColorToBuffer(const StructRgb & color, int buffIndex);
+    bool writeFrame();
+    bool writeRefreshDelay(int value);
+    bool writeColorDepth(int value);
+    bool writeSmoothSlowdown(int value);
+    bool applySettings(int refreshDelay, int colorDepth, int smoothSlowdown, double gamma, int brightness);
     bool readDataFromDevice();
     bool writeBufferToDevice(int command);
     bool tryToReopenDevice();
     bool readDataFromDeviceWithCheck();
     bool writeBufferToDeviceWithCheck(int command);    
+    bool writeBufferToDeviceAsync(int command);
     void resizeColorsBuffer(int buffSize);
     void closeDevice();
 
 private slots:
     void restartPingDevice(bool isSuccess);
     void timerPingDeviceTimeout();
+    void hotplugDeviceArrived();
+    void hotplugDeviceRemoved();
 
 private:
     hid_device *m_hidDevice;
@@ -82,13 +99,30 @@ private:
     unsigned char m_writeBuffer[65];   /* 0-ReportID, 1..65-data */
 
     double m_gamma;
+    GammaTable m_gammaTable;
     int m_brightness;    
 
+    // Last values written to device, -1 if unknown
+    int m_refreshDelay;
+    int m_colorDepth;
+    int m_smoothSlowdown;
+
     QList<QRgb> m_colorsSaved;
     QList<StructRgb> m_colorsBuffer;
 
+    // Colors in device after last CMD_UPDATE_LEDS(_DELTA), empty if unknown
+    QList<StructRgb> m_colorsSent;
+    unsigned m_changedMaskSent;
+    bool m_isDeltaSupported;
+    bool m_isPackedSupported;
+
+    // LEDs count reported by device which supports multi-report frames
+    int m_maximumLedsCount;
+    quint8 m_frameId;
+
     QTimer *m_timerPingDevice;
+    UsbHotplugMonitor *m_hotplugMonitor;
 
     static const int PingDeviceInterval;
-    static const int MaximumLedsCount;
+    static const int MaximumLedsCount; // in one CMD_UPDATE_LEDS report
 };
@@ -0,0 +1,174 @@
+/*
+ * LedDeviceSerial.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedDeviceSerial.hpp"
+#include "Settings.hpp"
+#include "debug.h"
+
+#include <QFileInfo>
+
+using namespace SettingsScope;
+
+LedDeviceSerial::LedDeviceSerial(const QString & deviceName, int maximumLedsCount, int colorDepth,
+                                 const QString & portName, const QString & baudRate, QObject * parent)
+    : AbstractLedDevice(deviceName, maximumLedsCount, colorDepth, parent)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << deviceName << portName << baudRate;
+
+    m_portName = portName;
+    m_baudRate = baudRate;
+
+    m_serialDevice = NULL;
+    m_frameWriter = new SerialFrameWriter(this);
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "initialized";
+}
+
+LedDeviceSerial::~LedDeviceSerial()
+{
+    closeDevice();
+}
+
+void LedDeviceSerial::open()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << deviceName();
+
+    readCorrectionSettings();
+
+    QString portName = this->portName();
+    QString baudRate = m_baudRate.isEmpty() ? Settings::getSerialPortBaudRate() : m_baudRate;
+
+    closeDevice();
+
+    m_serialDevice = new AbstractSerial();
+
+    m_serialDevice->setDeviceName(portName);
+
+    bool ok = m_serialDevice->open(AbstractSerial::WriteOnly | AbstractSerial::Unbuffered);
+
+    // Ubuntu 10.04: on every second attempt to open the device leads to failure
+    if (ok == false)
+    {
+        // Try one more time
+        ok = m_serialDevice->open(AbstractSerial::WriteOnly | AbstractSerial::Unbuffered);
+    }
+
+    if (ok)
+    {
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Serial device" << m_serialDevice->deviceName() << "open";
+
+        ok = m_serialDevice->setBaudRate(baudRate);
+        if (ok)
+        {
+            ok = m_serialDevice->setDataBits(AbstractSerial::DataBits8);
+            if (ok)
+            {
+                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Baud rate  :" << m_serialDevice->baudRate();
+                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Data bits  :" << m_serialDevice->dataBits();
+                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Parity     :" << m_serialDevice->parity();
+                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Stop bits  :" << m_serialDevice->stopBits();
+                DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Flow       :" << m_serialDevice->flowControl();
+            } else {
+                qWarning() << Q_FUNC_INFO << "Set data bits 8 fail";
+            }
+        } else {
+            qWarning() << Q_FUNC_INFO << "Set baud rate" << baudRate << "fail";
+        }
+
+    } else {
+        qWarning() << Q_FUNC_INFO << "Serial device" << m_serialDevice->deviceName() << "open fail";
+    }
+
+    if (ok)
+    {
+        m_frameWriter->setDevice(m_serialDevice);
+        m_portNode = QFileInfo(portName).canonicalFilePath();
+    }
+
+    emit openDeviceSuccess(ok);
+}
+
+void LedDeviceSerial::serialDeviceAdded(const QString & deviceName)
+{
+    if (isPortDevice(deviceName) == false)
+        return;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << deviceName;
+
+    if (m_serialDevice != NULL && m_serialDevice->isOpen())
+        return;
+
+    open();
+}
+
+void LedDeviceSerial::serialDeviceRemoved(const QString & deviceName)
+{
+    if (m_serialDevice == NULL || isPortDevice(deviceName) == false)
+        return;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << deviceName;
+
+    closeDevice();
+    emit ioDeviceSuccess(false);
+}
+
+QString LedDeviceSerial::portName() const
+{
+    return m_portName.isEmpty() ? Settings::getSerialPortName() : m_portName;
+}
+
+bool LedDeviceSerial::isPortDevice(const QString & deviceName) const
+{
+    QString portName = this->portName();
+
+    // Symlink like /dev/serial/by-id/... exists only while device is plugged
+    return deviceName == portName || deviceName == m_portNode
+            || deviceName == QFileInfo(portName).canonicalFilePath();
+}
+
+void LedDeviceSerial::closeDevice()
+{
+    m_frameWriter->setDevice(NULL);
+    m_portNode.clear();
+
+    if (m_serialDevice != NULL)
+        m_serialDevice->close();
+
+    delete m_serialDevice;
+    m_serialDevice = NULL;
+}
+
+bool LedDeviceSerial::writeColors(const QList<StructRgb> & colors)
+{
+    encodeFrame(colors, m_writeBuffer);
+
+    // Doesn't block device thread, stale frames are dropped if the line is busy
+    bool ok = m_frameWriter->writeFrame(m_writeBuffer);
+
+    if (ok == false)
+        qWarning() << Q_FUNC_INFO << "Write to serial device fail";
+
+    return ok;
+}
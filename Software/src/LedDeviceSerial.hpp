@@ -0,0 +1,74 @@
+/*
+ * LedDeviceSerial.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "AbstractLedDevice.hpp"
+#include "abstractserial.h"
+#include "SerialFrameWriter.hpp"
+
+// Serial port common for strips connected to serial port (Adalight,
+// Ardulight). Protocol of strip is encodeFrame().
+class LedDeviceSerial : public AbstractLedDevice
+{
+    Q_OBJECT
+public:
+    // Empty port name and baud rate mean using of connected device settings,
+    // colorDepth is ColorDepth of SerialFrameEncoder used by encodeFrame()
+    LedDeviceSerial(const QString & deviceName, int maximumLedsCount, int colorDepth,
+                    const QString & portName, const QString & baudRate, QObject * parent);
+    ~LedDeviceSerial();
+
+public slots:
+    void open();
+
+    // Connected to SerialDeviceEnumerator by LedDeviceFactory: port is reopened
+    // right after udev reports that it is plugged again
+    void serialDeviceAdded(const QString & deviceName);
+    void serialDeviceRemoved(const QString & deviceName);
+
+protected:
+    // Writes whole frame of gamma corrected colors to 'frame', resizing it if needed
+    virtual void encodeFrame(const QList<StructRgb> & colors, QByteArray & frame) = 0;
+
+    bool writeColors(const QList<StructRgb> & colors);
+
+private:
+    QString portName() const;
+    bool isPortDevice(const QString & deviceName) const;
+    void closeDevice();
+
+private:
+    AbstractSerial *m_serialDevice;
+    SerialFrameWriter *m_frameWriter;
+
+    // Device node of opened port, port name can be a symlink to it
+    QString m_portNode;
+
+    QString m_portName;
+    QString m_baudRate;
+
+    QByteArray m_writeBuffer;
+};
@@ -0,0 +1,143 @@
+/*
+ * LedDeviceUdp.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedDeviceUdp.hpp"
+#include "LightpackMath.hpp"
+#include "SerialFrameEncoder.hpp"
+#include "Settings.hpp"
+#include "debug.h"
+
+using namespace SettingsScope;
+
+typedef SerialFrameEncoder<NoHeader, ColorOrderRgb, 8> UdpColorEncoder;
+
+const int LedDeviceUdp::DrgbMaximumLeds = 490;
+const int LedDeviceUdp::DnrgbMaximumLeds = 489;
+const int LedDeviceUdp::RealtimeTimeout = 255;
+
+static const int DrgbHeaderSize = 2;
+static const int DnrgbHeaderSize = 4;
+
+LedDeviceUdp::LedDeviceUdp(const QString & host, const QString & port, QObject * parent)
+    : AbstractLedDevice("UDP", MaximumNumberOfLeds::Udp, UdpColorEncoder::ColorDepth, parent)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << host << port;
+
+    m_host = host;
+    m_port = port;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "initialized";
+}
+
+LedDeviceUdp::~LedDeviceUdp()
+{
+    m_sender.close();
+}
+
+int LedDeviceUdp::encodeFrame(const QList<StructRgb> & colors, UdpPacketSender & sender)
+{
+    int ledsCount = colors.count();
+
+    if (ledsCount <= DrgbMaximumLeds)
+    {
+        int size = DrgbHeaderSize + ledsCount * UdpColorEncoder::ColorSize;
+        sender.reserve(1, size);
+
+        char *packet = sender.packetData(0);
+        packet[0] = ProtocolDrgb;
+        packet[1] = (char)RealtimeTimeout;
+
+        UdpColorEncoder::encodeFrame(colors, packet + DrgbHeaderSize);
+        sender.setPacketSize(0, size);
+
+        return 1;
+    }
+
+    int packetsCount = (ledsCount + DnrgbMaximumLeds - 1) / DnrgbMaximumLeds;
+    sender.reserve(packetsCount, DnrgbHeaderSize + DnrgbMaximumLeds * UdpColorEncoder::ColorSize);
+
+    for (int i = 0; i < packetsCount; i++)
+    {
+        int startIndex = i * DnrgbMaximumLeds;
+        int count = qMin(DnrgbMaximumLeds, ledsCount - startIndex);
+
+        char *packet = sender.packetData(i);
+        packet[0] = ProtocolDnrgb;
+        packet[1] = (char)RealtimeTimeout;
+        packet[2] = (char)((startIndex >> 8) & 0xff);
+        packet[3] = (char)(startIndex & 0xff);
+
+        char *buffer = packet + DnrgbHeaderSize;
+        for (int led = startIndex; led < startIndex + count; led++)
+        {
+            UdpColorEncoder::encodeColor(colors[led], buffer);
+            buffer += UdpColorEncoder::ColorSize;
+        }
+
+        sender.setPacketSize(i, DnrgbHeaderSize + count * UdpColorEncoder::ColorSize);
+    }
+
+    return packetsCount;
+}
+
+bool LedDeviceUdp::writeColors(const QList<StructRgb> & colors)
+{
+    int packetsCount = encodeFrame(colors, m_sender);
+
+    // Lost datagrams are not an error for realtime protocol
+    bool ok = m_sender.send(packetsCount) >= 0;
+
+    if (ok == false)
+        qWarning() << Q_FUNC_INFO << "Send frame fail";
+
+    return ok;
+}
+
+void LedDeviceUdp::open()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+    readCorrectionSettings();
+
+    QString host = m_host.isEmpty() ? Settings::getUdpHost() : m_host;
+    QString portString = m_port.isEmpty() ? QString::number(Settings::getUdpPort()) : m_port;
+
+    bool ok = false;
+    int port = portString.toInt(&ok);
+
+    if (ok == false || port <= 0 || port > 0xffff)
+    {
+        qWarning() << Q_FUNC_INFO << "Invalid UDP port:" << portString;
+        emit openDeviceSuccess(false);
+        return;
+    }
+
+    ok = m_sender.open(host, port);
+
+    if (ok == false)
+        qWarning() << Q_FUNC_INFO << "UDP device" << host << port << "open fail";
+
+    emit openDeviceSuccess(ok);
+}
@@ -0,0 +1,67 @@
+/*
+ * LedDeviceUdp.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "AbstractLedDevice.hpp"
+#include "UdpPacketSender.hpp"
+
+// Network strip controllers (ESP8266/ESP32 with WLED and compatible firmware)
+// driven by UDP realtime protocol: DRGB for up to 490 LEDs in one packet,
+// DNRGB with start index for longer strips.
+class LedDeviceUdp : public AbstractLedDevice
+{
+    Q_OBJECT
+public:
+    // Empty host and port mean using of connected device settings
+    LedDeviceUdp(const QString & host = QString(), const QString & port = QString(), QObject * parent = 0);
+    ~LedDeviceUdp();
+
+    enum Protocol
+    {
+        ProtocolDrgb  = 2,
+        ProtocolDnrgb = 4
+    };
+
+    static const int DrgbMaximumLeds;
+    static const int DnrgbMaximumLeds;
+    // Seconds before controller returns to its own effects, 255 - never
+    static const int RealtimeTimeout;
+
+    // Packets are written to sender, returns packets count
+    static int encodeFrame(const QList<StructRgb> & colors, UdpPacketSender & sender);
+
+public slots:
+    void open();
+
+protected:
+    bool writeColors(const QList<StructRgb> & colors);
+
+private:
+    UdpPacketSender m_sender;
+
+    QString m_host;
+    QString m_port;
+};
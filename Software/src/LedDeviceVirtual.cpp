@@ -38,17 +38,19 @@ LedDeviceVirtual::LedDeviceVirtual(QObject * parent) : ILedDevice(parent)
 
     m_gamma = Settings::getDeviceGamma();
     m_brightness = Settings::getDeviceBrightness();
+
+    m_colorsSaved.reserve(MaximumNumberOfLeds::Virtual);
 }
 
 void LedDeviceVirtual::setColors(const QList<QRgb> & colors)
 {
-    m_colorsSaved = colors;
+    LedFrameMailbox::copyColors(colors, m_colorsSaved);
 
     QList<QRgb> callbackColors;
 
-    resizeColorsBuffer(colors.count());
+    resizeColorsBuffer(m_colorsSaved.count());
 
-    LightpackMath::gammaCorrection(m_gamma, colors, m_colorsBuffer);
+    m_gammaTable.gammaCorrection(m_gamma, m_colorsSaved, m_colorsBuffer);
     LightpackMath::brightnessCorrection(m_brightness, m_colorsBuffer);
 
     for (int i = 0; i < m_colorsBuffer.count(); i++)
@@ -62,11 +64,8 @@ void LedDeviceVirtual::setColors(const QList<QRgb> & colors)
 
 void LedDeviceVirtual::offLeds()
 {
-    int count = m_colorsSaved.count();
-    m_colorsSaved.clear();
-
-    for (int i = 0; i < count; i++)
-        m_colorsSaved << 0;
+    for (int i = 0; i < m_colorsSaved.count(); i++)
+        m_colorsSaved[i] = 0;
 
     setColors(m_colorsSaved);
 }
@@ -112,8 +111,25 @@ void LedDeviceVirtual::updateDeviceSettings()
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
-    setGamma(Settings::getDeviceGamma());
-    setBrightness(Settings::getDeviceBrightness());
+    setSettings(Settings::getDeviceRefreshDelay(), Settings::getDeviceColorDepth(), Settings::getDeviceSmooth(),
+                Settings::getDeviceGamma(), Settings::getDeviceBrightness());
+}
+
+void LedDeviceVirtual::setSettings(int /*refreshDelay*/, int /*colorDepth*/, int /*smoothSlowdown*/, double gamma, int brightness)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << gamma << brightness;
+
+    if (gamma == m_gamma && brightness == m_brightness)
+    {
+        emit commandCompleted(true);
+        return;
+    }
+
+    m_gamma = gamma;
+    m_brightness = brightness;
+
+    // One frame for both changes
+    setColors(m_colorsSaved);
 }
 
 void LedDeviceVirtual::open()
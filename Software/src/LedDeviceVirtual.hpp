@@ -28,6 +28,7 @@
 
 #include "ILedDevice.hpp"
 #include "StructRgb.hpp"
+#include "LightpackMath.hpp"
 
 class LedDeviceVirtual : public ILedDevice
 {
@@ -46,12 +47,14 @@ public slots:
     void setBrightness(int value);
     void requestFirmwareVersion();
     void updateDeviceSettings();
+    void setSettings(int /*refreshDelay*/, int /*colorDepth*/, int /*smoothSlowdown*/, double gamma, int brightness);
 
 private:
     void resizeColorsBuffer(int buffSize);
 
 private:
     double m_gamma;
+    GammaTable m_gammaTable;
     int m_brightness;
 
     QList<QRgb> m_colorsSaved;
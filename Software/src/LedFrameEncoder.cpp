@@ -0,0 +1,102 @@
+/*
+ * LedFrameEncoder.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedFrameEncoder.hpp"
+
+#include "../../CommonHeaders/COMMANDS.h"
+
+const int LedFrameEncoder::ReportSize = 64;
+const int LedFrameEncoder::ColorSize = 6;
+
+QList<QByteArray> LedFrameEncoder::encodeFrame(const QList<StructRgb> & colors, quint8 frameId)
+{
+    QList<QByteArray> reports;
+
+    for (int offset = 0; offset < colors.count(); offset += FRAME_DATA_MAX_LEDS)
+    {
+        int count = qMin((int)FRAME_DATA_MAX_LEDS, colors.count() - offset);
+
+        QByteArray report(ReportSize, 0);
+        unsigned char * data = (unsigned char *)report.data();
+
+        data[0] = CMD_FRAME_DATA;
+        data[1] = frameId;
+        data[2] = offset & 0xff;
+        data[3] = (offset >> 8) & 0xff;
+        data[4] = count;
+
+        for (int i = 0; i < count; i++)
+            encodeColor(colors[offset + i], data + 1 + FRAME_DATA_HEADER_SIZE + i * ColorSize);
+
+        reports << report;
+    }
+
+    QByteArray commit(ReportSize, 0);
+    commit[0] = CMD_FRAME_COMMIT;
+    commit[1] = frameId;
+    commit[2] = colors.count() & 0xff;
+    commit[3] = (colors.count() >> 8) & 0xff;
+
+    reports << commit;
+
+    return reports;
+}
+
+void LedFrameEncoder::encodeColor(const StructRgb & color, unsigned char * buffer)
+{
+    // Send main 8 bits for compability with existing devices
+    buffer[0] = (color.r & 0x0FF0) >> 4;
+    buffer[1] = (color.g & 0x0FF0) >> 4;
+    buffer[2] = (color.b & 0x0FF0) >> 4;
+
+    // Send over 4 bits for devices revision >= 6
+    // All existing devices ignore it
+    buffer[3] = (color.r & 0x000F);
+    buffer[4] = (color.g & 0x000F);
+    buffer[5] = (color.b & 0x000F);
+}
+
+void LedFrameEncoder::encodePackedColors(const QList<StructRgb> & colors, unsigned char * buffer)
+{
+    for (int i = 0; i < colors.count(); i++)
+    {
+        const unsigned channels[] = { colors[i].r & 0x0FFF, colors[i].g & 0x0FFF, colors[i].b & 0x0FFF };
+
+        for (int c = 0; c < 3; c++)
+        {
+            int channel = i * 3 + c;
+            unsigned char * bytes = buffer + (channel / 2) * 3;
+
+            if (channel & 1)
+            {
+                bytes[1] |= channels[c] >> 8;
+                bytes[2] = channels[c] & 0xFF;
+            } else {
+                bytes[0] = channels[c] >> 4;
+                bytes[1] |= (channels[c] & 0x0F) << 4;
+            }
+        }
+    }
+}
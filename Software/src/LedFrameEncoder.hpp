@@ -0,0 +1,51 @@
+/*
+ * LedFrameEncoder.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QList>
+#include <QByteArray>
+
+#include "StructRgb.hpp"
+
+// Splits frame of 12-bit colors into Lightpack reports: CMD_FRAME_DATA
+// reports with up to FRAME_DATA_MAX_LEDS colors each and CMD_FRAME_COMMIT
+// at the end. Each report is GENERIC_REPORT_SIZE bytes, command first,
+// without report ID.
+class LedFrameEncoder
+{
+public:
+    static const int ReportSize;
+    static const int ColorSize;
+
+    static QList<QByteArray> encodeFrame(const QList<StructRgb> & colors, quint8 frameId);
+
+    // 8 high bits of each channel, then 4 low bits (ignored by hw < 6)
+    static void encodeColor(const StructRgb & color, unsigned char * buffer);
+
+    // CMD_UPDATE_LEDS_PACKED data, two 12-bit channels in 3 bytes, buffer
+    // must be zeroed and hold UPDATE_LEDS_PACKED_SIZE(colors.count()) bytes
+    static void encodePackedColors(const QList<StructRgb> & colors, unsigned char * buffer);
+};
@@ -0,0 +1,205 @@
+/*
+ * LedFrameLog.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedFrameLog.hpp"
+#include "debug.h"
+
+#include <QtEndian>
+#include <string.h>
+
+using namespace LedFrameLog;
+
+LedFrameLogWriter::LedFrameLogWriter()
+{
+    m_lastFrameNsec = 0;
+    m_framesCount = 0;
+}
+
+LedFrameLogWriter::~LedFrameLogWriter()
+{
+    close();
+}
+
+bool LedFrameLogWriter::open(const QString & fileName)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << fileName;
+
+    close();
+
+    m_file.setFileName(fileName);
+    if (m_file.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+    {
+        qWarning() << Q_FUNC_INFO << "Can't open" << fileName << ":" << m_file.errorString();
+        return false;
+    }
+
+    char header[HeaderSize];
+    memcpy(header, Magic, MagicSize);
+    qToBigEndian<quint16>(Version, (uchar *)header + MagicSize);
+    m_file.write(header, HeaderSize);
+
+    m_framesCount = 0;
+    m_lastFrameNsec = 0;
+    m_timer.start();
+
+    return true;
+}
+
+void LedFrameLogWriter::close()
+{
+    if (m_file.isOpen() == false)
+        return;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_file.fileName() << "frames:" << m_framesCount;
+
+    m_file.close();
+}
+
+void LedFrameLogWriter::write(const QList<QRgb> & colors)
+{
+    if (m_file.isOpen() == false)
+        return;
+
+    qint64 nsec = m_timer.nsecsElapsed();
+    // The first frame starts the log
+    qint64 deltaUsec = (m_framesCount == 0) ? 0 : (nsec - m_lastFrameNsec) / 1000;
+    m_lastFrameNsec = nsec;
+
+    int ledsCount = qMin(colors.count(), 0xffff);
+    int size = FrameHeaderSize + ledsCount * 3;
+
+    if (m_buffer.size() != size)
+        m_buffer.resize(size);
+
+    uchar *data = (uchar *)m_buffer.data();
+
+    qToBigEndian<quint32>(qMin(deltaUsec, (qint64)0xffffffff), data);
+    qToBigEndian<quint16>(ledsCount, data + 4);
+    data += FrameHeaderSize;
+
+    for (int i = 0; i < ledsCount; i++)
+    {
+        *data++ = qRed(colors[i]);
+        *data++ = qGreen(colors[i]);
+        *data++ = qBlue(colors[i]);
+    }
+
+    if (m_file.write(m_buffer) != m_buffer.size())
+    {
+        qWarning() << Q_FUNC_INFO << "Write to" << m_file.fileName() << "fail:" << m_file.errorString() << ", recording stopped";
+        m_file.close();
+        return;
+    }
+
+    m_framesCount++;
+}
+
+LedFrameLogReader::LedFrameLogReader()
+{
+    m_timeUsec = 0;
+    m_framesCount = 0;
+}
+
+bool LedFrameLogReader::open(const QString & fileName)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << fileName;
+
+    close();
+
+    m_file.setFileName(fileName);
+    if (m_file.open(QIODevice::ReadOnly) == false)
+    {
+        qWarning() << Q_FUNC_INFO << "Can't open" << fileName << ":" << m_file.errorString();
+        return false;
+    }
+
+    QByteArray header = m_file.read(HeaderSize);
+    if (header.size() != HeaderSize || memcmp(header.constData(), Magic, MagicSize) != 0)
+    {
+        qWarning() << Q_FUNC_INFO << fileName << "isn't a frames log";
+        m_file.close();
+        return false;
+    }
+
+    int version = qFromBigEndian<quint16>((const uchar *)header.constData() + MagicSize);
+    if (version != Version)
+    {
+        qWarning() << Q_FUNC_INFO << fileName << "has unsupported version" << version;
+        m_file.close();
+        return false;
+    }
+
+    m_timeUsec = 0;
+    m_framesCount = 0;
+
+    return true;
+}
+
+void LedFrameLogReader::close()
+{
+    m_file.close();
+}
+
+bool LedFrameLogReader::readFrame(QList<QRgb> & colors, qint64 & timeUsec)
+{
+    if (m_file.isOpen() == false)
+        return false;
+
+    uchar header[FrameHeaderSize];
+    if (m_file.read((char *)header, FrameHeaderSize) != FrameHeaderSize)
+        return false;
+
+    qint64 deltaUsec = qFromBigEndian<quint32>(header);
+    int ledsCount = qFromBigEndian<quint16>(header + 4);
+
+    if (m_buffer.size() != ledsCount * 3)
+        m_buffer.resize(ledsCount * 3);
+
+    if (m_file.read(m_buffer.data(), m_buffer.size()) != m_buffer.size())
+    {
+        // Application was killed while recording
+        qWarning() << Q_FUNC_INFO << m_file.fileName() << "is truncated after" << m_framesCount << "frames";
+        return false;
+    }
+
+    const uchar *data = (const uchar *)m_buffer.constData();
+
+    // Reuse colors list if LEDs count isn't changed
+    if (colors.count() != ledsCount)
+    {
+        colors.clear();
+        for (int i = 0; i < ledsCount; i++)
+            colors << 0;
+    }
+
+    for (int i = 0; i < ledsCount; i++, data += 3)
+        colors[i] = qRgb(data[0], data[1], data[2]);
+
+    m_timeUsec += deltaUsec;
+    timeUsec = m_timeUsec;
+    m_framesCount++;
+
+    return true;
+}
@@ -0,0 +1,96 @@
+/*
+ * LedFrameLog.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QRgb>
+#include <QFile>
+#include <QElapsedTimer>
+
+//
+// Binary log of frames sent to LED device, for reproducing of field issues
+// without the screen they were grabbed from and for benchmarks of device layer.
+// Numbers are big-endian:
+//
+//   header: "LPFL", quint16 version
+//   frame:  quint32 microseconds since previous frame, quint16 LEDs count,
+//           LEDs count * 3 bytes of RGB
+//
+namespace LedFrameLog
+{
+    static const char Magic[] = "LPFL";
+    static const int MagicSize = 4;
+    static const int Version = 1;
+    static const int HeaderSize = MagicSize + 2;
+    static const int FrameHeaderSize = 4 + 2;
+}
+
+// Writes frames with monotonic time of their arrival. File is buffered,
+// so write() doesn't wait for disk and can be called in device thread.
+class LedFrameLogWriter
+{
+public:
+    LedFrameLogWriter();
+    ~LedFrameLogWriter();
+
+    bool open(const QString & fileName);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void write(const QList<QRgb> & colors);
+
+    int framesCount() const { return m_framesCount; }
+
+private:
+    QFile m_file;
+    QElapsedTimer m_timer;
+    qint64 m_lastFrameNsec;
+    QByteArray m_buffer; // reused for every frame
+    int m_framesCount;
+};
+
+class LedFrameLogReader
+{
+public:
+    LedFrameLogReader();
+
+    bool open(const QString & fileName);
+    void close();
+
+    // Returns false at the end of log or if the rest of file is broken.
+    // Time is in microseconds since the first frame.
+    bool readFrame(QList<QRgb> & colors, qint64 & timeUsec);
+
+    int framesCount() const { return m_framesCount; }
+
+private:
+    QFile m_file;
+    QByteArray m_buffer;
+    qint64 m_timeUsec;
+    int m_framesCount;
+};
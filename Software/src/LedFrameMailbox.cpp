@@ -0,0 +1,80 @@
+/*
+ * LedFrameMailbox.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedFrameMailbox.hpp"
+#include "enums.hpp"
+
+LedFrameMailbox::LedFrameMailbox()
+    : m_back(0), m_front(1), m_middle(2), m_countPublished(0), m_countOverwritten(0)
+{
+    for (int i = 0; i < SlotsCount; i++)
+        m_slots[i].reserve(MaximumNumberOfLeds::AbsoluteMaximum);
+}
+
+void LedFrameMailbox::publish(const QList<QRgb> & colors, int first, int count)
+{
+    copyColors(colors, m_slots[m_back], first, count);
+
+    int prev = m_middle.fetchAndStoreOrdered(m_back | FreshBit);
+
+    if (prev & FreshBit)
+        m_countOverwritten.ref();
+
+    m_back = prev & IndexMask;
+    m_countPublished++;
+}
+
+void LedFrameMailbox::copyColors(const QList<QRgb> & from, QList<QRgb> & to, int first, int count)
+{
+    int size = from.size() - first;
+
+    if (count >= 0 && count < size)
+        size = count;
+
+    if (size < 0)
+        size = 0;
+
+    while (to.size() > size)
+        to.removeLast();
+
+    while (to.size() < size)
+        to.append(0);
+
+    for (int i = 0; i < size; i++)
+        to[i] = from[first + i];
+}
+
+bool LedFrameMailbox::takeLatest()
+{
+    // Only producer sets FreshBit, so it can't be cleared between check and exchange
+    if (((int)m_middle & FreshBit) == 0)
+        return false;
+
+    int prev = m_middle.fetchAndStoreOrdered(m_front);
+
+    m_front = prev & IndexMask;
+
+    return true;
+}
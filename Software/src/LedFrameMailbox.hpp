@@ -0,0 +1,77 @@
+/*
+ * LedFrameMailbox.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QList>
+#include <QRgb>
+#include <QAtomicInt>
+
+//
+// Single producer, single consumer mailbox which keeps only the latest frame
+// of LEDs colors (triple buffer). Producer owns the back slot and consumer
+// owns the front one, the middle slot is exchanged atomically with them,
+// so neither side blocks or waits for another. Frame published before the
+// consumer took previous one replaces it and counted as overwritten.
+//
+// Slots are preallocated for maximum number of LEDs and reused, colors are
+// copied in place.
+//
+class LedFrameMailbox
+{
+public:
+    LedFrameMailbox();
+
+    // Producer side, copies colors [first, first + count) or up to the end if count < 0
+    void publish(const QList<QRgb> & colors, int first = 0, int count = -1);
+
+    // Consumer side, returns false if no new frame since last call;
+    // frame is valid until next call of takeLatest(). Don't keep a copy of
+    // latest(), it shares the slot and producer would reallocate it on next
+    // write, use copyColors() to own preallocated list instead.
+    bool takeLatest();
+    const QList<QRgb> & latest() const { return m_slots[m_front]; }
+
+    // Copies colors [first, first + count) or up to the end if count < 0 in
+    // place, 'to' is resized but not reallocated while it has capacity
+    static void copyColors(const QList<QRgb> & from, QList<QRgb> & to, int first = 0, int count = -1);
+
+    unsigned countPublished() const { return m_countPublished; }
+    unsigned countOverwritten() const { return (int)m_countOverwritten; }
+
+private:
+    static const int SlotsCount = 3;
+    static const int IndexMask = 0x3;
+    static const int FreshBit = 0x4;
+
+    QList<QRgb> m_slots[SlotsCount];
+
+    int m_back;   // written only by producer
+    int m_front;  // read only by consumer
+    QAtomicInt m_middle; // index of middle slot | FreshBit if it has new frame
+
+    unsigned m_countPublished;
+    QAtomicInt m_countOverwritten;
+};
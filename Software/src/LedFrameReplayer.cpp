@@ -0,0 +1,134 @@
+/*
+ * LedFrameReplayer.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedFrameReplayer.hpp"
+#include "debug.h"
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+
+LedFrameReplayer::LedFrameReplayer(ILedDevice * device, QObject * parent)
+    : QObject(parent)
+{
+    m_device = device;
+    m_outputLog = NULL;
+
+    m_framesCount = 0;
+    m_failedFramesCount = 0;
+    m_lateFramesCount = 0;
+    m_elapsedUsec = 0;
+    m_deviceUsec = 0;
+    m_maximumFrameUsec = 0;
+
+    if (m_device != NULL)
+    {
+        connect(m_device, SIGNAL(commandCompleted(bool)), this, SLOT(commandCompleted(bool)), Qt::DirectConnection);
+        connect(m_device, SIGNAL(setColors_VirtualDeviceCallback(QList<QRgb>)),
+                this, SLOT(virtualDeviceColors(QList<QRgb>)), Qt::DirectConnection);
+    }
+}
+
+bool LedFrameReplayer::replay(const QString & fileName, Speed speed)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << fileName << speed;
+
+    LedFrameLogReader reader;
+    if (reader.open(fileName) == false)
+        return false;
+
+    m_framesCount = 0;
+    m_failedFramesCount = 0;
+    m_lateFramesCount = 0;
+    m_deviceUsec = 0;
+    m_maximumFrameUsec = 0;
+
+    QList<QRgb> colors;
+    qint64 timeUsec = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (reader.readFrame(colors, timeUsec))
+    {
+        if (speed == RealTime)
+        {
+            waitUntil(timer, timeUsec);
+
+            if (timer.nsecsElapsed() / 1000 - timeUsec > 1000)
+                m_lateFramesCount++;
+        } else {
+            // Serial and network devices finish writing from event loop
+            QCoreApplication::processEvents();
+        }
+
+        if (m_device != NULL)
+        {
+            qint64 startNsec = timer.nsecsElapsed();
+
+            m_device->setColors(colors);
+
+            qint64 frameUsec = (timer.nsecsElapsed() - startNsec) / 1000;
+            m_deviceUsec += frameUsec;
+            m_maximumFrameUsec = qMax(m_maximumFrameUsec, frameUsec);
+        }
+
+        m_framesCount++;
+    }
+
+    m_elapsedUsec = timer.nsecsElapsed() / 1000;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "frames:" << m_framesCount << "failed:" << m_failedFramesCount
+                    << "late:" << m_lateFramesCount << "elapsed:" << m_elapsedUsec << "us"
+                    << "in device:" << m_deviceUsec << "us";
+
+    return true;
+}
+
+void LedFrameReplayer::waitUntil(const QElapsedTimer & timer, qint64 timeUsec)
+{
+    int msec = (timeUsec - timer.nsecsElapsed() / 1000) / 1000;
+
+    if (msec > 0)
+    {
+        QEventLoop loop;
+        QTimer::singleShot(msec, &loop, SLOT(quit()));
+        loop.exec();
+    } else {
+        QCoreApplication::processEvents();
+    }
+}
+
+void LedFrameReplayer::commandCompleted(bool ok)
+{
+    if (ok == false)
+        m_failedFramesCount++;
+}
+
+void LedFrameReplayer::virtualDeviceColors(const QList<QRgb> & colors)
+{
+    if (m_outputLog != NULL)
+        m_outputLog->write(colors);
+}
@@ -0,0 +1,80 @@
+/*
+ * LedFrameReplayer.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include "ILedDevice.hpp"
+#include "LedFrameLog.hpp"
+
+// Pushes frames from LedFrameLog through LED device in the current thread.
+// Device must not be moved to another thread, NULL device is null sink,
+// which only reads frames, it gives the cost of replaying itself.
+class LedFrameReplayer : public QObject
+{
+    Q_OBJECT
+public:
+    enum Speed
+    {
+        RealTime,       // frames are sent with recorded intervals
+        MaximumSpeed    // next frame is sent right after the previous one
+    };
+
+    LedFrameReplayer(ILedDevice * device, QObject * parent = 0);
+
+    // Frames produced by LedDeviceVirtual are written to this log,
+    // so output of different versions can be compared
+    void setOutputLog(LedFrameLogWriter * outputLog) { m_outputLog = outputLog; }
+
+    // Blocks until all frames are sent, events are processed while waiting
+    bool replay(const QString & fileName, Speed speed);
+
+    int framesCount() const { return m_framesCount; }
+    int failedFramesCount() const { return m_failedFramesCount; }
+    qint64 elapsedUsec() const { return m_elapsedUsec; }
+    // Time spent in ILedDevice::setColors()
+    qint64 deviceUsec() const { return m_deviceUsec; }
+    qint64 maximumFrameUsec() const { return m_maximumFrameUsec; }
+    // Real time only, frames sent more than 1 ms later than recorded
+    int lateFramesCount() const { return m_lateFramesCount; }
+
+private slots:
+    void commandCompleted(bool ok);
+    void virtualDeviceColors(const QList<QRgb> & colors);
+
+private:
+    void waitUntil(const QElapsedTimer & timer, qint64 timeUsec);
+
+private:
+    ILedDevice *m_device;
+    LedFrameLogWriter *m_outputLog;
+
+    int m_framesCount;
+    int m_failedFramesCount;
+    int m_lateFramesCount;
+    qint64 m_elapsedUsec;
+    qint64 m_deviceUsec;
+    qint64 m_maximumFrameUsec;
+};
@@ -0,0 +1,76 @@
+/*
+ * LedLayout.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedLayout.hpp"
+#include "debug.h"
+
+QList<QRect> LedLayout::edges(const QRect & screen, const int ledsPerSide[EdgeLayout::SidesCount], int depth, int inset)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << screen << depth << inset;
+
+    QList<QRect> result;
+
+    QRect area = screen.adjusted(inset, inset, -inset, -inset);
+
+    if (area.width() <= 0 || area.height() <= 0)
+    {
+        qWarning() << Q_FUNC_INFO << "inset is too big for screen:" << inset << screen;
+        area = screen;
+    }
+
+    depth = qBound(1, depth, qMin(area.width(), area.height()) / 2);
+
+    for (int side = 0; side < EdgeLayout::SidesCount; side++)
+    {
+        int count = ledsPerSide[side];
+
+        // Length of the side, zone 'i' lies between length * i / count and length * (i + 1) / count
+        int length = (side == EdgeLayout::Left || side == EdgeLayout::Right) ? area.height() : area.width();
+
+        for (int i = 0; i < count; i++)
+        {
+            int from = length * i / count;
+            int to   = length * (i + 1) / count;
+
+            switch (side)
+            {
+            case EdgeLayout::Left:
+                result << QRect(area.left(), area.bottom() + 1 - to, depth, to - from);
+                break;
+            case EdgeLayout::Top:
+                result << QRect(area.left() + from, area.top(), to - from, depth);
+                break;
+            case EdgeLayout::Right:
+                result << QRect(area.right() + 1 - depth, area.top() + from, depth, to - from);
+                break;
+            case EdgeLayout::Bottom:
+                result << QRect(area.right() + 1 - to, area.bottom() + 1 - depth, to - from, depth);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,41 @@
+/*
+ * LedLayout.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QList>
+#include <QRect>
+#include "enums.hpp"
+
+class LedLayout
+{
+public:
+    // Zones of LEDs along the edges of the screen, numbered clockwise:
+    // left edge from bottom to top, top from left to right, right from top
+    // to bottom and bottom from right to left. Each side is split evenly
+    // between its LEDs, 'depth' is size of zones across the edge and 'inset'
+    // is indent from the edge. Corners are covered by both adjacent sides.
+    static QList<QRect> edges(const QRect & screen, const int ledsPerSide[EdgeLayout::SidesCount], int depth, int inset);
+};
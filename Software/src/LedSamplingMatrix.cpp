@@ -0,0 +1,205 @@
+/*
+ * LedSamplingMatrix.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedSamplingMatrix.hpp"
+#include <QHash>
+#include <QMap>
+#include <QtAlgorithms>
+#include "debug.h"
+
+static inline int alignDown(int x)
+{
+    return x - (((x % LedSamplingMatrix::CellAlignX) + LedSamplingMatrix::CellAlignX) % LedSamplingMatrix::CellAlignX);
+}
+
+static inline int alignUp(int x)
+{
+    return alignDown(x + LedSamplingMatrix::CellAlignX - 1);
+}
+
+// Sorts grid lines and removes duplicates
+static void uniqueSorted(QVector<int> & lines)
+{
+    qSort(lines);
+
+    int count = 0;
+    for (int i = 0; i < lines.size(); i++)
+    {
+        if (count == 0 || lines[count - 1] != lines[i])
+            lines[count++] = lines[i];
+    }
+    lines.resize(count);
+}
+
+LedSamplingMatrix::LedSamplingMatrix()
+{
+    clear();
+}
+
+void LedSamplingMatrix::clear()
+{
+    m_cells.clear();
+    m_rowOffsets.clear();
+    m_rowOffsets.append(0);
+    m_cellIndexes.clear();
+    m_weights.clear();
+}
+
+void LedSamplingMatrix::build(const QList< QList<SamplingZone> > & ledsZones)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "leds:" << ledsZones.size();
+
+    clear();
+
+    // Grid lines of the cells are the edges of all zones
+    QVector<int> xs, ys;
+
+    for (int led = 0; led < ledsZones.size(); led++)
+    {
+        for (int i = 0; i < ledsZones[led].size(); i++)
+        {
+            const SamplingZone & zone = ledsZones[led][i];
+
+            if (zone.rect.isEmpty() || zone.weight <= 0)
+                continue;
+
+            xs << alignDown(zone.rect.left()) << alignUp(zone.rect.right() + 1);
+            ys << zone.rect.top() << zone.rect.bottom() + 1;
+        }
+    }
+
+    uniqueSorted(xs);
+    uniqueSorted(ys);
+
+    // Index of the cell in m_cells by its position in the grid
+    QHash<int, int> cellIndexByGrid;
+
+    for (int led = 0; led < ledsZones.size(); led++)
+    {
+        // Sorted by cell index, so each row reads cells colors forward
+        QMap<int, qint64> rowWeights;
+
+        for (int i = 0; i < ledsZones[led].size(); i++)
+        {
+            const SamplingZone & zone = ledsZones[led][i];
+
+            if (zone.rect.isEmpty() || zone.weight <= 0)
+                continue;
+
+            int x0 = qLowerBound(xs, alignDown(zone.rect.left())) - xs.begin();
+            int x1 = qLowerBound(xs, alignUp(zone.rect.right() + 1)) - xs.begin();
+            int y0 = qLowerBound(ys, zone.rect.top()) - ys.begin();
+            int y1 = qLowerBound(ys, zone.rect.bottom() + 1) - ys.begin();
+
+            for (int yi = y0; yi < y1; yi++)
+            {
+                for (int xi = x0; xi < x1; xi++)
+                {
+                    QRect cell(xs[xi], ys[yi], xs[xi + 1] - xs[xi], ys[yi + 1] - ys[yi]);
+                    QRect covered = cell & zone.rect;
+
+                    if (covered.isEmpty())
+                        continue;
+
+                    int gridIndex = yi * xs.size() + xi;
+                    int cellIndex = cellIndexByGrid.value(gridIndex, -1);
+
+                    if (cellIndex < 0)
+                    {
+                        cellIndex = m_cells.size();
+                        m_cells.append(cell);
+                        cellIndexByGrid.insert(gridIndex, cellIndex);
+                    }
+
+                    rowWeights[cellIndex] += (qint64)covered.width() * covered.height() * zone.weight;
+                }
+            }
+        }
+
+        qint64 total = 0;
+        for (QMap<int, qint64>::const_iterator it = rowWeights.constBegin(); it != rowWeights.constEnd(); ++it)
+            total += it.value();
+
+        // Normalize by cumulative sums, so rounding errors don't
+        // accumulate and weights of the row give exactly 1 << WeightShift
+        qint64 cumulative = 0;
+        quint32 prevNormalized = 0;
+
+        for (QMap<int, qint64>::const_iterator it = rowWeights.constBegin(); it != rowWeights.constEnd(); ++it)
+        {
+            cumulative += it.value();
+            quint32 normalized = ((cumulative << WeightShift) + total / 2) / total;
+
+            if (normalized != prevNormalized)
+            {
+                m_cellIndexes.append(it.key());
+                m_weights.append(normalized - prevNormalized);
+                prevNormalized = normalized;
+            }
+        }
+
+        m_rowOffsets.append(m_cellIndexes.size());
+    }
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "cells:" << m_cells.size() << "weights:" << m_weights.size();
+}
+
+void LedSamplingMatrix::multiply(const QList<QRgb> & cellsColors, QList<QRgb> & ledsColors) const
+{
+    DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
+
+    if (cellsColors.size() != m_cells.size())
+    {
+        qWarning() << Q_FUNC_INFO << "cellsColors.size() != cells count:" << cellsColors.size() << m_cells.size();
+        return;
+    }
+
+    while (ledsColors.size() < ledsCount())
+        ledsColors.append(0);
+    while (ledsColors.size() > ledsCount())
+        ledsColors.removeLast();
+
+    const int half = 1 << (WeightShift - 1);
+
+    for (int led = 0; led < ledsCount(); led++)
+    {
+        // 255 * (1 << WeightShift) fits in 32-bit
+        quint32 r = 0, g = 0, b = 0;
+
+        for (int k = m_rowOffsets[led]; k < m_rowOffsets[led + 1]; k++)
+        {
+            QRgb rgb = cellsColors[m_cellIndexes[k]];
+            quint32 weight = m_weights[k];
+
+            r += qRed(rgb)   * weight;
+            g += qGreen(rgb) * weight;
+            b += qBlue(rgb)  * weight;
+        }
+
+        ledsColors[led] = qRgb((r + half) >> WeightShift,
+                               (g + half) >> WeightShift,
+                               (b + half) >> WeightShift);
+    }
+}
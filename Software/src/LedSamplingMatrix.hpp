@@ -0,0 +1,82 @@
+/*
+ * LedSamplingMatrix.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QList>
+#include <QVector>
+#include <QRect>
+#include <QRgb>
+
+// Screen area which contributes to the color of one LED
+struct SamplingZone
+{
+    SamplingZone() : weight(1) { }
+    SamplingZone(const QRect & r, int w = 1) : rect(r), weight(w) { }
+
+    bool operator==(const SamplingZone & other) const { return rect == other.rect && weight == other.weight; }
+
+    QRect rect;
+    int weight;
+};
+
+//
+// Maps screen to LEDs as sparse matrix: screen is split into cells by the
+// edges of all zones, each cell is averaged once per frame and color of LED
+// is weighted sum of cells covered by its zones (weight is the covered area
+// multiplied by weight of zone). Matrix is stored in CSR form: cells of LED
+// 'i' are m_cellIndexes[m_rowOffsets[i] .. m_rowOffsets[i+1]).
+//
+// One zone per LED gives the same colors as averaging of each zone, but
+// overlapped zones and zones of several LEDs share cells.
+//
+class LedSamplingMatrix
+{
+public:
+    LedSamplingMatrix();
+
+    void build(const QList< QList<SamplingZone> > & ledsZones);
+    void clear();
+
+    int ledsCount() const { return m_rowOffsets.size() - 1; }
+    const QList<QRect> & cells() const { return m_cells; }
+
+    // ledsColors[i] = sum(weight[i][j] * cellsColors[j])
+    void multiply(const QList<QRgb> & cellsColors, QList<QRgb> & ledsColors) const;
+
+public:
+    // Horizontal edges of cells are aligned by this value,
+    // grabbers sum pixels of rows by 4 at once
+    static const int CellAlignX = 4;
+
+    // Weights of each LED are normalized to 1 << WeightShift
+    static const int WeightShift = 16;
+
+private:
+    QList<QRect> m_cells;
+    QVector<int> m_rowOffsets;
+    QVector<int> m_cellIndexes;
+    QVector<quint32> m_weights;
+};
@@ -0,0 +1,138 @@
+/*
+ * LedZone.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedZone.hpp"
+#include "Settings.hpp"
+#include "debug.h"
+
+using namespace SettingsScope;
+
+// Colors changes when mouse wheel scrolled over zone
+const QColor LedZone::m_colors[LedZone::ColorsCount][2] = {
+    { Qt::red,         Qt::black }, /* LED1 */
+    { Qt::green,       Qt::black }, /* LED2 */
+    { Qt::blue,        Qt::white }, /* LED3 */
+    { Qt::yellow,      Qt::black }, /* LED4 */
+    { Qt::darkRed,     Qt::white }, /* LED5 */
+    { Qt::darkGreen,   Qt::white }, /* LED6 */
+    { Qt::darkBlue,    Qt::white }, /* LED7 */
+    { Qt::darkYellow,  Qt::white }, /* LED8 */
+    { qRgb(0,242,123), Qt::black },
+    { Qt::magenta,     Qt::black },
+    { Qt::cyan,        Qt::black },
+    { Qt::white,       Qt::black }, // ColorIndexWhite == 11
+};
+
+LedZone::LedZone(int id)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << id;
+
+    m_selfId = id;
+    m_selfIdString = QString::number(m_selfId + 1);
+
+    settingsProfileChanged();
+    fillBackgroundColored();
+}
+
+void LedZone::settingsProfileChanged()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_selfId;
+
+    m_coefRed = Settings::getLedCoefRed(m_selfId);
+    m_coefGreen = Settings::getLedCoefGreen(m_selfId);
+    m_coefBlue = Settings::getLedCoefBlue(m_selfId);
+
+    m_isAreaEnabled = Settings::isLedEnabled(m_selfId);
+
+    m_rect = QRect(Settings::getLedPosition(m_selfId), Settings::getLedSize(m_selfId));
+
+    m_weight = Settings::getLedWeight(m_selfId);
+    m_extraZones = Settings::getLedExtraZones(m_selfId);
+}
+
+void LedZone::saveSizeAndPosition()
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_selfId;
+
+    Settings::setLedPosition(m_selfId, m_rect.topLeft());
+    Settings::setLedSize(m_selfId, m_rect.size());
+}
+
+void LedZone::setCoefRed(double value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+    Settings::setLedCoefRed(m_selfId, value);
+    m_coefRed = Settings::getLedCoefRed(m_selfId);
+}
+
+void LedZone::setCoefGreen(double value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+    Settings::setLedCoefGreen(m_selfId, value);
+    m_coefGreen = Settings::getLedCoefGreen(m_selfId);
+}
+
+void LedZone::setCoefBlue(double value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+    Settings::setLedCoefBlue(m_selfId, value);
+    m_coefBlue = Settings::getLedCoefBlue(m_selfId);
+}
+
+void LedZone::setAreaEnabled(bool isEnabled)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << isEnabled;
+
+    Settings::setLedEnabled(m_selfId, isEnabled);
+    m_isAreaEnabled = isEnabled;
+
+    fillBackgroundColored();
+}
+
+QColor LedZone::getBackgroundColor() const
+{
+    // Disabled zone is gray
+    return m_isAreaEnabled ? m_colors[m_colorIndex][0] : QColor(Qt::gray);
+}
+
+QColor LedZone::getTextColor() const
+{
+    return m_isAreaEnabled ? m_colors[m_colorIndex][1] : QColor(Qt::black);
+}
+
+void LedZone::fillBackgroundWhite()
+{
+    m_colorIndex = ColorIndexWhite;
+}
+
+void LedZone::fillBackgroundColored()
+{
+    m_colorIndex = m_selfId % ColorsCount;
+}
+
+void LedZone::fillBackgroundNext(int step)
+{
+    m_colorIndex = ((m_colorIndex + step) % ColorsCount + ColorsCount) % ColorsCount;
+}
@@ -0,0 +1,89 @@
+/*
+ * LedZone.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QRect>
+#include <QColor>
+#include <QString>
+#include "LedSamplingMatrix.hpp"
+
+// Screen area of one LED with its settings, drawn and edited by GrabOverlay
+class LedZone
+{
+public:
+    LedZone(int id);
+
+    void settingsProfileChanged();
+    void saveSizeAndPosition();
+
+    int getId() const { return m_selfId; }
+    const QString & getIdString() const { return m_selfIdString; }
+
+    const QRect & getRect() const { return m_rect; }
+    void setRect(const QRect & rect) { m_rect = rect; }
+
+    double getCoefRed() const { return m_coefRed; }
+    double getCoefGreen() const { return m_coefGreen; }
+    double getCoefBlue() const { return m_coefBlue; }
+    void setCoefRed(double value);
+    void setCoefGreen(double value);
+    void setCoefBlue(double value);
+
+    bool isAreaEnabled() const { return m_isAreaEnabled; }
+    void setAreaEnabled(bool isEnabled);
+
+    // Weight of m_rect and other screen areas blended into the LED color
+    int getWeight() const { return m_weight; }
+    const QList<SamplingZone> & getExtraZones() const { return m_extraZones; }
+
+    QColor getBackgroundColor() const;
+    QColor getTextColor() const;
+
+    void fillBackgroundWhite();
+    void fillBackgroundColored();
+    void fillBackgroundNext(int step);
+
+public:
+    static const int ColorIndexWhite = 11;
+    static const int ColorsCount = 12;
+
+private:
+    static const QColor m_colors[ColorsCount][2]; // background and text colors
+    int m_colorIndex; // index of color which using now
+
+    int m_selfId;
+    QString m_selfIdString;
+
+    QRect m_rect;
+    bool m_isAreaEnabled;
+
+    int m_weight;
+    QList<SamplingZone> m_extraZones;
+
+    double m_coefRed;
+    double m_coefGreen;
+    double m_coefBlue;
+};
@@ -135,6 +135,10 @@ void LightpackApplication::processCommandLineArguments()
         {
             g_debugLevel = Debug::ZeroLevel;
             m_isDebugLevelObtainedFromCmdArgs = true;
+        }
+        else if (arguments().at(i) == "--record-frames" && i + 1 < arguments().count())
+        {
+            m_recordFramesFileName = arguments().at(++i);
         } else {
             qDebug() << "Wrong argument:" << arguments().at(i);
             printHelpMessage();
@@ -168,6 +172,7 @@ void LightpackApplication::printHelpMessage() const
     fprintf(stderr, "  --debug-mid   - middle debug level\n");
     fprintf(stderr, "  --debug-low   - low debug level, DEFAULT\n");
     fprintf(stderr, "  --debug-zero  - minimum debug output\n");
+    fprintf(stderr, "  --record-frames FILE - record frames sent to device for replaying\n");
     fprintf(stderr, "\n");
 }
 
@@ -286,10 +291,14 @@ void LightpackApplication::startApiServer()
 void LightpackApplication::startLedDeviceFactory()
 {
     m_ledDeviceFactory = new LedDeviceFactory();
+
+    if (m_recordFramesFileName.isEmpty() == false)
+        m_ledDeviceFactory->recordFrames(m_recordFramesFileName);
     m_ledDeviceFactoryThread = new QThread();
 
     connect(m_settingsWindow, SIGNAL(recreateLedDevice()),                      m_ledDeviceFactory, SLOT(recreateLedDevice()), Qt::DirectConnection);
-    connect(m_settingsWindow, SIGNAL(updateLedsColors(const QList<QRgb> &)),    m_ledDeviceFactory, SLOT(setColors(QList<QRgb>)), Qt::QueuedConnection);
+    // Frames are published from the thread of producer, without copy of colors in event queue
+    connect(m_settingsWindow, SIGNAL(updateLedsColors(const QList<QRgb> &)),    m_ledDeviceFactory, SLOT(publishColors(QList<QRgb>)), Qt::DirectConnection);
 
     connect(m_settingsWindow, SIGNAL(offLeds()),                    m_ledDeviceFactory, SLOT(offLeds()), Qt::QueuedConnection);
     connect(m_settingsWindow, SIGNAL(updateColorDepth(int)),        m_ledDeviceFactory, SLOT(setColorDepth(int)), Qt::QueuedConnection);
@@ -299,9 +308,11 @@ void LightpackApplication::startLedDeviceFactory()
     connect(m_settingsWindow, SIGNAL(updateBrightness(int)),        m_ledDeviceFactory, SLOT(setBrightness(int)), Qt::QueuedConnection);
     connect(m_settingsWindow, SIGNAL(requestFirmwareVersion()),     m_ledDeviceFactory, SLOT(requestFirmwareVersion()), Qt::QueuedConnection);
     connect(m_settingsWindow, SIGNAL(settingsProfileChanged()),     m_ledDeviceFactory, SLOT(updateDeviceSettings()), Qt::QueuedConnection);
+    connect(m_settingsWindow, SIGNAL(updateApiDeviceNumberOfLeds(int)), m_ledDeviceFactory, SLOT(updateNumberOfLeds()), Qt::QueuedConnection);
 
     connect(m_ledDeviceFactory, SIGNAL(openDeviceSuccess(bool)),    m_settingsWindow, SLOT(ledDeviceOpenSuccess(bool)), Qt::QueuedConnection);
     connect(m_ledDeviceFactory, SIGNAL(ioDeviceSuccess(bool)),      m_settingsWindow, SLOT(ledDeviceCallSuccess(bool)), Qt::QueuedConnection);
+    connect(m_ledDeviceFactory, SIGNAL(ledsCountReported(int)),     m_settingsWindow, SLOT(ledDeviceLedsCountResult(int)), Qt::QueuedConnection);
     connect(m_ledDeviceFactory, SIGNAL(firmwareVersion(QString)),   m_settingsWindow, SLOT(ledDeviceFirmwareVersionResult(QString)), Qt::QueuedConnection);
     connect(m_ledDeviceFactory, SIGNAL(setColors_VirtualDeviceCallback(QList<QRgb>)), m_settingsWindow, SLOT(updateVirtualLedsColors(QList<QRgb>)), Qt::QueuedConnection);
 
@@ -313,7 +324,7 @@ void LightpackApplication::connectApiServerAndLedDeviceSignalsSlots()
 {
     if (m_isApiServerConnectedToLedDeviceSignalsSlots == false)
     {
-        connect(m_apiServer, SIGNAL(updateLedsColors(QList<QRgb>)), m_ledDeviceFactory, SLOT(setColors(QList<QRgb>)), Qt::QueuedConnection);
+        connect(m_apiServer, SIGNAL(updateLedsColors(QList<QRgb>)), m_ledDeviceFactory, SLOT(publishColors(QList<QRgb>)), Qt::DirectConnection);
         connect(m_apiServer, SIGNAL(updateGamma(double)),           m_ledDeviceFactory, SLOT(setGamma(double)), Qt::QueuedConnection);
         connect(m_apiServer, SIGNAL(updateBrightness(int)),         m_ledDeviceFactory, SLOT(setBrightness(int)), Qt::QueuedConnection);
         connect(m_apiServer, SIGNAL(updateSmooth(int)),             m_ledDeviceFactory, SLOT(setSmoothSlowdown(int)), Qt::QueuedConnection);
@@ -325,7 +336,7 @@ void LightpackApplication::disconnectApiServerAndLedDeviceSignalsSlots()
 {
     if (m_isApiServerConnectedToLedDeviceSignalsSlots == true)
     {
-        disconnect(m_apiServer, SIGNAL(updateLedsColors(QList<QRgb>)),  m_ledDeviceFactory, SLOT(setColors(QList<QRgb>)));
+        disconnect(m_apiServer, SIGNAL(updateLedsColors(QList<QRgb>)),  m_ledDeviceFactory, SLOT(publishColors(QList<QRgb>)));
         disconnect(m_apiServer, SIGNAL(updateGamma(double)),            m_ledDeviceFactory, SLOT(setGamma(double)));
         disconnect(m_apiServer, SIGNAL(updateBrightness(int)),          m_ledDeviceFactory, SLOT(setBrightness(int)));
         disconnect(m_apiServer, SIGNAL(updateSmooth(int)),              m_ledDeviceFactory, SLOT(setSmoothSlowdown(int)));
@@ -342,8 +353,8 @@ void LightpackApplication::commitData(QSessionManager &sessionManager)
     if (m_ledDeviceFactory != NULL)
     {
         // Disable signals with new colors
-        disconnect(m_settingsWindow, SIGNAL(updateLedsColors(QList<QRgb>)),  m_ledDeviceFactory, SLOT(setColors(QList<QRgb>)));
-        disconnect(m_apiServer, SIGNAL(updateLedsColors(QList<QRgb>)),  m_ledDeviceFactory, SLOT(setColors(QList<QRgb>)));
+        disconnect(m_settingsWindow, SIGNAL(updateLedsColors(QList<QRgb>)),  m_ledDeviceFactory, SLOT(publishColors(QList<QRgb>)));
+        disconnect(m_apiServer, SIGNAL(updateLedsColors(QList<QRgb>)),  m_ledDeviceFactory, SLOT(publishColors(QList<QRgb>)));
 
         // Process all currently pending signals
         QApplication::processEvents(QEventLoop::AllEvents, 1000);
@@ -77,5 +77,6 @@ private:
 
     QString m_applicationDirPath;
     bool m_isDebugLevelObtainedFromCmdArgs;
+    QString m_recordFramesFileName;
     bool m_isApiServerConnectedToLedDeviceSignalsSlots;
 };
@@ -24,9 +24,71 @@
  */
 
 #include "LightpackMath.hpp"
+#include <string.h>
 #include "debug.h"
 
-void LightpackMath::gammaCorrection(double gamma, const QList<QRgb> &colors, QList<StructRgb> &result, int colorDepth /* = 256 */)
+// Linear light values are 16-bit, the mean is encoded back by 12 high bits
+static const int LinearLightMax = 65535;
+static const int LinearLightLevels = 4096;
+
+// Linear values of B and G are summed in 32-bit lanes of one 64-bit word,
+// lanes hold sum of a row up to 65537 pixels
+static const int LaneBits = 32;
+static const quint64 LaneMask = 0xffffffff;
+
+// Linear value of sRGB byte and pair of B and G bytes loaded as one 16-bit
+// word, B in low lane and G in high lane of the pair
+static quint32 s_srgbToLinear[256];
+static quint64 s_srgbToLinearBg[65536];
+static quint8  s_linearToSrgb[LinearLightLevels];
+
+static double srgbToLinear(int srgb)
+{
+    double c = srgb / 255.0;
+    return (c <= 0.04045) ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+// Fills sRGB <-> linear tables once at startup
+static struct LinearLightTablesInitializer
+{
+    LinearLightTablesInitializer()
+    {
+        for (int i = 0; i < 256; i++)
+            s_srgbToLinear[i] = (quint32)(srgbToLinear(i) * LinearLightMax + 0.5);
+
+        for (int i = 0; i < 65536; i++)
+        {
+            quint16 pair = i;
+            const quint8 * bytes = (const quint8 *)&pair;
+
+            s_srgbToLinearBg[i] = s_srgbToLinear[bytes[0]] | ((quint64)s_srgbToLinear[bytes[1]] << LaneBits);
+        }
+
+        for (int i = 0; i < LinearLightLevels; i++)
+        {
+            double linear = (double)i / (LinearLightLevels - 1);
+            double c = (linear <= 0.0031308) ? linear * 12.92 : 1.055 * pow(linear, 1 / 2.4) - 0.055;
+            s_linearToSrgb[i] = (quint8)(c * 255 + 0.5);
+        }
+    }
+} s_linearLightTablesInitializer;
+
+static inline quint8 linearToSrgb(quint64 sum, unsigned count)
+{
+    quint64 linear = (sum + count / 2) / count;
+
+    return s_linearToSrgb[(linear * (LinearLightLevels - 1) + LinearLightMax / 2) / LinearLightMax];
+}
+
+GammaTable::GammaTable()
+{
+    m_gamma = -1;
+    m_colorDepth = -1;
+    m_isLinearLight = false;
+    memset(m_table, 0, sizeof(m_table));
+}
+
+void GammaTable::gammaCorrection(double gamma, const QList<QRgb> &colors, QList<StructRgb> &result, int colorDepth /* = 256 */)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO << gamma;
 
@@ -37,20 +99,45 @@ void LightpackMath::gammaCorrection(double gamma, const QList<QRgb> &colors, QLi
     // 256  == 2^8 : This is default color depth
     // 4096 == 2^12: This is color depth for lightpack hw6
 
+    if (m_gamma != gamma || m_colorDepth != colorDepth)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            if (m_isLinearLight)
+                m_table[i] = (colorDepth - 1) * srgbToLinear(i) + 0.5;
+            else
+                m_table[i] = colorDepth * pow(i / 256.0, gamma);
+        }
+
+        m_gamma = gamma;
+        m_colorDepth = colorDepth;
+    }
+
     for (int i = 0; i < colors.count(); i++)
     {
         StructRgb rgbResult;
 
         QRgb rgb = colors[i]; // color depth -- 8-bit
 
-        rgbResult.r = colorDepth * pow(qRed(rgb) / 256.0, gamma);
-        rgbResult.g = colorDepth * pow(qGreen(rgb) / 256.0, gamma);
-        rgbResult.b = colorDepth * pow(qBlue(rgb) / 256.0, gamma);
+        rgbResult.r = m_table[qRed(rgb)];
+        rgbResult.g = m_table[qGreen(rgb)];
+        rgbResult.b = m_table[qBlue(rgb)];
 
         result[i] = rgbResult;
     }
 }
 
+void GammaTable::setLinearLight(bool isLinearLight)
+{
+    if (m_isLinearLight == isLinearLight)
+        return;
+
+    m_isLinearLight = isLinearLight;
+
+    // Rebuild table on next call
+    m_gamma = -1;
+}
+
 void LightpackMath::brightnessCorrection(int brightness, QList<StructRgb> & result)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO << brightness;
@@ -64,3 +151,59 @@ void LightpackMath::brightnessCorrection(int brightness, QList<StructRgb> & resu
         result[i].b = (brightness / 100.0) * result[i].b;
     }
 }
+
+QRgb LightpackMath::avgColorLinearLight(const unsigned char * pixels, int bytesPerLine, int bytesPerPixel,
+                                        int x, int y, int width, int height)
+{
+    DEBUG_HIGH_LEVEL << Q_FUNC_INFO << "x y w h:" << x << y << width << height;
+
+    unsigned count = width * height;
+
+    if (count == 0)
+        return 0x000000;
+
+    quint64 r = 0, g = 0, b = 0;
+
+    // Plain averaging loads and adds each byte, so three lookups per pixel
+    // would double loads. B and G are decoded by one lookup of the 16-bit
+    // word, two pixels per step keep two independent sums.
+    for (int j = 0; j < height; j++)
+    {
+        const unsigned char * pixel = pixels + bytesPerLine * (y + j) + x * bytesPerPixel;
+
+        quint64 bg0 = 0, bg1 = 0;
+        quint32 r0 = 0, r1 = 0;
+        int i = 0;
+
+        for (; i + 2 <= width; i += 2)
+        {
+            quint16 pair0, pair1;
+            memcpy(&pair0, pixel, sizeof(pair0));
+            memcpy(&pair1, pixel + bytesPerPixel, sizeof(pair1));
+
+            bg0 += s_srgbToLinearBg[pair0];
+            r0  += s_srgbToLinear[pixel[2]];
+            bg1 += s_srgbToLinearBg[pair1];
+            r1  += s_srgbToLinear[pixel[bytesPerPixel + 2]];
+
+            pixel += 2 * bytesPerPixel;
+        }
+
+        if (i < width)
+        {
+            quint16 pair0;
+            memcpy(&pair0, pixel, sizeof(pair0));
+
+            bg0 += s_srgbToLinearBg[pair0];
+            r0  += s_srgbToLinear[pixel[2]];
+        }
+
+        quint64 bg = bg0 + bg1;
+
+        b += bg & LaneMask;
+        g += bg >> LaneBits;
+        r += (quint64)r0 + r1;
+    }
+
+    return qRgb(linearToSrgb(r, count), linearToSrgb(g, count), linearToSrgb(b, count));
+}
@@ -30,12 +30,51 @@
 #include <cmath>
 #include "StructRgb.hpp"
 
+// Gamma correction table of one LED device. pow() evaluates only on gamma or
+// color depth changes, all other calls use table for each of 256 input values.
+// Not shared between devices, so each device thread keeps its own color depth.
+class GammaTable
+{
+public:
+    GammaTable();
+
+    // If colorDepth == 4096 then 8-bit 'colors' are converted to 12-bit 'result'
+    void gammaCorrection(double gamma, const QList<QRgb> & colors, QList<StructRgb> & result, int colorDepth = 256);
+
+    // Colors averaged in linear light are sRGB encoded linear means, table
+    // decodes them back to linear values of the device instead of pow(gamma)
+    void setLinearLight(bool isLinearLight);
+
+private:
+    double m_gamma;
+    int m_colorDepth;
+    bool m_isLinearLight;
+    unsigned m_table[256];
+};
+
 class LightpackMath
 {
 public:
-    static void gammaCorrection(double gamma, const QList<QRgb> & colors, QList<StructRgb> & result, int colorDepth = 256);
     static void brightnessCorrection(int brightness, QList<StructRgb> & result);
 
+    // Average color of the rectangle on 32-bit BGRx screen buffer, evaluated in linear light:
+    // sRGB bytes decoded by table to 16-bit linear values, averaged and encoded back to sRGB
+    static QRgb avgColorLinearLight(const unsigned char * pixels, int bytesPerLine, int bytesPerPixel,
+                                    int x, int y, int width, int height);
+
+    // Cheap approximation of perceptual color difference: absolute channel
+    // differences weighted like luma (0.3, 0.6, 0.1). Weights are scaled by
+    // PerceptualDeltaScale to stay in integers, so delta of 1 level in all
+    // channels gives PerceptualDeltaScale.
+    static const int PerceptualDeltaScale = 10;
+
+    static inline int perceptualDelta(QRgb a, QRgb b)
+    {
+        return 3 * qAbs(qRed(a)   - qRed(b))   +
+               6 * qAbs(qGreen(a) - qGreen(b)) +
+               1 * qAbs(qBlue(a)  - qBlue(b));
+    }
+
     // Convert ASCII char '5' to 5
     static inline char getDigit(const char d)
     {
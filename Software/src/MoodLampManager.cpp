@@ -128,7 +128,7 @@ void MoodLampManager::settingsProfileChanged()
 
     m_isSendDataOnlyIfColorsChanged = Settings::isSendDataOnlyIfColorsChanges();
 
-    initColors(Settings::getNumberOfLeds(Settings::getConnectedDevice()));
+    initColors(Settings::getNumberOfLedsInFrame());
 }
 
 void MoodLampManager::updateColors()
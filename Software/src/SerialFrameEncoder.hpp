@@ -0,0 +1,155 @@
+/*
+ * SerialFrameEncoder.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QList>
+#include <QByteArray>
+
+#include "StructRgb.hpp"
+
+// Frame encoders for serial and network LED devices: header, then colors.
+// Channel order and bit depth are template parameters, so the inner loop
+// has no branches, and the frame is written into a preallocated buffer.
+//
+// New strip protocol is a new header struct and/or typedef, e.g.
+//   typedef SerialFrameEncoder<AdalightHeader, ColorOrderGrb> MyStripEncoder;
+
+// Channel positions inside one color
+template <int R, int G, int B>
+struct ColorOrder
+{
+    enum { RedIndex = R, GreenIndex = G, BlueIndex = B };
+};
+
+typedef ColorOrder<0, 1, 2> ColorOrderRgb;
+typedef ColorOrder<0, 2, 1> ColorOrderRbg;
+typedef ColorOrder<1, 0, 2> ColorOrderGrb;
+typedef ColorOrder<2, 0, 1> ColorOrderGbr;
+typedef ColorOrder<1, 2, 0> ColorOrderBrg;
+typedef ColorOrder<2, 1, 0> ColorOrderBgr;
+
+// Channel value in big-endian order, 8 bits -> 1 byte, 12 and 16 bits -> 2 bytes
+template <int Bits>
+struct ChannelDepth
+{
+    enum { ColorDepth = 1 << Bits, Size = (Bits + 7) / 8, MaxValue = ColorDepth - 1 };
+
+    static inline void write(unsigned value, char * buffer)
+    {
+        if (value > MaxValue)
+            value = MaxValue;
+
+        for (int i = Size - 1; i >= 0; i--)
+        {
+            buffer[i] = (char)(value & 0xff);
+            value >>= 8;
+        }
+    }
+};
+
+struct NoHeader
+{
+    static int size(int /*ledsCount*/) { return 0; }
+    static void write(int /*ledsCount*/, char * /*buffer*/) { }
+};
+
+// "Ada", LEDs count - 1 (hi, lo) and checksum
+struct AdalightHeader
+{
+    static int size(int /*ledsCount*/) { return 6; }
+
+    static void write(int ledsCount, char * buffer)
+    {
+        int ledsCountHi = ((ledsCount - 1) >> 8) & 0xff;
+        int ledsCountLo = (ledsCount  - 1) & 0xff;
+
+        buffer[0] = 'A';
+        buffer[1] = 'd';
+        buffer[2] = 'a';
+        buffer[3] = (char)ledsCountHi;
+        buffer[4] = (char)ledsCountLo;
+        buffer[5] = (char)(ledsCountHi ^ ledsCountLo ^ 0x55);
+    }
+};
+
+// Start byte only, LEDs count is fixed in firmware
+struct ArdulightHeader
+{
+    static int size(int /*ledsCount*/) { return 1; }
+    static void write(int /*ledsCount*/, char * buffer) { buffer[0] = (char)255; }
+};
+
+template <class Header, class Order = ColorOrderRgb, int Bits = 8>
+class SerialFrameEncoder
+{
+public:
+    typedef ChannelDepth<Bits> Channel;
+
+    // Pass it to GammaTable::gammaCorrection()
+    enum { ColorDepth = Channel::ColorDepth, ColorSize = 3 * Channel::Size };
+
+    static int frameSize(int ledsCount)
+    {
+        return Header::size(ledsCount) + ledsCount * ColorSize;
+    }
+
+    // Resizes buffer only if LEDs count changed, so no allocations per frame
+    // while buffer isn't shared with other QByteArray
+    static void encodeFrame(const QList<StructRgb> & colors, QByteArray & buffer)
+    {
+        int size = frameSize(colors.count());
+
+        if (buffer.size() != size)
+            buffer.resize(size);
+
+        encodeFrame(colors, buffer.data());
+    }
+
+    // Buffer must be at least frameSize(colors.count()) bytes
+    static void encodeFrame(const QList<StructRgb> & colors, char * buffer)
+    {
+        int ledsCount = colors.count();
+
+        Header::write(ledsCount, buffer);
+        buffer += Header::size(ledsCount);
+
+        for (int i = 0; i < ledsCount; i++)
+        {
+            encodeColor(colors[i], buffer);
+            buffer += ColorSize;
+        }
+    }
+
+    static inline void encodeColor(const StructRgb & color, char * buffer)
+    {
+        Channel::write(color.r, buffer + Order::RedIndex   * Channel::Size);
+        Channel::write(color.g, buffer + Order::GreenIndex * Channel::Size);
+        Channel::write(color.b, buffer + Order::BlueIndex  * Channel::Size);
+    }
+};
+
+typedef SerialFrameEncoder<AdalightHeader,  ColorOrderRgb, 8> AdalightEncoder;
+typedef SerialFrameEncoder<ArdulightHeader, ColorOrderRgb, 8> ArdulightEncoder;
@@ -0,0 +1,184 @@
+/*
+ * SerialFrameWriter.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SerialFrameWriter.hpp"
+#include "Settings.hpp"
+#include "debug.h"
+
+using namespace SettingsScope;
+
+SerialFrameWriter::SerialFrameWriter(QObject * parent) : QObject(parent)
+{
+    m_device = NULL;
+    m_baudRate = 0;
+    m_isPendingFrame = false;
+    m_frameSize = 0;
+    m_droppedFramesCount = 0;
+
+    m_timerFlush = new QTimer(this);
+    m_timerFlush->setSingleShot(true);
+    connect(m_timerFlush, SIGNAL(timeout()), this, SLOT(flushPending()));
+}
+
+void SerialFrameWriter::setDevice(AbstractSerial * device)
+{
+    reset();
+
+    m_device = device;
+
+    // AbstractSerial returns "115200 baud"
+    m_baudRate = (m_device != NULL) ? m_device->baudRate().section(' ', 0, 0).toInt() : 0;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "baud rate:" << m_baudRate;
+}
+
+void SerialFrameWriter::reset()
+{
+    m_timerFlush->stop();
+
+    m_isPendingFrame = false;
+    m_partialFrame.clear();
+
+    m_frameSize = 0;
+    m_droppedFramesCount = 0;
+}
+
+bool SerialFrameWriter::writeFrame(const QByteArray & frame)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << "Hex:" << frame.toHex();
+
+    if (m_device == NULL || m_device->isOpen() == false)
+        return false;
+
+    if (m_frameSize != frame.size())
+    {
+        m_frameSize = frame.size();
+
+        double fps = maximumFramesPerSecond(m_baudRate, m_frameSize);
+        double grabFps = 1000.0 / Settings::getGrabSlowdown();
+
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "frame size:" << m_frameSize << "bytes, baud rate:" << m_baudRate
+                        << "maximum FPS:" << fps;
+
+        if (fps > 0 && fps < grabFps)
+            qWarning() << Q_FUNC_INFO << "Serial line is too slow for" << m_frameSize << "bytes frames at" << m_baudRate << "baud:"
+                       << "maximum FPS" << fps << "<" << grabFps << "grab FPS, stale frames will be dropped";
+    }
+
+    if (m_isPendingFrame)
+    {
+        m_droppedFramesCount++;
+        DEBUG_MID_LEVEL << Q_FUNC_INFO << "line is busy, frame dropped, total:" << m_droppedFramesCount;
+    }
+
+    if (m_pendingFrame.size() != frame.size())
+        m_pendingFrame.resize(frame.size());
+
+    memcpy(m_pendingFrame.data(), frame.constData(), frame.size());
+    m_isPendingFrame = true;
+
+    // Already waiting for the queue to drain
+    if (m_timerFlush->isActive())
+        return true;
+
+    return flush();
+}
+
+double SerialFrameWriter::maximumFramesPerSecond(int baudRate, int frameSize)
+{
+    if (baudRate <= 0 || frameSize <= 0)
+        return 0;
+
+    return baudRate / 10.0 / frameSize;
+}
+
+void SerialFrameWriter::flushPending()
+{
+    if (flush() == false)
+        qWarning() << Q_FUNC_INFO << "Write to serial device" << m_device->deviceName() << "fail";
+}
+
+bool SerialFrameWriter::flush()
+{
+    if (m_device == NULL || m_device->isOpen() == false)
+        return false;
+
+    // Finish started frame first, otherwise device loses synchronization
+    if (m_partialFrame.isEmpty() == false)
+    {
+        qint64 bytesWritten = m_device->write(m_partialFrame);
+        if (bytesWritten < 0)
+        {
+            m_partialFrame.clear();
+            return false;
+        }
+
+        m_partialFrame.remove(0, bytesWritten);
+        if (m_partialFrame.isEmpty() == false)
+        {
+            scheduleFlush(m_partialFrame.size());
+            return true;
+        }
+    }
+
+    if (m_isPendingFrame == false)
+        return true;
+
+    // -1 if not supported, then just write it as before
+    qint64 queued = m_device->bytesInOutputQueue();
+
+    // Keep at most one frame behind the one being transmitted
+    if (queued >= m_pendingFrame.size())
+    {
+        scheduleFlush(queued - m_pendingFrame.size() + 1);
+        return true;
+    }
+
+    m_isPendingFrame = false;
+
+    qint64 bytesWritten = m_device->write(m_pendingFrame);
+    if (bytesWritten < 0)
+        return false;
+
+    if (bytesWritten < m_pendingFrame.size())
+    {
+        DEBUG_MID_LEVEL << Q_FUNC_INFO << "output queue is full, written" << bytesWritten << "of" << m_pendingFrame.size();
+
+        m_partialFrame = m_pendingFrame.mid(bytesWritten);
+        scheduleFlush(m_partialFrame.size());
+    }
+
+    return true;
+}
+
+void SerialFrameWriter::scheduleFlush(qint64 bytesToDrain)
+{
+    int msec = 1;
+
+    if (m_baudRate > 0)
+        msec = qMax(1, (int)(bytesToDrain * 10 * 1000 / m_baudRate));
+
+    m_timerFlush->start(msec);
+}
@@ -0,0 +1,76 @@
+/*
+ * SerialFrameWriter.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QTimer>
+#include "abstractserial.h"
+
+// Writes frames to serial device without waiting for transmission.
+// When the line can't keep up, frames waiting for the driver output queue
+// are replaced by the newest one, so latency doesn't grow.
+class SerialFrameWriter : public QObject
+{
+    Q_OBJECT
+public:
+    SerialFrameWriter(QObject * parent = 0);
+
+    // Device must be open and configured, it isn't owned by writer
+    void setDevice(AbstractSerial * device);
+    void reset();
+
+    // Returns false only on write error, dropped frame isn't an error
+    bool writeFrame(const QByteArray & frame);
+
+    int droppedFramesCount() const { return m_droppedFramesCount; }
+    int baudRate() const { return m_baudRate; }
+
+    // 8N1: start bit + 8 data bits + stop bit per byte
+    static double maximumFramesPerSecond(int baudRate, int frameSize);
+
+private slots:
+    void flushPending();
+
+private:
+    bool flush();
+    void scheduleFlush(qint64 bytesToDrain);
+
+private:
+    AbstractSerial *m_device;
+    int m_baudRate;
+
+    // Newest frame, not passed to driver yet. It's a copy, so the caller
+    // can reuse its buffer without detaching on the next frame.
+    QByteArray m_pendingFrame;
+    bool m_isPendingFrame;
+    QByteArray m_partialFrame; // rest of frame partially accepted by driver
+
+    QTimer *m_timerFlush;
+
+    int m_frameSize;
+    int m_droppedFramesCount;
+};
@@ -35,6 +35,7 @@
 #include <QDir>
 #include <QUuid>
 
+#include "LedLayout.hpp"
 #include "debug.h"
 
 using namespace SettingsScope;
@@ -102,6 +103,37 @@ namespace Virtual
 {
 static const QString NumberOfLeds = "Virtual/NumberOfLeds";
 }
+namespace Udp
+{
+static const QString Host = "Udp/Host";
+static const QString Port = "Udp/Port";
+static const QString NumberOfLeds = "Udp/NumberOfLeds";
+}
+namespace Dmx
+{
+static const QString Host = "Dmx/Host";
+static const QString StartUniverse = "Dmx/StartUniverse";
+}
+namespace E131
+{
+static const QString NumberOfLeds = "E131/NumberOfLeds";
+}
+namespace ArtNet
+{
+static const QString NumberOfLeds = "ArtNet/NumberOfLeds";
+}
+namespace ExtraDevices
+{
+static const QString Devices = "ExtraDevices/Devices";
+}
+// [ExtraDevice_i] network settings of i-th entry of ExtraDevices/Devices
+namespace ExtraDevice
+{
+static const QString Prefix = "ExtraDevice_";
+static const QString Host = "Host";
+static const QString Port = "Port";
+static const QString StartUniverse = "StartUniverse";
+}
 } /*Key*/
 
 namespace Value
@@ -114,6 +146,9 @@ static const QString LightpackDevice = "Lightpack";
 static const QString AlienFxDevice = "AlienFx";
 static const QString AdalightDevice = "Adalight";
 static const QString ArdulightDevice = "Ardulight";
+static const QString UdpDevice = "Udp";
+static const QString E131Device = "E131";
+static const QString ArtNetDevice = "ArtNet";
 static const QString VirtualDevice = "Virtual";
 }
 
@@ -127,6 +162,7 @@ namespace Key
 // [General]
 static const QString LightpackMode = "LightpackMode";
 static const QString IsBacklightEnabled = "IsBacklightEnabled";
+static const QString DefaultLayoutNumberOfLeds = "DefaultLayoutNumberOfLeds";
 // [Grab]
 namespace Grab
 {
@@ -135,6 +171,8 @@ static const QString IsAvgColorsEnabled = "Grab/IsAvgColorsEnabled";
 static const QString IsSendDataOnlyIfColorsChanges = "Grab/IsSendDataOnlyIfColorsChanges";
 static const QString Slowdown = "Grab/Slowdown";
 static const QString MinimumLevelOfSensitivity = "Grab/MinimumLevelOfSensitivity";
+static const QString ColorsChangeThreshold = "Grab/ColorsChangeThreshold";
+static const QString IsLinearLightEnabled = "Grab/IsLinearLightEnabled";
 }
 // [MoodLamp]
 namespace MoodLamp
@@ -162,6 +200,21 @@ static const QString Position = "Position";
 static const QString CoefRed = "CoefRed";
 static const QString CoefGreen = "CoefGreen";
 static const QString CoefBlue = "CoefBlue";
+static const QString Weight = "Weight";
+static const QString ExtraZones = "ExtraZones";
+}
+// [EdgeLayout]
+namespace EdgeLayout
+{
+static const QString IsEnabled = "EdgeLayout/IsEnabled";
+static const QString Leds[::EdgeLayout::SidesCount] = {
+    "EdgeLayout/LedsLeft",
+    "EdgeLayout/LedsTop",
+    "EdgeLayout/LedsRight",
+    "EdgeLayout/LedsBottom"
+};
+static const QString Depth = "EdgeLayout/Depth";
+static const QString Inset = "EdgeLayout/Inset";
 }
 } /*Key*/
 
@@ -239,8 +292,18 @@ void Settings::Initialize( const QString & applicationDirPath, bool isDebugLevel
     setNewOptionMain(Main::Key::Adalight::NumberOfLeds,     Main::Adalight::NumberOfLedsDefault);
     setNewOptionMain(Main::Key::Ardulight::NumberOfLeds,    Main::Ardulight::NumberOfLedsDefault);
     setNewOptionMain(Main::Key::AlienFx::NumberOfLeds,      Main::AlienFx::NumberOfLedsDefault);
+    setNewOptionMain(Main::Key::ExtraDevices::Devices,      Main::ExtraDevices::DevicesDefault);
     setNewOptionMain(Main::Key::Lightpack::NumberOfLeds,    Main::Lightpack::NumberOfLedsDefault);
     setNewOptionMain(Main::Key::Virtual::NumberOfLeds,      Main::Virtual::NumberOfLedsDefault);
+    setNewOptionMain(Main::Key::Udp::NumberOfLeds,          Main::Udp::NumberOfLedsDefault);
+    setNewOptionMain(Main::Key::E131::NumberOfLeds,         Main::E131::NumberOfLedsDefault);
+    setNewOptionMain(Main::Key::ArtNet::NumberOfLeds,       Main::ArtNet::NumberOfLedsDefault);
+
+    // Network device configuration
+    setNewOptionMain(Main::Key::Udp::Host,              Main::Udp::HostDefault);
+    setNewOptionMain(Main::Key::Udp::Port,              Main::Udp::PortDefault);
+    setNewOptionMain(Main::Key::Dmx::Host,              Main::Dmx::HostDefault);
+    setNewOptionMain(Main::Key::Dmx::StartUniverse,     Main::Dmx::StartUniverseDefault);
 
     if (isDebugLevelObtainedFromCmdArgs == false)
     {
@@ -412,34 +475,62 @@ QString Settings::getApplicationDirPath()
     return m_applicationDirPath;
 }
 
-QPoint Settings::getDefaultPosition(int ledIndex)
+QRect Settings::getDefaultRect(int ledIndex)
 {
-    QPoint result;
+    int ledsCount = qMax(getNumberOfLedsInFrame(), ledIndex + 1);
 
-    if (ledIndex > (MaximumNumberOfLeds::Default - 1))
-    {
-        int x = (ledIndex - MaximumNumberOfLeds::Default) * 10 /* px */;
-        return QPoint(x, 0);
-    }
+    return getDefaultRects(ledsCount).value(ledIndex);
+}
 
-    QRect screen = QApplication::desktop()->screenGeometry();
+// Up to MaximumNumberOfLeds::Default LEDs are placed in two columns on the
+// left and right sides of the screen, more LEDs are spread along all edges
+// like LedLayout::edges() does, in proportion to length of sides
+QList<QRect> Settings::getDefaultRects(int ledsCount)
+{
+    QList<QRect> rects;
 
-    int ledsCountDiv2 = MaximumNumberOfLeds::Default / 2;
+    QRect screen = QApplication::desktop()->screenGeometry();
 
-    if (ledIndex < ledsCountDiv2)
+    if (ledsCount > MaximumNumberOfLeds::Default)
     {
-        result.setX(0);
-    } else {
-        result.setX(screen.width() - Profile::Led::SizeDefault.width());
+        int ledsPerSide[EdgeLayout::SidesCount];
+
+        ledsPerSide[EdgeLayout::Left] = ledsCount * screen.height() / (2 * (screen.width() + screen.height()));
+        ledsPerSide[EdgeLayout::Right] = ledsPerSide[EdgeLayout::Left];
+        ledsPerSide[EdgeLayout::Bottom] = (ledsCount - 2 * ledsPerSide[EdgeLayout::Left]) / 2;
+        ledsPerSide[EdgeLayout::Top] = ledsCount - 2 * ledsPerSide[EdgeLayout::Left] - ledsPerSide[EdgeLayout::Bottom];
+
+        rects = LedLayout::edges(screen, ledsPerSide, Profile::EdgeLayout::DepthDefault, Profile::EdgeLayout::InsetDefault);
+
+        while (rects.count() < ledsCount)
+            rects << QRect(screen.topLeft(), Profile::Led::SizeDefault);
+
+        return rects;
     }
 
+    int ledsCountDiv2 = MaximumNumberOfLeds::Default / 2;
+
     int height = ledsCountDiv2 * Profile::Led::SizeDefault.height();
 
     int y = screen.height() / 2 - height / 2;
 
-    result.setY(y + (ledIndex % ledsCountDiv2) * Profile::Led::SizeDefault.height());
+    for (int ledIndex = 0; ledIndex < ledsCount; ledIndex++)
+    {
+        QPoint result;
+
+        if (ledIndex < ledsCountDiv2)
+        {
+            result.setX(0);
+        } else {
+            result.setX(screen.width() - Profile::Led::SizeDefault.width());
+        }
+
+        result.setY(y + (ledIndex % ledsCountDiv2) * Profile::Led::SizeDefault.height());
 
-    return result;
+        rects << QRect(result, Profile::Led::SizeDefault);
+    }
+
+    return rects;
 }
 
 QString Settings::getLastProfileName()
@@ -579,6 +670,8 @@ void Settings::setConnectedDevice(SupportedDevices::DeviceType device)
     QString deviceName = m_devicesTypeToNameMap.value(device, Main::ConnectedDeviceDefault);
 
     setValueMain(Main::Key::ConnectedDevice, deviceName);
+
+    initLedRects(false);
 }
 
 QString Settings::getConnectedDeviceName()
@@ -598,6 +691,8 @@ void Settings::setConnectedDeviceName(const QString & deviceName)
     }
 
     setValueMain(Main::Key::ConnectedDevice, deviceName);
+
+    initLedRects(false);
 }
 
 QStringList Settings::getSupportedDevices()
@@ -656,6 +751,62 @@ QStringList Settings::getSupportedSerialPortBaudRates()
     return list;
 }
 
+QString Settings::getUdpHost()
+{
+    return valueMain(Main::Key::Udp::Host).toString();
+}
+
+void Settings::setUdpHost(const QString & host)
+{
+    setValueMain(Main::Key::Udp::Host, host);
+}
+
+int Settings::getUdpPort()
+{
+    bool ok = false;
+    int port = valueMain(Main::Key::Udp::Port).toInt(&ok);
+
+    if (ok == false || port <= 0 || port > 0xffff)
+    {
+        qWarning() << Q_FUNC_INFO << "Udp/Port in config has an invalid value, use the default" << Main::Udp::PortDefault;
+        return Main::Udp::PortDefault;
+    }
+    return port;
+}
+
+void Settings::setUdpPort(int port)
+{
+    setValueMain(Main::Key::Udp::Port, port);
+}
+
+QString Settings::getDmxHost()
+{
+    return valueMain(Main::Key::Dmx::Host).toString();
+}
+
+void Settings::setDmxHost(const QString & host)
+{
+    setValueMain(Main::Key::Dmx::Host, host);
+}
+
+int Settings::getDmxStartUniverse()
+{
+    bool ok = false;
+    int universe = valueMain(Main::Key::Dmx::StartUniverse).toInt(&ok);
+
+    if (ok == false || universe < 0)
+    {
+        qWarning() << Q_FUNC_INFO << "Dmx/StartUniverse in config has an invalid value, use the default" << Main::Dmx::StartUniverseDefault;
+        return Main::Dmx::StartUniverseDefault;
+    }
+    return universe;
+}
+
+void Settings::setDmxStartUniverse(int universe)
+{
+    setValueMain(Main::Key::Dmx::StartUniverse, universe);
+}
+
 bool Settings::isConnectedDeviceUsesSerialPort()
 {
     switch (getConnectedDevice())
@@ -680,6 +831,8 @@ void Settings::setNumberOfLeds(SupportedDevices::DeviceType device, int numberOf
     }
 
     setValueMain(key, numberOfLeds);
+
+    initLedRects(false);
 }
 
 int Settings::getNumberOfLeds(SupportedDevices::DeviceType device)
@@ -696,6 +849,110 @@ int Settings::getNumberOfLeds(SupportedDevices::DeviceType device)
     return valueMain(key).toInt();
 }
 
+QList<ExtraLedDevice> Settings::getExtraLedDevices()
+{
+    QList<ExtraLedDevice> devices;
+    QStringList list = valueMain(Main::Key::ExtraDevices::Devices).toStringList();
+
+    for (int i = 0; i < list.count(); i++)
+    {
+        if (list[i].isEmpty())
+            continue;
+
+        QStringList fields = list[i].split(':');
+        ExtraLedDevice device;
+        bool okFirst = false, okCount = false;
+
+        device.type = m_devicesTypeToNameMap.key(fields.value(0), SupportedDevices::DevicesCount);
+        device.firstLed = fields.value(1).toInt(&okFirst);
+        device.ledsCount = fields.value(2).toInt(&okCount);
+        device.serialPortName = fields.value(3);
+        device.serialPortBaudRate = fields.value(4);
+
+        QString groupKey = Main::Key::ExtraDevice::Prefix + QString::number(i + 1) + "/";
+
+        if (device.type == SupportedDevices::UdpDevice)
+        {
+            device.host = valueMain(groupKey + Main::Key::ExtraDevice::Host).toString();
+            device.port = valueMain(groupKey + Main::Key::ExtraDevice::Port).toInt();
+        }
+        else if (device.type == SupportedDevices::E131Device || device.type == SupportedDevices::ArtNetDevice)
+        {
+            device.host = valueMain(groupKey + Main::Key::ExtraDevice::Host).toString();
+            device.startUniverse = valueMain(groupKey + Main::Key::ExtraDevice::StartUniverse).toInt();
+        }
+
+        if (device.type == SupportedDevices::DevicesCount || !okFirst || !okCount
+                || device.firstLed < 0 || device.ledsCount < 1
+                || device.firstLed + device.ledsCount > MaximumNumberOfLeds::AbsoluteMaximum)
+        {
+            qWarning() << Q_FUNC_INFO << Main::Key::ExtraDevices::Devices << "contains crap:" << list[i] << ", skip it";
+            continue;
+        }
+
+        devices << device;
+    }
+
+    return devices;
+}
+
+void Settings::setExtraLedDevices(const QList<ExtraLedDevice> & devices)
+{
+    QStringList list;
+
+    // Network settings of removed and changed devices
+    int oldCount = qMax(valueMain(Main::Key::ExtraDevices::Devices).toStringList().count(), devices.count());
+    for (int i = 0; i < oldCount; i++)
+        removeMain(Main::Key::ExtraDevice::Prefix + QString::number(i + 1));
+
+    for (int i = 0; i < devices.count(); i++)
+    {
+        QStringList fields;
+
+        fields << m_devicesTypeToNameMap.value(devices[i].type)
+               << QString::number(devices[i].firstLed)
+               << QString::number(devices[i].ledsCount);
+
+        if (devices[i].serialPortName.isEmpty() == false)
+            fields << devices[i].serialPortName << devices[i].serialPortBaudRate;
+
+        list << fields.join(":");
+
+        QString groupKey = Main::Key::ExtraDevice::Prefix + QString::number(i + 1) + "/";
+
+        if (devices[i].type == SupportedDevices::UdpDevice)
+        {
+            if (devices[i].host.isEmpty() == false)
+                setValueMain(groupKey + Main::Key::ExtraDevice::Host, devices[i].host);
+            if (devices[i].port > 0)
+                setValueMain(groupKey + Main::Key::ExtraDevice::Port, devices[i].port);
+        }
+        else if (devices[i].type == SupportedDevices::E131Device || devices[i].type == SupportedDevices::ArtNetDevice)
+        {
+            if (devices[i].host.isEmpty() == false)
+                setValueMain(groupKey + Main::Key::ExtraDevice::Host, devices[i].host);
+            if (devices[i].startUniverse > 0)
+                setValueMain(groupKey + Main::Key::ExtraDevice::StartUniverse, devices[i].startUniverse);
+        }
+    }
+
+    setValueMain(Main::Key::ExtraDevices::Devices, list);
+
+    initLedRects(false);
+}
+
+int Settings::getNumberOfLedsInFrame()
+{
+    int numberOfLeds = getNumberOfLeds(getConnectedDevice());
+
+    QList<ExtraLedDevice> devices = getExtraLedDevices();
+
+    for (int i = 0; i < devices.count(); i++)
+        numberOfLeds = qMax(numberOfLeds, devices[i].firstLed + devices[i].ledsCount);
+
+    return numberOfLeds;
+}
+
 int Settings::getGrabSlowdown()
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO;
@@ -748,6 +1005,26 @@ void Settings::setGrabMinimumLevelOfSensitivity(int value)
     setValue(Profile::Key::Grab::MinimumLevelOfSensitivity, value);
 }
 
+int Settings::getGrabColorsChangeThreshold()
+{
+    return getValidGrabColorsChangeThreshold(value(Profile::Key::Grab::ColorsChangeThreshold).toInt());
+}
+
+void Settings::setGrabColorsChangeThreshold(int value)
+{
+    setValue(Profile::Key::Grab::ColorsChangeThreshold, getValidGrabColorsChangeThreshold(value));
+}
+
+bool Settings::isGrabLinearLightEnabled()
+{
+    return value(Profile::Key::Grab::IsLinearLightEnabled).toBool();
+}
+
+void Settings::setGrabLinearLightEnabled(bool isEnabled)
+{
+    setValue(Profile::Key::Grab::IsLinearLightEnabled, isEnabled);
+}
+
 int Settings::getDeviceRefreshDelay()
 {
     return getValidDeviceRefreshDelay(value(Profile::Key::Device::RefreshDelay).toInt());
@@ -995,7 +1272,11 @@ void Settings::setLedCoefBlue(int ledIndex, double value)
 
 QSize Settings::getLedSize(int ledIndex)
 {
-    return value(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::Size).toSize();
+    QVariant result = value(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::Size);
+    if (result.isNull())
+        return getDefaultRect(ledIndex).size();
+    else
+        return result.toSize();
 }
 
 void Settings::setLedSize(int ledIndex, QSize size)
@@ -1005,7 +1286,11 @@ void Settings::setLedSize(int ledIndex, QSize size)
 
 QPoint Settings::getLedPosition(int ledIndex)
 {
-    return value(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::Position).toPoint();
+    QVariant result = value(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::Position);
+    if (result.isNull())
+        return getDefaultRect(ledIndex).topLeft();
+    else
+        return result.toPoint();
 }
 
 void Settings::setLedPosition(int ledIndex, QPoint position)
@@ -1027,6 +1312,112 @@ void Settings::setLedEnabled(int ledIndex, bool isEnabled)
     setValue(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::IsEnabled, isEnabled);
 }
 
+int Settings::getLedWeight(int ledIndex)
+{
+    QVariant result = value(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::Weight);
+    if (result.isNull())
+        return Profile::Led::WeightDefault;
+    else
+        return getValidLedWeight(result.toInt());
+}
+
+void Settings::setLedWeight(int ledIndex, int weight)
+{
+    setValue(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::Weight, getValidLedWeight(weight));
+}
+
+// Extra zones are stored as list of "x y width height weight" strings, for
+// example "ExtraZones=0 0 100 50 2, 100 0 100 50", weight can be omitted.
+// Invalid zones are skipped.
+QList<SamplingZone> Settings::getLedExtraZones(int ledIndex)
+{
+    QString key = Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::ExtraZones;
+    QStringList zonesStrings = value(key).toStringList();
+    QList<SamplingZone> zones;
+
+    for (int i = 0; i < zonesStrings.count(); i++)
+    {
+        QStringList values = zonesStrings[i].split(' ', QString::SkipEmptyParts);
+        QList<int> numbers;
+
+        for (int k = 0; k < values.count(); k++)
+        {
+            bool ok = false;
+            numbers << values[k].trimmed().toInt(&ok);
+            if (!ok)
+                break;
+        }
+
+        if (numbers.count() != values.count() || (numbers.count() != 4 && numbers.count() != 5) ||
+                numbers[2] <= 0 || numbers[3] <= 0)
+        {
+            qWarning() << Q_FUNC_INFO << "Invalid zone" << zonesStrings[i] << "in" << key;
+            continue;
+        }
+
+        int weight = (numbers.count() == 5) ? getValidLedWeight(numbers[4]) : Profile::Led::WeightDefault;
+
+        zones << SamplingZone(QRect(numbers[0], numbers[1], numbers[2], numbers[3]), weight);
+    }
+
+    return zones;
+}
+
+void Settings::setLedExtraZones(int ledIndex, const QList<SamplingZone> & zones)
+{
+    QString key = Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + Profile::Key::Led::ExtraZones;
+    QStringList zonesStrings;
+
+    for (int i = 0; i < zones.count(); i++)
+    {
+        const QRect & rect = zones[i].rect;
+        zonesStrings << QString("%1 %2 %3 %4 %5").arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height())
+                        .arg(getValidLedWeight(zones[i].weight));
+    }
+
+    setValue(key, zonesStrings);
+}
+
+bool Settings::isEdgeLayoutEnabled()
+{
+    return value(Profile::Key::EdgeLayout::IsEnabled).toBool();
+}
+
+void Settings::setEdgeLayoutEnabled(bool isEnabled)
+{
+    setValue(Profile::Key::EdgeLayout::IsEnabled, isEnabled);
+}
+
+int Settings::getEdgeLayoutLeds(EdgeLayout::Side side)
+{
+    return getValidEdgeLayoutLeds(value(Profile::Key::EdgeLayout::Leds[side]).toInt());
+}
+
+void Settings::setEdgeLayoutLeds(EdgeLayout::Side side, int value)
+{
+    setValue(Profile::Key::EdgeLayout::Leds[side], getValidEdgeLayoutLeds(value));
+}
+
+int Settings::getEdgeLayoutDepth()
+{
+    return getValidEdgeLayoutDepth(value(Profile::Key::EdgeLayout::Depth).toInt());
+}
+
+void Settings::setEdgeLayoutDepth(int value)
+{
+    setValue(Profile::Key::EdgeLayout::Depth, getValidEdgeLayoutDepth(value));
+}
+
+int Settings::getEdgeLayoutInset()
+{
+    return getValidEdgeLayoutInset(value(Profile::Key::EdgeLayout::Inset).toInt());
+}
+
+void Settings::setEdgeLayoutInset(int value)
+{
+    setValue(Profile::Key::EdgeLayout::Inset, getValidEdgeLayoutInset(value));
+}
+
 int Settings::getValidDeviceRefreshDelay(int value)
 {
     if (value < Profile::Device::RefreshDelayMin)
@@ -1081,6 +1472,42 @@ int Settings::getValidGrabSlowdown(int value)
     return value;
 }
 
+int Settings::getValidGrabColorsChangeThreshold(int value)
+{
+    if (value < Profile::Grab::ColorsChangeThresholdMin)
+        value = Profile::Grab::ColorsChangeThresholdMin;
+    else if (value > Profile::Grab::ColorsChangeThresholdMax)
+        value = Profile::Grab::ColorsChangeThresholdMax;
+    return value;
+}
+
+int Settings::getValidEdgeLayoutLeds(int value)
+{
+    if (value < Profile::EdgeLayout::LedsMin)
+        value = Profile::EdgeLayout::LedsMin;
+    else if (value > Profile::EdgeLayout::LedsMax)
+        value = Profile::EdgeLayout::LedsMax;
+    return value;
+}
+
+int Settings::getValidEdgeLayoutDepth(int value)
+{
+    if (value < Profile::EdgeLayout::DepthMin)
+        value = Profile::EdgeLayout::DepthMin;
+    else if (value > Profile::EdgeLayout::DepthMax)
+        value = Profile::EdgeLayout::DepthMax;
+    return value;
+}
+
+int Settings::getValidEdgeLayoutInset(int value)
+{
+    if (value < Profile::EdgeLayout::InsetMin)
+        value = Profile::EdgeLayout::InsetMin;
+    else if (value > Profile::EdgeLayout::InsetMax)
+        value = Profile::EdgeLayout::InsetMax;
+    return value;
+}
+
 int Settings::getValidMoodLampSpeed(int value)
 {
     if (value < Profile::MoodLamp::SpeedMin)
@@ -1090,6 +1517,15 @@ int Settings::getValidMoodLampSpeed(int value)
     return value;
 }
 
+int Settings::getValidLedWeight(int value)
+{
+    if (value < Profile::Led::WeightMin)
+        value = Profile::Led::WeightMin;
+    else if (value > Profile::Led::WeightMax)
+        value = Profile::Led::WeightMax;
+    return value;
+}
+
 void Settings::setValidLedCoef(int ledIndex, const QString & keyCoef, double coef)
 {
     if (coef < Profile::Led::CoefMin || coef > Profile::Led::CoefMax){
@@ -1108,8 +1544,14 @@ void Settings::setValidLedCoef(int ledIndex, const QString & keyCoef, double coe
 
 double Settings::getValidLedCoef(int ledIndex, const QString & keyCoef)
 {
+    QVariant result = Settings::value(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + keyCoef);
+
+    // LED added after profile was initialized
+    if (result.isNull())
+        return Profile::Led::CoefDefault;
+
     bool ok = false;
-    double coef = Settings::value(Profile::Key::Led::Prefix + QString::number(ledIndex + 1) + "/" + keyCoef).toDouble(&ok);
+    double coef = result.toDouble(&ok);
     QString error;
     if (ok == false){
         error = "Error: Convert to double.";
@@ -1147,6 +1589,8 @@ void Settings::initCurrentProfile(bool isResetDefault)
     setNewOption(Profile::Key::Grab::IsSendDataOnlyIfColorsChanges, Profile::Grab::IsSendDataOnlyIfColorsChangesDefault, isResetDefault);
     setNewOption(Profile::Key::Grab::Slowdown,      Profile::Grab::SlowdownDefault, isResetDefault);
     setNewOption(Profile::Key::Grab::MinimumLevelOfSensitivity, Profile::Grab::MinimumLevelOfSensitivityDefault, isResetDefault);
+    setNewOption(Profile::Key::Grab::ColorsChangeThreshold, Profile::Grab::ColorsChangeThresholdDefault, isResetDefault);
+    setNewOption(Profile::Key::Grab::IsLinearLightEnabled, Profile::Grab::IsLinearLightEnabledDefault, isResetDefault);
     // [MoodLamp]
     setNewOption(Profile::Key::MoodLamp::IsLiquidMode,  Profile::MoodLamp::IsLiquidMode, isResetDefault);
     setNewOption(Profile::Key::MoodLamp::Color,         Profile::MoodLamp::ColorDefault, isResetDefault);
@@ -1158,18 +1602,24 @@ void Settings::initCurrentProfile(bool isResetDefault)
     setNewOption(Profile::Key::Device::Gamma,       Profile::Device::GammaDefault, isResetDefault);
     setNewOption(Profile::Key::Device::ColorDepth,  Profile::Device::ColorDepthDefault, isResetDefault);
 
-    QPoint ledPosition;
+    // [EdgeLayout]
+    setNewOption(Profile::Key::EdgeLayout::IsEnabled,   Profile::EdgeLayout::IsEnabledDefault, isResetDefault);
+    setNewOption(Profile::Key::EdgeLayout::Leds[EdgeLayout::Left],   Profile::EdgeLayout::LedsLeftDefault, isResetDefault);
+    setNewOption(Profile::Key::EdgeLayout::Leds[EdgeLayout::Top],    Profile::EdgeLayout::LedsTopDefault, isResetDefault);
+    setNewOption(Profile::Key::EdgeLayout::Leds[EdgeLayout::Right],  Profile::EdgeLayout::LedsRightDefault, isResetDefault);
+    setNewOption(Profile::Key::EdgeLayout::Leds[EdgeLayout::Bottom], Profile::EdgeLayout::LedsBottomDefault, isResetDefault);
+    setNewOption(Profile::Key::EdgeLayout::Depth,       Profile::EdgeLayout::DepthDefault, isResetDefault);
+    setNewOption(Profile::Key::EdgeLayout::Inset,       Profile::EdgeLayout::InsetDefault, isResetDefault);
 
-    for (int i = 0; i < MaximumNumberOfLeds::AbsoluteMaximum; i++)
-    {
-        ledPosition = getDefaultPosition(i);
+    initLedRects(isResetDefault);
+
+    // Keys of LEDs added later are missing, their getters return defaults
+    int numberOfLeds = getNumberOfLedsInFrame();
 
+    for (int i = 0; i < numberOfLeds; i++)
+    {
         setNewOption(Profile::Key::Led::Prefix + QString::number(i + 1) + "/" + Profile::Key::Led::IsEnabled,
                      Profile::Led::IsEnabledDefault, isResetDefault);
-        setNewOption(Profile::Key::Led::Prefix + QString::number(i + 1) + "/" + Profile::Key::Led::Position,
-                     ledPosition, isResetDefault);
-        setNewOption(Profile::Key::Led::Prefix + QString::number(i + 1) + "/" + Profile::Key::Led::Size,
-                     Profile::Led::SizeDefault, isResetDefault);
 
         setNewOption(Profile::Key::Led::Prefix + QString::number(i + 1) + "/" + Profile::Key::Led::CoefRed,
                      Profile::Led::CoefDefault, isResetDefault);
@@ -1183,6 +1633,69 @@ void Settings::initCurrentProfile(bool isResetDefault)
     m_currentProfile->sync();
 }
 
+// Default rects depend on number of LEDs in frame, so when it changes all
+// rects still equal to defaults of the previous number are regenerated and
+// LEDs placed by user keep their rects. Reset removes LEDs out of frame.
+void Settings::initLedRects(bool isResetDefault)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << isResetDefault;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_currentProfile == NULL)
+            return;
+    }
+
+    int numberOfLeds = getNumberOfLedsInFrame();
+
+    QVariant layoutNumberOfLeds = value(Profile::Key::DefaultLayoutNumberOfLeds);
+    int oldNumberOfLeds = layoutNumberOfLeds.isNull() ? numberOfLeds : layoutNumberOfLeds.toInt();
+
+    if (isResetDefault == false && oldNumberOfLeds == numberOfLeds && layoutNumberOfLeds.isNull() == false)
+        return;
+
+    if (isResetDefault)
+    {
+        for (int i = numberOfLeds; i < MaximumNumberOfLeds::AbsoluteMaximum; i++)
+            remove(Profile::Key::Led::Prefix + QString::number(i + 1));
+    }
+
+    QList<QRect> oldRects = getDefaultRects(oldNumberOfLeds);
+    QList<QRect> newRects = getDefaultRects(numberOfLeds);
+
+    int count = isResetDefault ? numberOfLeds : qMax(numberOfLeds, oldNumberOfLeds);
+
+    for (int i = 0; i < count; i++)
+    {
+        QString positionKey = Profile::Key::Led::Prefix + QString::number(i + 1) + "/" + Profile::Key::Led::Position;
+        QString sizeKey = Profile::Key::Led::Prefix + QString::number(i + 1) + "/" + Profile::Key::Led::Size;
+
+        if (isResetDefault == false)
+        {
+            QVariant position = value(positionKey);
+            QVariant size = value(sizeKey);
+            QRect oldRect = oldRects.value(i);
+
+            if (position.isNull() == false && position.toPoint() != oldRect.topLeft())
+                continue;
+            if (size.isNull() == false && size.toSize() != oldRect.size())
+                continue;
+        }
+
+        if (i < numberOfLeds)
+        {
+            setValue(positionKey, newRects[i].topLeft());
+            setValue(sizeKey, newRects[i].size());
+        } else {
+            // Default rect of previous number, will be regenerated if LED comes back
+            remove(positionKey);
+            remove(sizeKey);
+        }
+    }
+
+    setValue(Profile::Key::DefaultLayoutNumberOfLeds, numberOfLeds);
+}
+
 
 void Settings::setNewOption(const QString & name, const QVariant & value,
                                         bool isForceSetOption, QSettings * settings /*= m_currentProfile*/)
@@ -1237,6 +1750,20 @@ QVariant Settings::valueMain(const QString & key)
     return m_mainConfig->value(key);
 }
 
+void Settings::removeMain(const QString & key)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << key;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_mainConfig == NULL)
+    {
+        qWarning() << Q_FUNC_INFO << "m_mainConfig == NULL";
+        return;
+    }
+    m_mainConfig->remove(key);
+}
+
 void Settings::setValue(const QString & key, const QVariant & value)
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << key;
@@ -1251,6 +1778,20 @@ void Settings::setValue(const QString & key, const QVariant & value)
     m_currentProfile->setValue(key, value);
 }
 
+void Settings::remove(const QString & key)
+{
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << key;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_currentProfile == NULL)
+    {
+        qWarning() << Q_FUNC_INFO << "m_currentProfile == NULL";
+        return;
+    }
+    m_currentProfile->remove(key);
+}
+
 QVariant Settings::value(const QString & key)
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO << key;
@@ -1273,11 +1814,17 @@ void Settings::initDevicesMap()
     m_devicesTypeToNameMap[SupportedDevices::ArdulightDevice] = Main::Value::ConnectedDevice::ArdulightDevice;
     m_devicesTypeToNameMap[SupportedDevices::LightpackDevice] = Main::Value::ConnectedDevice::LightpackDevice;
     m_devicesTypeToNameMap[SupportedDevices::VirtualDevice]   = Main::Value::ConnectedDevice::VirtualDevice;
+    m_devicesTypeToNameMap[SupportedDevices::UdpDevice]       = Main::Value::ConnectedDevice::UdpDevice;
+    m_devicesTypeToNameMap[SupportedDevices::E131Device]      = Main::Value::ConnectedDevice::E131Device;
+    m_devicesTypeToNameMap[SupportedDevices::ArtNetDevice]    = Main::Value::ConnectedDevice::ArtNetDevice;
 
     m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::AdalightDevice]  = Main::Key::Adalight::NumberOfLeds;
     m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::ArdulightDevice] = Main::Key::Ardulight::NumberOfLeds;
     m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::LightpackDevice] = Main::Key::Lightpack::NumberOfLeds;
     m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::VirtualDevice]   = Main::Key::Virtual::NumberOfLeds;
+    m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::UdpDevice]       = Main::Key::Udp::NumberOfLeds;
+    m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::E131Device]      = Main::Key::E131::NumberOfLeds;
+    m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::ArtNetDevice]    = Main::Key::ArtNet::NumberOfLeds;
 
 #ifdef ALIEN_FX_SUPPORTED
     m_devicesTypeToNameMap[SupportedDevices::AlienFxDevice]   = Main::Value::ConnectedDevice::AlienFxDevice;
@@ -31,6 +31,7 @@
 #include <QMutex>
 
 #include "SettingsDefaults.hpp"
+#include "LedSamplingMatrix.hpp"
 #include "enums.hpp"
 #include "defs.h"
 #include "debug.h"
@@ -38,6 +39,23 @@
 namespace SettingsScope
 {
 
+// LED device driven in parallel with the connected one, it shows
+// LEDs [firstLed, firstLed + ledsCount) of each frame
+struct ExtraLedDevice
+{
+    SupportedDevices::DeviceType type;
+    int firstLed;
+    int ledsCount;
+    // Empty strings and zero numbers mean using of connected device settings
+    QString serialPortName;
+    QString serialPortBaudRate;
+    QString host;               // Udp, E131 and ArtNet
+    int port;                   // Udp
+    int startUniverse;          // E131 and ArtNet
+
+    ExtraLedDevice() { type = SupportedDevices::DevicesCount; firstLed = 0; ledsCount = 0; port = 0; startUniverse = 0; }
+};
+
 class Settings : public QObject
 {
     Q_OBJECT
@@ -54,7 +72,7 @@ public:
     static QString getCurrentProfileName();
     static QString getCurrentProfilePath();
     static QString getApplicationDirPath();
-    static QPoint getDefaultPosition(int ledIndex);
+    static QRect getDefaultRect(int ledIndex);
 
     // Main
     static QString getLastProfileName();
@@ -92,9 +110,24 @@ public:
     static void setSerialPortBaudRate(const QString & baud);
     static QStringList getSupportedSerialPortBaudRates();
     static bool isConnectedDeviceUsesSerialPort();
+    // [Udp]
+    static QString getUdpHost();
+    static void setUdpHost(const QString & host);
+    static int getUdpPort();
+    static void setUdpPort(int port);
+    // [Dmx]
+    static QString getDmxHost();
+    static void setDmxHost(const QString & host);
+    static int getDmxStartUniverse();
+    static void setDmxStartUniverse(int universe);
     // [Adalight | Ardulight | Lightpack | ... | Virtual]
     static void setNumberOfLeds(SupportedDevices::DeviceType device, int numberOfLeds);
     static int getNumberOfLeds(SupportedDevices::DeviceType device);
+    // [ExtraDevices]
+    static QList<ExtraLedDevice> getExtraLedDevices();
+    static void setExtraLedDevices(const QList<ExtraLedDevice> & devices);
+    // Connected device and all extra devices
+    static int getNumberOfLedsInFrame();
 
 
     // Profile
@@ -108,6 +141,10 @@ public:
     static void setSendDataOnlyIfColorsChanges(bool isEnabled);
     static int getGrabMinimumLevelOfSensitivity();
     static void setGrabMinimumLevelOfSensitivity(int value);
+    static int getGrabColorsChangeThreshold();
+    static void setGrabColorsChangeThreshold(int value);
+    static bool isGrabLinearLightEnabled();
+    static void setGrabLinearLightEnabled(bool isEnabled);
     // [Device]
     static int getDeviceRefreshDelay();
     static void setDeviceRefreshDelay(int value);
@@ -145,6 +182,19 @@ public:
     static void setLedPosition(int ledIndex, QPoint position);
     static bool isLedEnabled(int ledIndex);
     static void setLedEnabled(int ledIndex, bool isEnabled);
+    static int getLedWeight(int ledIndex);
+    static void setLedWeight(int ledIndex, int weight);
+    static QList<SamplingZone> getLedExtraZones(int ledIndex);
+    static void setLedExtraZones(int ledIndex, const QList<SamplingZone> & zones);
+
+    static bool isEdgeLayoutEnabled();
+    static void setEdgeLayoutEnabled(bool isEnabled);
+    static int getEdgeLayoutLeds(EdgeLayout::Side side);
+    static void setEdgeLayoutLeds(EdgeLayout::Side side, int value);
+    static int getEdgeLayoutDepth();
+    static void setEdgeLayoutDepth(int value);
+    static int getEdgeLayoutInset();
+    static void setEdgeLayoutInset(int value);
 
 private:        
     static int getValidDeviceRefreshDelay(int value);
@@ -153,11 +203,18 @@ private:
     static int getValidDeviceColorDepth(int value);
     static double getValidDeviceGamma(double value);
     static int getValidGrabSlowdown(int value);
+    static int getValidGrabColorsChangeThreshold(int value);
+    static int getValidEdgeLayoutLeds(int value);
+    static int getValidEdgeLayoutDepth(int value);
+    static int getValidEdgeLayoutInset(int value);
     static int getValidMoodLampSpeed(int value);
+    static int getValidLedWeight(int value);
     static void setValidLedCoef(int ledIndex, const QString & keyCoef, double coef);
     static double getValidLedCoef(int ledIndex, const QString & keyCoef);
 
     static void initCurrentProfile(bool isResetDefault);
+    static void initLedRects(bool isResetDefault);
+    static QList<QRect> getDefaultRects(int ledsCount);
     static void setNewOption(const QString & name, const QVariant & value,
                             bool isForceSetOption = false, QSettings * settings = m_currentProfile);
     static void setNewOptionMain(const QString & name, const QVariant & value,
@@ -165,9 +222,11 @@ private:
     // forwarding to m_mainConfig object
     static void setValueMain(const QString & key, const QVariant & value);
     static QVariant valueMain(const QString & key);
+    static void removeMain(const QString & key);
     // forwarding to m_currentProfile object
     static void setValue(const QString & key, const QVariant & value);
     static QVariant value(const QString & key);
+    static void remove(const QString & key);
 
     static void initDevicesMap();
 
@@ -27,14 +27,15 @@
 
 #include <QSize>
 #include <QString>
+#include <QStringList>
 #include "debug.h"
 #include "defs.h"
 #include "enums.hpp"
 
 #ifdef ALIEN_FX_SUPPORTED
-#   define SUPPORTED_DEVICES            "Lightpack,AlienFx,Adalight,Ardulight,Virtual"
+#   define SUPPORTED_DEVICES            "Lightpack,AlienFx,Adalight,Ardulight,Udp,E131,ArtNet,Virtual"
 #else
-#   define SUPPORTED_DEVICES            "Lightpack,Adalight,Ardulight,Virtual"
+#   define SUPPORTED_DEVICES            "Lightpack,Adalight,Ardulight,Udp,E131,ArtNet,Virtual"
 #endif
 
 #ifdef WINAPI_GRAB_SUPPORT
@@ -114,6 +115,35 @@ namespace Virtual
 {
 static const int NumberOfLedsDefault = 10;
 }
+// [Udp]
+namespace Udp
+{
+static const QString HostDefault = "192.168.4.1"; /* ESP8266 access point */
+static const int PortDefault = 21324;
+static const int NumberOfLedsDefault = 25;
+}
+// [Dmx] common for E1.31 and Art-Net
+namespace Dmx
+{
+static const QString HostDefault = "192.168.1.100";
+static const int StartUniverseDefault = 1;
+}
+namespace E131
+{
+static const int NumberOfLedsDefault = 170; /* one universe */
+}
+namespace ArtNet
+{
+static const int NumberOfLedsDefault = 170;
+}
+// [ExtraDevices]
+namespace ExtraDevices
+{
+// List of "DeviceName:FirstLed:LedsCount[:SerialPort:BaudRate]", network
+// settings of i-th device are ExtraDevice_i/Host, Port (Udp) and
+// StartUniverse (E131 and ArtNet)
+static const QStringList DevicesDefault = QStringList();
+}
 }
 
 // ProfileName.ini
@@ -136,6 +166,11 @@ static const int SlowdownMax = 1000;
 static const int MinimumLevelOfSensitivityMin = 1;
 static const int MinimumLevelOfSensitivityDefault = 3;
 static const int MinimumLevelOfSensitivityMax = 50;
+static const int ColorsChangeThresholdMin = 0;
+// Zero sends every change as before, higher values are opt-in
+static const int ColorsChangeThresholdDefault = 0;
+static const int ColorsChangeThresholdMax = 50;
+static const bool IsLinearLightEnabledDefault = false;
 }
 // [MoodLamp]
 namespace MoodLamp
@@ -177,6 +212,26 @@ static const double CoefMin = 0.0;
 static const double CoefDefault = 1.0;
 static const double CoefMax = 1.0;
 static const QSize SizeDefault = QSize(150, 150);
+static const int WeightMin = 1;
+static const int WeightDefault = 1;
+static const int WeightMax = 100;
+}
+// [EdgeLayout]
+namespace EdgeLayout
+{
+static const bool IsEnabledDefault = false;
+static const int LedsMin = 0;
+static const int LedsLeftDefault = 5;
+static const int LedsTopDefault = 0;
+static const int LedsRightDefault = 5;
+static const int LedsBottomDefault = 0;
+static const int LedsMax = MaximumNumberOfLeds::AbsoluteMaximum;
+static const int DepthMin = 1;
+static const int DepthDefault = 150;
+static const int DepthMax = 2000;
+static const int InsetMin = 0;
+static const int InsetDefault = 0;
+static const int InsetMax = 2000;
 }
 } /*Profile*/
 
@@ -34,6 +34,7 @@
 #include "SpeedTest.hpp"
 #include "ColorButton.hpp"
 #include "LedDeviceFactory.hpp"
+#include "LedDeviceLightpack.hpp"
 #include "enums.hpp"
 #include "debug.h"
 
@@ -56,7 +57,8 @@ const unsigned SettingsWindow::MoodLampModeIndex  = 1;
 SettingsWindow::SettingsWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::SettingsWindow),
-    m_deviceFirmwareVersion(DeviceFirmvareVersionUndef)
+    m_deviceFirmwareVersion(DeviceFirmvareVersionUndef),
+    m_deviceLedsCount(-1)
 {   
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << "thread id: " << this->thread()->currentThreadId();
 
@@ -80,6 +82,9 @@ SettingsWindow::SettingsWindow(QWidget *parent) :
     QRegExpValidator *validatorApiKey = new QRegExpValidator(QRegExp("[a-zA-Z0-9{}_-]*"), this);
     ui->lineEdit_ApiKey->setValidator(validatorApiKey);
 
+    m_virtualLeds = new VirtualLedsWidget(this);
+    ui->gridLayout_VirtualLeds->addWidget(m_virtualLeds, 0, 0);
+
     m_grabManager = new GrabManager(this);
     m_moodlampManager = new MoodLampManager(this);
     m_aboutDialog = new AboutDialog(this);
@@ -151,6 +156,7 @@ void SettingsWindow::connectSignalsSlots()
 
     connect(ui->spinBox_GrabSlowdown, SIGNAL(valueChanged(int)), this, SLOT(onGrabSlowdown_valueChanged(int)));
     connect(ui->spinBox_GrabMinLevelOfSensitivity, SIGNAL(valueChanged(int)), this, SLOT(onGrabMinLevelOfSensivity_valueChanged(int)));
+    connect(ui->spinBox_GrabColorsChangeThreshold, SIGNAL(valueChanged(int)), this, SLOT(onGrabColorsChangeThreshold_valueChanged(int)));
     connect(ui->checkBox_GrabIsAvgColors, SIGNAL(toggled(bool)), this, SLOT(onGrabIsAvgColors_toggled(bool)));
 
     // Connect to GrabManager
@@ -347,6 +353,17 @@ void SettingsWindow::updateDeviceTabWidgetsVisibility()
         setMaximumNumberOfLeds(MaximumNumberOfLeds::Ardulight);
         break;
 
+    case SupportedDevices::UdpDevice:
+        setDeviceTabWidgetsVisibility(DeviceTab::Udp);
+        setMaximumNumberOfLeds(MaximumNumberOfLeds::Udp);
+        break;
+
+    case SupportedDevices::E131Device:
+    case SupportedDevices::ArtNetDevice:
+        setDeviceTabWidgetsVisibility(DeviceTab::Dmx);
+        setMaximumNumberOfLeds(MaximumNumberOfLeds::Dmx);
+        break;
+
     case SupportedDevices::AlienFxDevice:
         setDeviceTabWidgetsVisibility(DeviceTab::AlienFx);
         setMaximumNumberOfLeds(MaximumNumberOfLeds::AlienFx);
@@ -414,7 +431,7 @@ void SettingsWindow::syncLedDeviceWithSettingsWindow()
     emit updateGamma(Settings::getDeviceGamma());
 }
 
-void SettingsWindow::setMaximumNumberOfLeds(MaximumNumberOfLeds::Devices maximumNumberOfLeds)
+void SettingsWindow::setMaximumNumberOfLeds(int maximumNumberOfLeds)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << maximumNumberOfLeds;
 
@@ -447,7 +464,7 @@ int SettingsWindow::getLigtpackFirmwareVersionMajor()
     return majorVersion;
 }
 
-MaximumNumberOfLeds::Devices SettingsWindow::getLightpackMaximumNumberOfLeds()
+int SettingsWindow::getLightpackMaximumNumberOfLeds()
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
@@ -456,6 +473,17 @@ MaximumNumberOfLeds::Devices SettingsWindow::getLightpackMaximumNumberOfLeds()
     if (majorVersion < 0)
         return MaximumNumberOfLeds::Default;
 
+    int minorVersion = m_deviceFirmwareVersion.section('.', 1, 1).toInt();
+
+    // Device drops LEDs it doesn't have, so don't offer more of them
+    if (LedDeviceLightpack::isFramesSupported(majorVersion, minorVersion))
+    {
+        if (m_deviceLedsCount > 0)
+            return qMin(m_deviceLedsCount, (int)MaximumNumberOfLeds::LightpackFramed);
+        else
+            return MaximumNumberOfLeds::LightpackFramed;
+    }
+
     if (majorVersion == 4)
         return MaximumNumberOfLeds::Lightpack4;
     else if (majorVersion == 5)
@@ -745,61 +773,23 @@ void SettingsWindow::initVirtualLeds()
 
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << virtualLedsCount;
 
-    // Remove all virtual leds from grid layout
-    for (int i = 0; i < m_labelsGrabbedColors.count(); i++)
-    {
-        ui->gridLayout_VirtualLeds->removeWidget(m_labelsGrabbedColors[i]);
-        m_labelsGrabbedColors[i]->deleteLater();
-    }
-
-    m_labelsGrabbedColors.clear();
-
-    for (int i = 0; i < virtualLedsCount; i++)
-    {
-        QLabel *label = new QLabel(this);
-        label->setText(QString::number(i + 1));
-        label->setAlignment(Qt::AlignCenter);
-        label->setAutoFillBackground(true);
-
-        if (m_backlightStatus == Backlight::StatusOff)
-        {
-            // If status off fill labels black:
-            QPalette pal = label->palette();
-            pal.setBrush(QPalette::Window, QBrush(Qt::black));
-            label->setPalette(pal);
-        }
-
-        m_labelsGrabbedColors.append(label);
-
-        int row = i / 10;
-        int col = i % 10;
-
-        ui->gridLayout_VirtualLeds->addWidget(label, row, col);
-    }
-
-    ui->frame_VirtualLeds->update();
+    // All LEDs are black until the first frame
+    m_virtualLeds->setLedsCount(virtualLedsCount);
 }
 
 void SettingsWindow::updateVirtualLedsColors(const QList<QRgb> & colors)
 {
     DEBUG_MID_LEVEL << Q_FUNC_INFO;
 
-    if (colors.count() != m_labelsGrabbedColors.count())
+    if (colors.count() != m_virtualLeds->ledsCount())
     {
-        qCritical() << Q_FUNC_INFO << "Fail: colors.count()" << colors.count() << "!=" << "m_labelsGrabbedColors.count()" << m_labelsGrabbedColors.count() << "."
+        qCritical() << Q_FUNC_INFO << "Fail: colors.count()" << colors.count() << "!=" << "m_virtualLeds->ledsCount()" << m_virtualLeds->ledsCount() << "."
                     << "Cancel updating virtual colors.";
         return;
     }
 
-    for (int i = 0; i < colors.count(); i++)
-    {
-        QLabel *label = m_labelsGrabbedColors[i];
-        QColor color(colors[i]);
-
-        QPalette pal = label->palette();
-        pal.setBrush(QPalette::Window, QBrush(color));
-        label->setPalette(pal);
-    }
+    // Widget paints only the last frame and only while it is visible
+    m_virtualLeds->setColors(colors);
 }
 
 void SettingsWindow::requestBacklightStatus()
@@ -942,6 +932,13 @@ void SettingsWindow::ledDeviceFirmwareVersionResult(const QString & fwVersion)
     updateDeviceTabWidgetsVisibility();
 }
 
+void SettingsWindow::ledDeviceLedsCountResult(int ledsCount)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << ledsCount;
+
+    m_deviceLedsCount = ledsCount;
+}
+
 void SettingsWindow::refreshAmbilightEvaluated(double updateResultMs)
 {    
     DEBUG_MID_LEVEL << Q_FUNC_INFO << updateResultMs;
@@ -982,6 +979,14 @@ void SettingsWindow::onGrabMinLevelOfSensivity_valueChanged(int value)
     m_grabManager->setMinLevelOfSensivity(Settings::getGrabMinimumLevelOfSensitivity());
 }
 
+void SettingsWindow::onGrabColorsChangeThreshold_valueChanged(int value)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+
+    Settings::setGrabColorsChangeThreshold(value);
+    m_grabManager->setColorsChangeThreshold(Settings::getGrabColorsChangeThreshold());
+}
+
 void SettingsWindow::onGrabIsAvgColors_toggled(bool state)
 {
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
@@ -1051,7 +1056,8 @@ void SettingsWindow::onDeviceNumberOfLeds_valueChanged(int value)
 
     Settings::setNumberOfLeds(Settings::getConnectedDevice(), value);
 
-    int numOfLeds = Settings::getNumberOfLeds(Settings::getConnectedDevice());
+    // Frame also includes LEDs of extra devices
+    int numOfLeds = Settings::getNumberOfLedsInFrame();
 
     m_grabManager->setNumberOfLeds(numOfLeds);
     m_moodlampManager->setNumberOfLeds(numOfLeds);
@@ -1564,6 +1570,7 @@ void SettingsWindow::updateUiFromSettings()
     ui->checkBox_GrabIsAvgColors->setChecked            (Settings::isGrabAvgColorsEnabled());
     ui->spinBox_GrabSlowdown->setValue                  (Settings::getGrabSlowdown());
     ui->spinBox_GrabMinLevelOfSensitivity->setValue     (Settings::getGrabMinimumLevelOfSensitivity());
+    ui->spinBox_GrabColorsChangeThreshold->setValue     (Settings::getGrabColorsChangeThreshold());
 
     // Check the selected moodlamp mode (setChecked(false) not working to select another)
     ui->radioButton_ConstantColorMoodLampMode->setChecked(!Settings::isMoodLampLiquidMode());
@@ -34,6 +34,7 @@
 #include "MoodLampManager.hpp"
 #include "SpeedTest.hpp"
 #include "ColorButton.hpp"
+#include "VirtualLedsWidget.hpp"
 #include "enums.hpp"
 
 #include "hotkeys/qkeysequencewidget/src/qkeysequencewidget.h"
@@ -76,6 +77,7 @@ public slots:
     void ledDeviceOpenSuccess(bool isSuccess);
     void ledDeviceCallSuccess(bool isSuccess);
     void ledDeviceFirmwareVersionResult(const QString & fwVersion);
+    void ledDeviceLedsCountResult(int ledsCount);
     void refreshAmbilightEvaluated(double updateResultMs);
 
     void setDeviceLockViaAPI(Api::DeviceLockStatus status);
@@ -113,6 +115,7 @@ private slots:
     void onGrabberChanged();
     void onGrabSlowdown_valueChanged(int value);
     void onGrabMinLevelOfSensivity_valueChanged(int value);
+    void onGrabColorsChangeThreshold_valueChanged(int value);
     void onGrabIsAvgColors_toggled(bool state);
 
     void onDeviceRefreshDelay_valueChanged(int value);
@@ -159,8 +162,8 @@ private:
     void updateDeviceTabWidgetsVisibility();
     void setDeviceTabWidgetsVisibility(DeviceTab::Options options);
     void syncLedDeviceWithSettingsWindow();
-    void setMaximumNumberOfLeds(MaximumNumberOfLeds::Devices maximumNumberOfLeds);
-    MaximumNumberOfLeds::Devices getLightpackMaximumNumberOfLeds();
+    void setMaximumNumberOfLeds(int maximumNumberOfLeds);
+    int getLightpackMaximumNumberOfLeds();
     int getLigtpackFirmwareVersionMajor();
 
     void createTrayIcon();
@@ -196,7 +199,7 @@ private:
 
     Grab::GrabberType getSelectedGrabberType();
 
-    QList<QLabel *> m_labelsGrabbedColors;
+    VirtualLedsWidget *m_virtualLeds;
 
     Ui::SettingsWindow *ui;
 
@@ -219,6 +222,7 @@ private:
     QTranslator *m_translator;
 
     QString m_deviceFirmwareVersion;
+    int m_deviceLedsCount; // reported by device with firmware version, -1 if unknown
     static const QString DeviceFirmvareVersionUndef;
     static const QString LightpackDownloadsPageUrl;
     static const unsigned AmbilightModeIndex;
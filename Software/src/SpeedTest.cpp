@@ -32,6 +32,10 @@ using namespace std;
 
 #include "SpeedTest.hpp"
 #include "Settings.hpp"
+#include "LedLayout.hpp"
+#include "LedSamplingMatrix.hpp"
+#include "X11Grabber.hpp"
+#include "WinAPIGrabber.hpp"
 #include "version.h"
 
 using namespace SettingsScope;
@@ -52,6 +56,8 @@ using namespace SettingsScope;
 /*static*/ const int SpeedTest::LedsCount = 8;
 /*static*/ const int SpeedTest::LedWidth  = 150;
 /*static*/ const int SpeedTest::LedHeight = 150;
+/*static*/ const int SpeedTest::EdgeLayoutLedsCounts[] = { 50, 150, 400 };
+/*static*/ const int SpeedTest::EdgeLayoutTestsCount = sizeof(EdgeLayoutLedsCounts) / sizeof(EdgeLayoutLedsCounts[0]);
 
 
 
@@ -106,6 +112,12 @@ void SpeedTest::printHeader()
 #   endif /* Q_WS_X11 */
 #   ifdef Q_WS_WIN
     resultStream << "GrabWinAPI LedsDefaults"   << CSV_SEPARATOR;
+#   endif /* Q_WS_WIN */
+
+    for (int i = 0; i < EdgeLayoutTestsCount; i++)
+        resultStream << "Grab EdgeLayout " << EdgeLayoutLedsCounts[i] << CSV_SEPARATOR;
+
+#   ifdef Q_WS_WIN
     resultStream << "Windows"                   << CSV_SEPARATOR;
 #   endif /* Q_WS_WIN */
 
@@ -134,6 +146,11 @@ void SpeedTest::startTests()
     //
     testDefaultLedWidgetsGrabSpeed();
 
+    //
+    // Grab edge layouts of 50, 150 and 400 LEDs through sampling matrix TestTimes times
+    //
+    testEdgeLayoutGrabSpeed();
+
 
 #   ifdef _Q_WS_WIN
 
@@ -355,3 +372,65 @@ void SpeedTest::testDefaultLedWidgetsGrabSpeed()
 
 #   endif /* Q_WS_WIN */
 }
+
+
+void SpeedTest::testEdgeLayoutGrabSpeed()
+{
+    // Main screen geometry
+    QRect screenRect = QApplication::desktop()->screenGeometry();
+
+    IGrabber * grabber = NULL;
+
+#   if defined(X11_GRAB_SUPPORT)
+    grabber = new X11Grabber();
+#   elif defined(WINAPI_GRAB_SUPPORT)
+    grabber = new WinAPIGrabber();
+#   endif
+
+    if (grabber != NULL)
+        grabber->updateGrabScreenFromWidget(QApplication::desktop()->screen());
+
+    for (int test = 0; test < EdgeLayoutTestsCount; test++)
+    {
+        int ledsCount = EdgeLayoutLedsCounts[test];
+
+        // Proportional to the sides of the screen, rest of LEDs goes to the top
+        int ledsPerSide[EdgeLayout::SidesCount];
+        int ledsCountVertical = ledsCount * screenRect.height() / (2 * (screenRect.width() + screenRect.height()));
+        int ledsCountHorizontal = ledsCount / 2 - ledsCountVertical;
+
+        ledsPerSide[EdgeLayout::Left]   = ledsCountVertical;
+        ledsPerSide[EdgeLayout::Right]  = ledsCountVertical;
+        ledsPerSide[EdgeLayout::Bottom] = ledsCountHorizontal;
+        ledsPerSide[EdgeLayout::Top]    = ledsCount - 2 * ledsCountVertical - ledsCountHorizontal;
+
+        QList< QList<SamplingZone> > ledsZones;
+        QList<QRect> ledsRects = LedLayout::edges(screenRect, ledsPerSide, LedWidth, 0);
+
+        for (int led = 0; led < ledsRects.size(); led++)
+            ledsZones << (QList<SamplingZone>() << SamplingZone(ledsRects[led]));
+
+        LedSamplingMatrix matrix;
+        matrix.build(ledsZones);
+
+        QList<QRgb> cellsColors, ledsColors;
+
+        if (grabber == NULL || grabber->isWholeScreenCaptured() == false)
+        {
+            resultStream << ALIGNR5( "-" ) << CSV_SEPARATOR;
+            continue;
+        }
+
+        time.start();
+        for (int i = 0; i < TestTimes; i++)
+        {
+            grabber->grabRectsColors(matrix.cells(), cellsColors);
+            matrix.multiply(cellsColors, ledsColors);
+        }
+        resultStream << ALIGNR5( time.elapsed() ) << CSV_SEPARATOR;
+
+        DEBUG_LOW_LEVEL << Q_FUNC_INFO << "leds:" << ledsCount << "cells:" << matrix.cells().size();
+    }
+
+    delete grabber;
+}
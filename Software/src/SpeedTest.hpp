@@ -45,6 +45,7 @@ private:
     void startTests();
     void testFullScreenGrabSpeed();
     void testDefaultLedWidgetsGrabSpeed();
+    void testEdgeLayoutGrabSpeed();
 
 private:
     QFile resultFile;
@@ -56,5 +57,7 @@ private:
     static const int LedsCount;
     static const int LedWidth;
     static const int LedHeight;
+    static const int EdgeLayoutLedsCounts[];
+    static const int EdgeLayoutTestsCount;
 };
 
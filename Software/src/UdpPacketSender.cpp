@@ -0,0 +1,219 @@
+/*
+ * UdpPacketSender.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "UdpPacketSender.hpp"
+#include "debug.h"
+
+#include <QHostInfo>
+
+#ifdef Q_OS_LINUX
+#   include <errno.h>
+#   include <string.h>
+#   include <arpa/inet.h>
+#endif
+
+UdpPacketSender::UdpPacketSender()
+{
+    m_socket = NULL;
+    m_port = 0;
+    m_maximumPacketSize = 0;
+    m_sentPacketsCount = 0;
+    m_droppedPacketsCount = 0;
+}
+
+UdpPacketSender::~UdpPacketSender()
+{
+    close();
+}
+
+bool UdpPacketSender::open(const QString & host, quint16 port)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << host << port;
+
+    close();
+
+    QHostAddress address;
+    if (address.setAddress(host) == false)
+    {
+        QList<QHostAddress> addresses = QHostInfo::fromName(host).addresses();
+
+        // Prefer IPv4, ESP8266 doesn't know anything else
+        for (int i = 0; i < addresses.count(); i++)
+        {
+            if (address.isNull() || addresses[i].protocol() == QAbstractSocket::IPv4Protocol)
+                address = addresses[i];
+            if (address.protocol() == QAbstractSocket::IPv4Protocol)
+                break;
+        }
+    }
+
+    if (address.isNull())
+    {
+        qWarning() << Q_FUNC_INFO << "Can't resolve host" << host;
+        return false;
+    }
+
+    m_socket = new QUdpSocket();
+
+    bool isIPv4 = (address.protocol() == QAbstractSocket::IPv4Protocol);
+    if (m_socket->bind(isIPv4 ? QHostAddress::Any : QHostAddress::AnyIPv6, 0) == false)
+    {
+        qWarning() << Q_FUNC_INFO << "Bind UDP socket fail:" << m_socket->errorString();
+        close();
+        return false;
+    }
+
+    m_address = address;
+    m_port = port;
+
+#ifdef Q_OS_LINUX
+    memset(&m_sockaddr, 0, sizeof(m_sockaddr));
+    m_sockaddr.sin_family = AF_INET;
+    m_sockaddr.sin_port = htons(port);
+    m_sockaddr.sin_addr.s_addr = htonl(address.toIPv4Address());
+#endif
+
+    m_sentPacketsCount = 0;
+    m_droppedPacketsCount = 0;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Send to" << m_address.toString() << m_port;
+
+    return true;
+}
+
+void UdpPacketSender::close()
+{
+    if (m_socket != NULL)
+    {
+        m_socket->close();
+        delete m_socket;
+        m_socket = NULL;
+    }
+}
+
+void UdpPacketSender::reserve(int packetsCount, int maximumPacketSize)
+{
+    if (packetsCount <= m_packetSizes.count() && maximumPacketSize <= m_maximumPacketSize)
+        return;
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << packetsCount << maximumPacketSize;
+
+    m_maximumPacketSize = qMax(maximumPacketSize, m_maximumPacketSize);
+    packetsCount = qMax(packetsCount, m_packetSizes.count());
+
+    m_buffer.resize(packetsCount * m_maximumPacketSize);
+    m_buffer.fill(0);
+    m_packetSizes.fill(0, packetsCount);
+
+#ifdef Q_OS_LINUX
+    m_messages.resize(packetsCount);
+    m_iovecs.resize(packetsCount);
+#endif
+}
+
+int UdpPacketSender::send(int packetsCount)
+{
+    if (m_socket == NULL)
+        return -1;
+
+    packetsCount = qMin(packetsCount, m_packetSizes.count());
+
+    int sent = sendBatch(packetsCount);
+
+    if (sent >= 0)
+    {
+        m_sentPacketsCount += sent;
+        m_droppedPacketsCount += packetsCount - sent;
+
+        if (sent < packetsCount)
+            DEBUG_MID_LEVEL << Q_FUNC_INFO << "socket buffer is full, dropped" << packetsCount - sent << "packets";
+    }
+
+    return sent;
+}
+
+#ifdef Q_OS_LINUX
+int UdpPacketSender::sendBatch(int packetsCount)
+{
+    // IPv6 target, not worth of separate sockaddr
+    if (m_address.protocol() != QAbstractSocket::IPv4Protocol)
+        return writeDatagrams(packetsCount);
+
+    for (int i = 0; i < packetsCount; i++)
+    {
+        m_iovecs[i].iov_base = packetData(i);
+        m_iovecs[i].iov_len = m_packetSizes[i];
+
+        memset(&m_messages[i], 0, sizeof(struct mmsghdr));
+        m_messages[i].msg_hdr.msg_name = &m_sockaddr;
+        m_messages[i].msg_hdr.msg_namelen = sizeof(m_sockaddr);
+        m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+        m_messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int fd = m_socket->socketDescriptor();
+    int sent = 0;
+
+    // sendmmsg() may send less than asked, continue until the socket buffer is full
+    while (sent < packetsCount)
+    {
+        int result = sendmmsg(fd, m_messages.data() + sent, packetsCount - sent, 0);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+                break;
+
+            qWarning() << Q_FUNC_INFO << "sendmmsg() fail:" << strerror(errno);
+            return (sent > 0) ? sent : -1;
+        }
+        sent += result;
+    }
+
+    return sent;
+}
+#else
+int UdpPacketSender::sendBatch(int packetsCount)
+{
+    return writeDatagrams(packetsCount);
+}
+#endif
+
+int UdpPacketSender::writeDatagrams(int packetsCount)
+{
+    int sent = 0;
+
+    for (; sent < packetsCount; sent++)
+    {
+        if (m_socket->writeDatagram(packetData(sent), m_packetSizes[sent], m_address, m_port) < 0)
+        {
+            DEBUG_MID_LEVEL << Q_FUNC_INFO << "writeDatagram() fail:" << m_socket->errorString();
+            break;
+        }
+    }
+
+    return sent;
+}
@@ -0,0 +1,87 @@
+/*
+ * UdpPacketSender.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QHostAddress>
+#include <QUdpSocket>
+
+#ifdef Q_OS_LINUX
+#   include <sys/socket.h>
+#   include <netinet/in.h>
+#endif
+
+// Sends frame split into several datagrams to one host. Packets are
+// preallocated, on Linux all packets of frame are sent with one sendmmsg().
+// Socket is created in open(), so call it in the thread that will send.
+class UdpPacketSender
+{
+public:
+    UdpPacketSender();
+    ~UdpPacketSender();
+
+    // Host is IP address or name, resolving of name blocks
+    bool open(const QString & host, quint16 port);
+    void close();
+    bool isOpen() const { return m_socket != NULL; }
+
+    // Reallocates only if packets count or maximum size grows
+    void reserve(int packetsCount, int maximumPacketSize);
+
+    char * packetData(int index) { return m_buffer.data() + index * m_maximumPacketSize; }
+    void setPacketSize(int index, int size) { m_packetSizes[index] = size; }
+
+    // Sends first packetsCount packets, returns number of packets sent or -1 on error.
+    // Packets which don't fit into socket buffer are dropped.
+    int send(int packetsCount);
+
+    quint64 sentPacketsCount() const { return m_sentPacketsCount; }
+    quint64 droppedPacketsCount() const { return m_droppedPacketsCount; }
+
+private:
+    int sendBatch(int packetsCount);
+    int writeDatagrams(int packetsCount);
+
+private:
+    QUdpSocket *m_socket;
+    QHostAddress m_address;
+    quint16 m_port;
+
+    QByteArray m_buffer;
+    QVector<int> m_packetSizes;
+    int m_maximumPacketSize;
+
+#ifdef Q_OS_LINUX
+    struct sockaddr_in m_sockaddr;
+    QVector<struct mmsghdr> m_messages;
+    QVector<struct iovec> m_iovecs;
+#endif
+
+    quint64 m_sentPacketsCount;
+    quint64 m_droppedPacketsCount;
+};
@@ -0,0 +1,158 @@
+/*
+ * UsbHotplugMonitor.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "UsbHotplugMonitor.hpp"
+#include "debug.h"
+
+#include <QSocketNotifier>
+#include <QStringList>
+
+#ifdef Q_OS_LINUX
+extern "C"
+{
+#   include <libudev.h>
+}
+#endif
+
+UsbHotplugMonitor::UsbHotplugMonitor(unsigned short vendorId, unsigned short productId, QObject *parent)
+    : QObject(parent)
+{
+    m_vendorId = vendorId;
+    m_productId = productId;
+
+    m_udev = NULL;
+    m_monitor = NULL;
+    m_notifier = NULL;
+
+#ifdef Q_OS_LINUX
+    m_udev = udev_new();
+    if (m_udev == NULL)
+    {
+        qWarning() << Q_FUNC_INFO << "udev_new() fail, hotplug isn't available";
+        return;
+    }
+
+    // "udev" source sends events after rules are applied, so device nodes
+    // already exist and have right permissions
+    m_monitor = udev_monitor_new_from_netlink(m_udev, "udev");
+    if (m_monitor == NULL)
+    {
+        qWarning() << Q_FUNC_INFO << "udev_monitor_new_from_netlink() fail, hotplug isn't available";
+        return;
+    }
+
+    udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "usb", "usb_device");
+    udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "hidraw", NULL);
+
+    if (udev_monitor_enable_receiving(m_monitor) < 0)
+    {
+        qWarning() << Q_FUNC_INFO << "udev_monitor_enable_receiving() fail, hotplug isn't available";
+        return;
+    }
+
+    m_notifier = new QSocketNotifier(udev_monitor_get_fd(m_monitor), QSocketNotifier::Read, this);
+    connect(m_notifier, SIGNAL(activated(int)), this, SLOT(readEvent()));
+
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << QString("watching 0x%1:0x%2")
+                       .arg(m_vendorId, 4, 16, QChar('0'))
+                       .arg(m_productId, 4, 16, QChar('0'));
+#endif
+}
+
+UsbHotplugMonitor::~UsbHotplugMonitor()
+{
+    delete m_notifier;
+
+#ifdef Q_OS_LINUX
+    if (m_monitor != NULL)
+        udev_monitor_unref(m_monitor);
+    if (m_udev != NULL)
+        udev_unref(m_udev);
+#endif
+}
+
+void UsbHotplugMonitor::readEvent()
+{
+#ifdef Q_OS_LINUX
+    struct udev_device *device = udev_monitor_receive_device(m_monitor);
+    if (device == NULL)
+        return;
+
+    QString action = udev_device_get_action(device);
+    QString subsystem = udev_device_get_subsystem(device);
+
+    DEBUG_MID_LEVEL << Q_FUNC_INFO << action << subsystem << udev_device_get_devnode(device);
+
+    if (subsystem == "hidraw")
+    {
+        // Parent can be looked up only while it is in sysfs, removal
+        // is reported by USB device event
+        if (action == "add")
+        {
+            struct udev_device *usbDevice = udev_device_get_parent_with_subsystem_devtype(device, "usb", "usb_device");
+            if (usbDevice != NULL && isMatchedUsbDevice(usbDevice))
+                emit deviceArrived();
+        }
+    }
+    else if (isMatchedUsbDevice(device))
+    {
+        if (action == "add")
+            emit deviceArrived();
+        else if (action == "remove")
+            emit deviceRemoved();
+    }
+
+    udev_device_unref(device);
+#endif
+}
+
+bool UsbHotplugMonitor::isMatchedUsbDevice(struct udev_device *device) const
+{
+#ifdef Q_OS_LINUX
+    // PRODUCT property is in uevent of USB device, so it is also
+    // available in "remove" events, when sysfs attributes are gone
+    return isMatchedProduct(udev_device_get_property_value(device, "PRODUCT"));
+#else
+    Q_UNUSED(device);
+    return false;
+#endif
+}
+
+bool UsbHotplugMonitor::isMatchedProduct(const char *product) const
+{
+    // Format is "vid/pid/bcdDevice" in hex without leading zeros
+    if (product == NULL)
+        return false;
+
+    QStringList ids = QString(product).split('/');
+    if (ids.count() < 2)
+        return false;
+
+    bool okVid = false, okPid = false;
+    unsigned short vid = ids[0].toUShort(&okVid, 16);
+    unsigned short pid = ids[1].toUShort(&okPid, 16);
+
+    return okVid && okPid && vid == m_vendorId && pid == m_productId;
+}
@@ -0,0 +1,67 @@
+/*
+ * UsbHotplugMonitor.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+
+class QSocketNotifier;
+struct udev;
+struct udev_monitor;
+struct udev_device;
+
+// Watches udev events for USB device with given VID and PID, so device
+// can be reopened right after it was plugged instead of polling it.
+// Only Linux is supported, on other platforms isAvailable() returns false.
+class UsbHotplugMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    UsbHotplugMonitor(unsigned short vendorId, unsigned short productId, QObject *parent = 0);
+    ~UsbHotplugMonitor();
+
+    bool isAvailable() const { return m_notifier != NULL; }
+
+signals:
+    // Emitted for USB device itself and for its hidraw node, which is
+    // created a bit later, so receiver should ignore repeated arrivals
+    void deviceArrived();
+    void deviceRemoved();
+
+private slots:
+    void readEvent();
+
+private:
+    bool isMatchedUsbDevice(struct udev_device *device) const;
+    bool isMatchedProduct(const char *product) const;
+
+private:
+    unsigned short m_vendorId;
+    unsigned short m_productId;
+
+    struct udev *m_udev;
+    struct udev_monitor *m_monitor;
+    QSocketNotifier *m_notifier;
+};
@@ -0,0 +1,128 @@
+/*
+ * VirtualLedsWidget.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "VirtualLedsWidget.hpp"
+#include "debug.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+
+const int VirtualLedsWidget::UpdateInterval = 16; // ~60 fps
+const int VirtualLedsWidget::ColumnsCount = 10;
+const int VirtualLedsWidget::LedHeight = 20;
+const int VirtualLedsWidget::LedMinimumWidth = 24;
+
+VirtualLedsWidget::VirtualLedsWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    m_timerUpdate = new QTimer(this);
+    m_timerUpdate->setSingleShot(true);
+    connect(m_timerUpdate, SIGNAL(timeout()), this, SLOT(updateColors()));
+
+    m_timeLastUpdate.start();
+
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+    // Whole widget is filled in paintEvent()
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void VirtualLedsWidget::setLedsCount(int count)
+{
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << count;
+
+    m_colors.clear();
+    for (int i = 0; i < count; i++)
+        m_colors << qRgb(0, 0, 0);
+
+    updateGeometry();
+    update();
+}
+
+void VirtualLedsWidget::setColors(const QList<QRgb> & colors)
+{
+    // Implicitly shared, so saving of every frame is cheap
+    m_colors = colors;
+
+    // Hidden widget is painted with last colors when it is shown
+    if (isVisible() == false)
+        return;
+
+    // Frames received before the timeout are painted by one update
+    if (m_timerUpdate->isActive())
+        return;
+
+    m_timerUpdate->start(qMax(0, UpdateInterval - m_timeLastUpdate.elapsed()));
+}
+
+void VirtualLedsWidget::updateColors()
+{
+    m_timeLastUpdate.restart();
+    update();
+}
+
+QSize VirtualLedsWidget::sizeHint() const
+{
+    return minimumSizeHint();
+}
+
+QSize VirtualLedsWidget::minimumSizeHint() const
+{
+    int rows = (m_colors.count() + ColumnsCount - 1) / ColumnsCount;
+
+    return QSize(ColumnsCount * LedMinimumWidth, rows * LedHeight);
+}
+
+QRect VirtualLedsWidget::ledRect(int index) const
+{
+    // Columns are stretched to the widget width, like cells of grid layout
+    int row = index / ColumnsCount;
+    int col = index % ColumnsCount;
+
+    int left = col * width() / ColumnsCount;
+    int right = (col + 1) * width() / ColumnsCount;
+
+    return QRect(left, row * LedHeight, right - left, LedHeight);
+}
+
+void VirtualLedsWidget::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+
+    painter.fillRect(event->rect(), palette().window());
+
+    for (int i = 0; i < m_colors.count(); i++)
+    {
+        QRect rect = ledRect(i);
+        if (rect.intersects(event->rect()) == false)
+            continue;
+
+        QRgb color = m_colors[i];
+        painter.fillRect(rect, QColor(color));
+
+        // Number is readable on any color
+        painter.setPen(qGray(color) < 128 ? Qt::white : Qt::black);
+        painter.drawText(rect, Qt::AlignCenter, QString::number(i + 1));
+    }
+}
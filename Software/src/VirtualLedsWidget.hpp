@@ -0,0 +1,71 @@
+/*
+ * VirtualLedsWidget.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QWidget>
+#include <QTimer>
+#include <QTime>
+#include <QList>
+#include <QRgb>
+
+// Shows colors of virtual device. Frames are coalesced and all LEDs are
+// painted in one paintEvent() not more often than UpdateInterval, colors
+// of hidden widget are only saved.
+class VirtualLedsWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    VirtualLedsWidget(QWidget *parent = 0);
+
+    // Resets colors to black
+    void setLedsCount(int count);
+    int ledsCount() const { return m_colors.count(); }
+
+    QSize sizeHint() const;
+    QSize minimumSizeHint() const;
+
+public slots:
+    void setColors(const QList<QRgb> & colors);
+
+protected:
+    void paintEvent(QPaintEvent *event);
+
+private slots:
+    void updateColors();
+
+private:
+    QRect ledRect(int index) const;
+
+private:
+    QList<QRgb> m_colors;
+    QTimer *m_timerUpdate;
+    QTime m_timeLastUpdate;
+
+    static const int UpdateInterval; // ms
+    static const int ColumnsCount;
+    static const int LedHeight;
+    static const int LedMinimumWidth;
+};
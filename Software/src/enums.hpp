@@ -78,6 +78,9 @@ enum DeviceType {
     AdalightDevice,
     VirtualDevice,
     ArdulightDevice,
+    UdpDevice,
+    E131Device,
+    ArtNetDevice,
 
     DevicesCount,
     DefaultDevice = LightpackDevice
@@ -88,21 +91,38 @@ namespace MaximumNumberOfLeds
 {
 enum Devices
 {
-    AbsoluteMaximum = 50,
+    AbsoluteMaximum = 500,
 
-    Adalight    = 50,
+    Adalight    = 500,
     Ardulight   = 50,
     AlienFx     = 1,
-    Virtual     = 50,
+    Virtual     = 500,
+    Udp         = 500,
+    Dmx         = 500,  /* 3 universes, LedDeviceDmx itself isn't limited by frame */
 
     Lightpack4  = 8,
     Lightpack5  = 10,
     Lightpack6  = 10,
+    // Firmware with multi-report frames, device ignores LEDs it doesn't have
+    LightpackFramed = 500,
 
     Default     = 10
 };
 }
 
+// Sides of the screen for LedLayout, LEDs are numbered clockwise in this order
+namespace EdgeLayout
+{
+enum Side {
+    Left,
+    Top,
+    Right,
+    Bottom,
+
+    SidesCount
+};
+}
+
 // Configure SettingsWindow Device tab for suitable device options
 namespace DeviceTab
 {
@@ -122,6 +142,8 @@ enum Options
 
     Adalight        = Default | SerialPort,
     Ardulight       = Default | SerialPort,
+    Udp             = Default,
+    Dmx             = Default,
     AlienFx         = Default,
     Lightpack       = Default | SmoothSlowdown | RefreshDelay | ColorDepth,
     Virtual         = Default | VirtualLeds
@@ -134,11 +156,7 @@ namespace LedDeviceCommands
 enum Cmd {
     OffLeds,
     SetColors,
-    SetRefreshDelay,
-    SetColorDepth,
-    SetSmoothSlowdown,
-    SetGamma,
-    SetBrightness,
+    SetSettings,
     RequestFirmwareVersion,
     UpdateDeviceSettings
 };
@@ -30,6 +30,7 @@
 #ifdef D3D9_GRAB_SUPPORT
 
 #include "debug.h"
+#include "LightpackMath.hpp"
 #include "cmath"
 #define BYTES_PER_PIXEL 4
 
@@ -127,10 +128,25 @@ int D3D9Grabber::getBufLength(const RECT &rect)
     return (rect.right - rect.left) * (rect.bottom - rect.top) * BYTES_PER_PIXEL;
 }
 
-QList<QRgb> D3D9Grabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
+void D3D9Grabber::grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result)
 {
-    QList<QRgb> result;
-    m_rect = getEffectiveRect(widgets);
+    QRect effectiveRect;
+    for(int i = 0; i < rects.size(); i++)
+        effectiveRect |= rects[i];
+
+    RECT rect = { effectiveRect.left(), effectiveRect.top(), effectiveRect.right() + 1, effectiveRect.bottom() + 1 };
+    captureRect(rect);
+
+    result.clear();
+    for(int i = 0; i < rects.size(); i++)
+    {
+        result.append(getColor(rects[i].x(), rects[i].y(), rects[i].width(), rects[i].height()));
+    }
+}
+
+void D3D9Grabber::captureRect(const RECT &rect)
+{
+    m_rect = rect;
     if(m_rect.bottom > QApplication::desktop()->height())
         m_rect.bottom = QApplication::desktop()->height();
     if(m_rect.right > QApplication::desktop()->width())
@@ -144,37 +160,6 @@ QList<QRgb> D3D9Grabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
         m_bufLength = bufLengthNeeded;
     }
     getImageData(m_buf, m_rect);
-    for(int i = 0; i < widgets.size(); i++)
-    {
-        GrabWidget * widget = widgets[i];
-        result.append(getColor(widget->x(), widget->y(), widget->width(), widget->height()));
-    }
-    return result;
-}
-
-RECT D3D9Grabber::getEffectiveRect(QList<GrabWidget *> &widgets)
-{
-    RECT result = {0,0,0,0};
-    if (widgets.size() > 0)
-    {
-        GrabWidget * widget = widgets[0];
-        result.left   = widget->x();
-        result.right  = widget->x() + widget->width();
-        result.top    = widget->y();
-        result.bottom = widget->y() + widget->height();
-        for(int i = 1; i < widgets.size(); i++) {
-            widget = widgets[i];
-            if (result.left > widget->x())
-                result.left = widget->x();
-            if (result.right < widget->x() + widget->width())
-                result.right = widget->x() + widget->width();
-            if (result.top > widget->y())
-                result.top = widget->y();
-            if (result.bottom < widget->y() + widget->height())
-                result.bottom = widget->y() + widget->height();
-        }
-    }
-    return result;
 }
 
 BYTE * D3D9Grabber::getImageData(BYTE * buf, RECT &rect)
@@ -227,6 +212,10 @@ QRgb D3D9Grabber::getColor(int x, int y, int width, int height)
         return 0x000000;
     }
 
+    if (m_isLinearLightAveraging)
+        return LightpackMath::avgColorLinearLight(m_buf, screenWidth * BYTES_PER_PIXEL, BYTES_PER_PIXEL,
+                                                  x, y, width, height);
+
     unsigned count = 0; // count the amount of pixels taken into account
     unsigned endIndex = (screenWidth * (y + height) + x + width) * BYTES_PER_PIXEL;
     register unsigned index = (screenWidth * y + x) * BYTES_PER_PIXEL; // index of the selected pixel in pbPixelsBuff
@@ -38,7 +38,8 @@ public:
     ~D3D9Grabber();
     virtual const char * getName();
     virtual void updateGrabScreenFromWidget( QWidget * widget ) {}
-    virtual QList<QRgb> grabWidgetsColors(QList<GrabWidget *> &widgets);
+    virtual void grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result);
+    virtual bool isWholeScreenCaptured() { return true; }
 
 private:
     LPDIRECT3D9 m_d3D;
@@ -52,7 +53,7 @@ private:
 private:
     BYTE * expandBuffer(BYTE * buf, int newLength);
     BYTE * getImageData(BYTE *, RECT &);
-    RECT getEffectiveRect(QList<GrabWidget *> &widgets);
+    void captureRect(const RECT &rect);
     int getBufLength(const RECT &rect);
     QRgb getColor(int x, int y, int width, int height);
 
@@ -26,14 +26,33 @@
 #pragma once
 
 #include <QColor>
+#include <QList>
+#include <QRect>
+#include <QWidget>
 
 #include "defs.h"
-#include "GrabWidget.hpp"
 
 class IGrabber
 {
 public:
+    IGrabber() : m_isLinearLightAveraging(false) { }
+    virtual ~IGrabber() { }
+
     virtual const char * getName() = 0;
     virtual void updateGrabScreenFromWidget( QWidget * widget ) = 0;
-    virtual QList<QRgb> grabWidgetsColors(QList<GrabWidget *> &widgets) = 0;
+
+    // Average colors of screen rectangles, in coordinates of the desktop
+    virtual void grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result) = 0;
+
+    // Grabbers which capture the whole screen once per frame can average any
+    // number of small cells of the sampling matrix for the price of one capture,
+    // others capture each rectangle separately and get LED zones as is
+    virtual bool isWholeScreenCaptured() { return false; }
+
+    // Average colors of widgets in linear light instead of sRGB bytes,
+    // used by grabbers which sum pixels of the screen buffer themselves
+    void setLinearLightAveraging(bool isEnabled) { m_isLinearLightAveraging = isEnabled; }
+
+protected:
+    bool m_isLinearLightAveraging;
 };
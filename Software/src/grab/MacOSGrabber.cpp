@@ -49,17 +49,17 @@ void MacOSGrabber::updateGrabScreenFromWidget(QWidget *widget)
     Q_UNUSED(widget);
 }
 
-QList<QRgb> MacOSGrabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
+void MacOSGrabber::grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result)
 {
     CGImageRef image = CGDisplayCreateImage(kCGDirectMainDisplay);
-    QList<QRgb> result;
+    result.clear();
 
     if (image != NULL)
     {
         QPixmap pixmap = QPixmap::fromMacCGImageRef(image);
 
-        for(int i = 0; i < widgets.size(); i++) {
-            result.append(getColor(pixmap, widgets[i]));
+        for(int i = 0; i < rects.size(); i++) {
+            result.append(getColor(pixmap, rects[i].x(), rects[i].y(), rects[i].width(), rects[i].height()));
         }
 
         CGImageRelease(image);
@@ -68,21 +68,9 @@ QList<QRgb> MacOSGrabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
 
         qCritical() << Q_FUNC_INFO << "CGDisplayCreateImage(..) returned NULL";
 
-        for(int i = 0; i < widgets.size(); i++)
+        for(int i = 0; i < rects.size(); i++)
             result.append(0);
     }
-    return result;
-}
-
-QRgb MacOSGrabber::getColor(QPixmap pixmap, const QWidget * grabme)
-{
-    DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
-
-    return getColor(pixmap,
-                    grabme->x(),
-                    grabme->y(),
-                    grabme->width(),
-                    grabme->height());
 }
 
 QRgb MacOSGrabber::getColor(QPixmap pixmap, int x, int y, int width, int height)
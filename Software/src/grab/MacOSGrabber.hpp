@@ -30,6 +30,7 @@
 #ifdef MAC_OS_CG_GRAB_SUPPORT
 
 #include "IGrabber.hpp"
+#include <QPixmap>
 
 class MacOSGrabber : public IGrabber
 {
@@ -37,11 +38,10 @@ public:
     MacOSGrabber();
     ~MacOSGrabber();
     virtual void updateGrabScreenFromWidget(QWidget *widget);
-    virtual QList<QRgb>grabWidgetsColors(QList<GrabWidget *> &widgets);
+    virtual void grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result);
     virtual const char * getName();
 
 private:
-    QRgb getColor(QPixmap pixmap, const QWidget * grabme);
     QRgb getColor(QPixmap pixmap, int x, int y, int width, int height);
 };
 
@@ -54,7 +54,7 @@ void QtGrabber::updateGrabScreenFromWidget(QWidget *widget)
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << "screenres " << screenres;
 }
 
-QList<QRgb> QtGrabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
+void QtGrabber::grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
     QPixmap pixmap = QPixmap::grabWindow(QApplication::desktop()->screen(-1) ->winId(),
@@ -62,26 +62,14 @@ QList<QRgb> QtGrabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
                                   screenres.y(), //!
                                   screenres.width(),
                                   screenres.height());
-    QList<QRgb> result;
-    for(int i = 0; i < widgets.size(); i++) {
-        result.append(getColor(pixmap, widgets[i]));
+    result.clear();
+    for(int i = 0; i < rects.size(); i++) {
+        result.append(getColor(pixmap, rects[i].x(), rects[i].y(), rects[i].width(), rects[i].height()));
     }
 #if 0
     if (screenres.width() < 1920)
         pixmap.toImage().save("screen.jpg");
 #endif
-    return result;
-}
-
-QRgb QtGrabber::getColor(QPixmap pixmap, const QWidget * grabme)
-{
-    DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
-
-    return getColor(pixmap,
-                    grabme->x(),
-                    grabme->y(),
-                    grabme->width(),
-                    grabme->height());
 }
 
 QRgb QtGrabber::getColor(QPixmap pixmap, int x, int y, int width, int height)
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "IGrabber.hpp"
+#include <QPixmap>
 
 #ifdef QT_GRAB_SUPPORT
 
@@ -36,10 +37,9 @@ public:
     ~QtGrabber();
     virtual const char * getName();
     virtual void updateGrabScreenFromWidget( QWidget * widget );
-    virtual QList<QRgb> grabWidgetsColors(QList<GrabWidget *> &widgets);
+    virtual void grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result);
 
 private:
-    QRgb getColor(QPixmap pixmap, const QWidget * grabme);
     QRgb getColor(QPixmap pixmap, int x, int y, int width, int height);
 
     QRect screenres;
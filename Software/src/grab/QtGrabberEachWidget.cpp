@@ -47,21 +47,20 @@ void QtGrabberEachWidget::updateGrabScreenFromWidget(QWidget * /*widget*/)
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
 }
 
-QList<QRgb> QtGrabberEachWidget::grabWidgetsColors(QList<GrabWidget *> &widgets)
+void QtGrabberEachWidget::grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
 
-    QList<QRgb> result;
-    for (int i = 0; i < widgets.size(); i++)
+    result.clear();
+    for (int i = 0; i < rects.size(); i++)
 	{
-        result.append(getColor(widgets[i]));
+        result.append(getColor(rects[i]));
     }
-    return result;
 }
 
-QRgb QtGrabberEachWidget::getColor(const QWidget * w)
+QRgb QtGrabberEachWidget::getColor(const QRect &rect)
 {
-    QPixmap pix = QPixmap::grabWindow(QApplication::desktop()->winId(), w->x(), w->y(), w->width(), w->height());
+    QPixmap pix = QPixmap::grabWindow(QApplication::desktop()->winId(), rect.x(), rect.y(), rect.width(), rect.height());
     QPixmap scaledPix = pix.scaled(1,1, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
     QImage im = scaledPix.toImage();
     QRgb result = im.pixel(0,0);
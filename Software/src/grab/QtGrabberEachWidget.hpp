@@ -36,10 +36,10 @@ public:
     ~QtGrabberEachWidget();
     virtual const char * getName();
     virtual void updateGrabScreenFromWidget( QWidget * widget );
-    virtual QList<QRgb> grabWidgetsColors(QList<GrabWidget *> &widgets);
+    virtual void grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result);
 
 private:
-    QRgb getColor(const QWidget * w);
+    QRgb getColor(const QRect &rect);
 };
 
 #endif // QT_GRAB_SUPPORT
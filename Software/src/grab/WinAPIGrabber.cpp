@@ -26,6 +26,7 @@
 #include"WinAPIGrabber.hpp"
 #ifdef WINAPI_GRAB_SUPPORT
 #include"debug.h"
+#include "LightpackMath.hpp"
 #include<cmath>
 
 WinAPIGrabber::WinAPIGrabber()
@@ -119,14 +120,13 @@ void WinAPIGrabber::updateGrabScreenFromWidget(QWidget *widget)
 
 }
 
-QList<QRgb> WinAPIGrabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
+void WinAPIGrabber::grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result)
 {
-    QList<QRgb> widgetsColors;
     captureScreen();
-    for(int i = 0; i < widgets.size(); i++) {
-        widgetsColors.append(getColor(widgets[i]));
+    result.clear();
+    for(int i = 0; i < rects.size(); i++) {
+        result.append(getColor(rects[i].x(), rects[i].y(), rects[i].width(), rects[i].height()));
     }
-    return widgetsColors;
 }
 
 void WinAPIGrabber::captureScreen()
@@ -141,16 +141,6 @@ void WinAPIGrabber::captureScreen()
     GetBitmapBits( hBitmap, pixelsBuffSize, pbPixelsBuff );
 }
 
-QRgb WinAPIGrabber::getColor(const QWidget * grabme)
-{
-    DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
-
-    return getColor(grabme->x(),
-                    grabme->y(),
-                    grabme->width(),
-                    grabme->height());
-}
-
 QRgb WinAPIGrabber::getColor(int x, int y, int width, int height)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO
@@ -200,6 +190,10 @@ QRgb WinAPIGrabber::getColor(int x, int y, int width, int height)
         return 0x000000;
     }
 
+    if (m_isLinearLightAveraging)
+        return LightpackMath::avgColorLinearLight(pbPixelsBuff, screenWidth * bytesPerPixel, bytesPerPixel,
+                                                  x, y, width, height);
+
     unsigned count = 0; // count the amount of pixels taken into account
     unsigned endIndex = (screenWidth * (y + height) + x + width) * bytesPerPixel;
     register unsigned index = (screenWidth * y + x) * bytesPerPixel; // index of the selected pixel in pbPixelsBuff
@@ -27,6 +27,7 @@
 
 #ifdef WINAPI_GRAB_SUPPORT
 #include "debug.h"
+#include "LightpackMath.hpp"
 #include <cmath>
 
 WinAPIGrabberEachWidget::WinAPIGrabberEachWidget()
@@ -51,16 +52,15 @@ void WinAPIGrabberEachWidget::updateGrabScreenFromWidget(QWidget *widget)
     isBufferNeedsResize = true;
 }
 
-QList<QRgb> WinAPIGrabberEachWidget::grabWidgetsColors(QList<GrabWidget *> &widgets)
+void WinAPIGrabberEachWidget::grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result)
 {
-    QList<QRgb> widgetsColors;
-    for(int i = 0; i < widgets.size(); i++) {
-        widgetsColors.append(getColor(widgets[i]));
+    result.clear();
+    for(int i = 0; i < rects.size(); i++) {
+        result.append(getColor(rects[i]));
     }
-    return widgetsColors;
 }
 
-void WinAPIGrabberEachWidget::captureWidget(const QWidget * w)
+void WinAPIGrabberEachWidget::captureRect(const QRect &rect)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
 
@@ -92,8 +92,8 @@ void WinAPIGrabberEachWidget::captureWidget(const QWidget * w)
     }
 
     // Copy screen
-    BitBlt( hMemDC, w->x(), w->y(), w->width(), w->height(), hScreenDC,
-            w->x(), w->y(), SRCCOPY );
+    BitBlt( hMemDC, rect.x(), rect.y(), rect.width(), rect.height(), hScreenDC,
+            rect.x(), rect.y(), SRCCOPY );
 
     if( isBufferNeedsResize ){
 
@@ -135,16 +135,16 @@ void WinAPIGrabberEachWidget::captureWidget(const QWidget * w)
     GetBitmapBits( hBitmap, pixelsBuffSize, pbPixelsBuff );
 }
 
-QRgb WinAPIGrabberEachWidget::getColor(const QWidget * grabme)
+QRgb WinAPIGrabberEachWidget::getColor(const QRect &rect)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
 
-    captureWidget(grabme);
+    captureRect(rect);
 
-    return getColor(grabme->x(),
-                    grabme->y(),
-                    grabme->width(),
-                    grabme->height());
+    return getColor(rect.x(),
+                    rect.y(),
+                    rect.width(),
+                    rect.height());
 }
 
 QRgb WinAPIGrabberEachWidget::getColor(int x, int y, int width, int height)
@@ -196,6 +196,10 @@ QRgb WinAPIGrabberEachWidget::getColor(int x, int y, int width, int height)
         return 0x000000;
     }
 
+    if (m_isLinearLightAveraging)
+        return LightpackMath::avgColorLinearLight(pbPixelsBuff, screenWidth * bytesPerPixel, bytesPerPixel,
+                                                  x, y, width, height);
+
     unsigned count = 0; // count the amount of pixels taken into account
     unsigned endIndex = (screenWidth * (y + height) + x + width) * bytesPerPixel;
     register unsigned index = (screenWidth * y + x) * bytesPerPixel; // index of the selected pixel in pbPixelsBuff
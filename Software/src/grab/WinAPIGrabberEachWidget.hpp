@@ -39,11 +39,11 @@ public:
     ~WinAPIGrabberEachWidget();
     virtual const char * getName();
     virtual void updateGrabScreenFromWidget( QWidget * widget );
-    virtual QList<QRgb> grabWidgetsColors(QList<GrabWidget *> &widgets);
+    virtual void grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result);
 
 private:
-    void captureWidget(const QWidget * w);
-    QRgb getColor(const QWidget * grabme);
+    void captureRect(const QRect &rect);
+    QRgb getColor(const QRect &rect);
     QRgb getColor(int x, int y, int width, int height);
 
 private:
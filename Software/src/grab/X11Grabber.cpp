@@ -24,6 +24,7 @@
  */
 
 #include "X11Grabber.hpp"
+#include "LightpackMath.hpp"
 
 #ifdef X11_GRAB_SUPPORT
 
@@ -68,14 +69,13 @@ void X11Grabber::updateGrabScreenFromWidget(QWidget *widget)
     screen = QApplication::desktop()->screenNumber( widget );
 }
 
-QList<QRgb> X11Grabber::grabWidgetsColors(QList<GrabWidget *> &widgets)
+void X11Grabber::grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result)
 {
     captureScreen();
-    QList<QRgb> result;
-    for(int i = 0; i < widgets.size(); i++) {
-        result.append(getColor(widgets[i]));
+    result.clear();
+    for(int i = 0; i < rects.size(); i++) {
+        result.append(getColor(rects[i].x(), rects[i].y(), rects[i].width(), rects[i].height()));
     }
-    return result;
 }
 
 void X11Grabber::captureScreen()
@@ -149,16 +149,6 @@ void X11Grabber::captureScreen()
 #endif
 }
 
-QRgb X11Grabber::getColor(const QWidget * grabme)
-{
-    DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
-
-    return getColor(grabme->x(),
-                    grabme->y(),
-                    grabme->width(),
-                    grabme->height());
-}
-
 QRgb X11Grabber::getColor(int x, int y, int width, int height)
 {
     DEBUG_HIGH_LEVEL << Q_FUNC_INFO
@@ -207,6 +197,11 @@ QRgb X11Grabber::getColor(int x, int y, int width, int height)
     unsigned char *pbPixelsBuff;
     int bytesPerPixel = d->image->bits_per_pixel / 8;
     pbPixelsBuff = (unsigned char *)d->image->data;
+
+    if (m_isLinearLightAveraging)
+        return LightpackMath::avgColorLinearLight(pbPixelsBuff, d->image->bytes_per_line, bytesPerPixel,
+                                                  x, y, width, height);
+
     int count = 0; // count the amount of pixels taken into account
     for(int j = 0; j < height; j++) {
         int index = d->image->bytes_per_line * (y+j) + x * bytesPerPixel;
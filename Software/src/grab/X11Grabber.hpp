@@ -47,11 +47,11 @@ public:
     ~X11Grabber();
     virtual const char * getName();
     virtual void updateGrabScreenFromWidget( QWidget * widget );
-    virtual QList<QRgb> grabWidgetsColors(QList<GrabWidget *> &widgets);
+    virtual void grabRectsColors(const QList<QRect> &rects, QList<QRgb> &result);
+    virtual bool isWholeScreenCaptured() { return true; }
 
 private:
     void captureScreen();
-    QRgb getColor(const QWidget * grabme);
     QRgb getColor(int x, int y, int width, int height);
 
 private:
@@ -200,6 +200,43 @@ extern "C" {
 		*/
 		int  HID_API_EXPORT HID_API_CALL hid_write(hid_device *device, const unsigned char *data, size_t length);
 
+		/** @brief Queue an Output report to a HID device without waiting.
+
+			Takes the same arguments as hid_write(), but returns as soon
+			as the report is handed to the OS. At most two reports are
+			in flight at once; if both are busy, the report replaces any
+			report which is still waiting for them, so only the newest
+			one is sent. A failure of an earlier report is returned by
+			the next call. Backends without asynchronous output fall back
+			to hid_write().
+
+			@ingroup API
+			@param device A device handle returned from hid_open().
+			@param data The data to send, including the report number as
+				the first byte.
+			@param length The length in bytes of the data to send.
+
+			@returns
+				This function returns the number of bytes queued and
+				-1 on error or if an earlier report has failed.
+		*/
+		int  HID_API_EXPORT HID_API_CALL hid_write_async(hid_device *device, const unsigned char *data, size_t length);
+
+		/** @brief Check if a report queued by hid_write_async() is
+			still waiting to be handed to the OS.
+
+			Such report will be replaced by the next hid_write_async()
+			call and never sent.
+
+			@ingroup API
+			@param device A device handle returned from hid_open().
+
+			@returns
+				This function returns 1 if a report is waiting and 0
+				otherwise.
+		*/
+		int  HID_API_EXPORT HID_API_CALL hid_write_async_pending(hid_device *device);
+
 		/** @brief Read an Input report from a HID device with timeout.
 
 			Input reports are returned
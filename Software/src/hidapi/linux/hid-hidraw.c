@@ -0,0 +1,641 @@
+/*******************************************************
+ HIDAPI - Multi-Platform library for
+ communication with HID devices.
+
+ Alan Ott
+ Signal 11 Software
+
+ 8/22/2009
+ Linux Version - 6/2/2010
+ Hidraw Version for Lightpack - 10/19/2026
+
+ Copyright 2009, All Rights Reserved.
+
+ At the discretion of the user of this library,
+ this software may be licensed under the terms of the
+ GNU Public License v3, a BSD-Style license, or the
+ original HIDAPI license as outlined in the LICENSE.txt,
+ LICENSE-gpl3.txt, LICENSE-bsd.txt, and LICENSE-orig.txt
+ files located at the root of the source distribution.
+ These files may also be found in the public source
+ code repository located at:
+        http://github.com/signal11/hidapi .
+********************************************************/
+
+/* This backend talks to the kernel hidraw driver. The kernel driver
+   stays attached, reports are written with write() and read with poll()
+   and read() on /dev/hidrawN, and devices are found through sysfs, so
+   neither libusb nor libudev are needed. Select it instead of
+   hid-libusb.c with "qmake CONFIG+=hidraw". */
+
+/* C */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <locale.h>
+#include <errno.h>
+
+/* Unix */
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <dirent.h>
+#include <limits.h>
+#include <pthread.h>
+
+/* Linux */
+#include <linux/hidraw.h>
+#include <linux/input.h>
+
+#include "hidapi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef DEBUG_PRINTF
+#define LOG(...) fprintf(stderr, __VA_ARGS__)
+#else
+#define LOG(...) do {} while (0)
+#endif
+
+#define SYSFS_HIDRAW_PATH "/sys/class/hidraw"
+
+/* The largest report hid_write_async() accepts */
+#define ASYNC_OUT_MAX_LENGTH 1024
+
+struct hid_device_ {
+	/* Handle to the /dev/hidrawN node */
+	int device_handle;
+
+	/* /sys/class/hidraw/hidrawN/device, for the strings */
+	char *sysfs_path;
+
+	/* Whether blocking reads are used */
+	int blocking; /* boolean */
+
+	/* Write thread objects, see hid_write_async(). The thread is
+	   started by the first call. */
+	pthread_t write_thread;
+	pthread_mutex_t write_mutex; /* Protects all the write_* members */
+	pthread_cond_t write_condition;
+	int write_thread_started; /* boolean */
+	int write_shutdown; /* boolean */
+	int write_error; /* boolean, set when a write has failed */
+	unsigned char write_pending[ASYNC_OUT_MAX_LENGTH];
+	size_t write_pending_len; /* 0 if nothing is waiting */
+};
+
+static hid_device *new_hid_device(void)
+{
+	hid_device *dev = calloc(1, sizeof(hid_device));
+	dev->device_handle = -1;
+	dev->sysfs_path = NULL;
+	dev->blocking = 1;
+	dev->write_thread_started = 0;
+	dev->write_shutdown = 0;
+	dev->write_error = 0;
+	dev->write_pending_len = 0;
+
+	pthread_mutex_init(&dev->write_mutex, NULL);
+	pthread_cond_init(&dev->write_condition, NULL);
+
+	return dev;
+}
+
+static void free_hid_device(hid_device *dev)
+{
+	pthread_cond_destroy(&dev->write_condition);
+	pthread_mutex_destroy(&dev->write_mutex);
+
+	free(dev->sysfs_path);
+	free(dev);
+}
+
+/* Read the first line of a sysfs attribute. Returns a malloc()ed string
+   without the trailing newline, or NULL if the file can't be read. */
+static char *read_sysfs_string(const char *dir, const char *name)
+{
+	char path[PATH_MAX];
+	char buf[256];
+	size_t len;
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/%s", dir, name);
+	f = fopen(path, "r");
+	if (!f)
+		return NULL;
+
+	if (!fgets(buf, sizeof(buf), f)) {
+		fclose(f);
+		return NULL;
+	}
+	fclose(f);
+
+	len = strlen(buf);
+	while (len > 0 && (buf[len-1] == '\n' || buf[len-1] == '\r'))
+		buf[--len] = '\0';
+
+	return strdup(buf);
+}
+
+/* Find KEY=value in the uevent file of a HID device. */
+static char *read_uevent_value(const char *dir, const char *key)
+{
+	char path[PATH_MAX];
+	char line[256];
+	size_t key_len = strlen(key);
+	char *value = NULL;
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/uevent", dir);
+	f = fopen(path, "r");
+	if (!f)
+		return NULL;
+
+	while (fgets(line, sizeof(line), f)) {
+		if (strncmp(line, key, key_len) == 0 && line[key_len] == '=') {
+			size_t len;
+			value = strdup(line + key_len + 1);
+			len = strlen(value);
+			while (len > 0 && value[len-1] == '\n')
+				value[--len] = '\0';
+			break;
+		}
+	}
+	fclose(f);
+
+	return value;
+}
+
+static wchar_t *utf8_to_wchar_t(const char *utf8)
+{
+	wchar_t *ret = NULL;
+
+	if (utf8) {
+		size_t wlen = mbstowcs(NULL, utf8, 0);
+		if (wlen == (size_t)-1)
+			return wcsdup(L"");
+		ret = calloc(wlen+1, sizeof(wchar_t));
+		mbstowcs(ret, utf8, wlen+1);
+		ret[wlen] = L'\0';
+	}
+
+	return ret;
+}
+
+/* Get bus type, vendor and product from HID_ID=0003:000003EB:0000204F */
+static int parse_hid_id(const char *hid_device_dir, unsigned *bus_type, unsigned short *vendor_id, unsigned short *product_id)
+{
+	char *hid_id = read_uevent_value(hid_device_dir, "HID_ID");
+	unsigned vendor, product;
+	int res;
+
+	if (!hid_id)
+		return -1;
+
+	res = sscanf(hid_id, "%x:%x:%x", bus_type, &vendor, &product);
+	free(hid_id);
+	if (res != 3)
+		return -1;
+
+	*vendor_id = vendor;
+	*product_id = product;
+	return 0;
+}
+
+/* The HID device of a USB device is a child of the USB interface, which
+   is a child of the USB device itself. Returns NULL for other buses and
+   for emulated (uhid) devices. */
+static char *usb_device_dir(const char *hid_device_dir, int levels_up)
+{
+	char path[PATH_MAX];
+	char real[PATH_MAX];
+
+	snprintf(path, sizeof(path), "%s/%s", hid_device_dir, levels_up == 1 ? ".." : "../..");
+	if (!realpath(path, real))
+		return NULL;
+
+	/* Make sure it really is an USB interface or device */
+	snprintf(path, sizeof(path), "%s/%s", real, levels_up == 1 ? "bInterfaceNumber" : "idVendor");
+	if (access(path, R_OK) != 0)
+		return NULL;
+
+	return strdup(real);
+}
+
+static wchar_t *get_device_string(const char *hid_device_dir, const char *usb_attribute, const char *uevent_key)
+{
+	char *usb_dir = usb_device_dir(hid_device_dir, 2);
+	char *str = NULL;
+	wchar_t *ret;
+
+	if (usb_dir) {
+		str = read_sysfs_string(usb_dir, usb_attribute);
+		free(usb_dir);
+	}
+	if (!str && uevent_key)
+		str = read_uevent_value(hid_device_dir, uevent_key);
+	if (!str)
+		return NULL;
+
+	ret = utf8_to_wchar_t(str);
+	free(str);
+	return ret;
+}
+
+int HID_API_EXPORT hid_init(void)
+{
+	/* Needed for mbstowcs() in the string functions */
+	setlocale(LC_ALL, "");
+	return 0;
+}
+
+int HID_API_EXPORT hid_exit(void)
+{
+	return 0;
+}
+
+struct hid_device_info  HID_API_EXPORT *hid_enumerate(unsigned short vendor_id, unsigned short product_id)
+{
+	DIR *dir;
+	struct dirent *entry;
+	struct hid_device_info *root = NULL; // return object
+	struct hid_device_info *cur_dev = NULL;
+
+	hid_init();
+
+	dir = opendir(SYSFS_HIDRAW_PATH);
+	if (!dir)
+		return NULL;
+
+	while ((entry = readdir(dir)) != NULL) {
+		char hid_device_dir[PATH_MAX];
+		char dev_path[PATH_MAX];
+		struct hid_device_info *tmp;
+		unsigned bus_type;
+		unsigned short dev_vid;
+		unsigned short dev_pid;
+		char *usb_dir;
+		char *str;
+
+		if (strncmp(entry->d_name, "hidraw", 6) != 0)
+			continue;
+
+		snprintf(hid_device_dir, sizeof(hid_device_dir), "%s/%s/device", SYSFS_HIDRAW_PATH, entry->d_name);
+		if (parse_hid_id(hid_device_dir, &bus_type, &dev_vid, &dev_pid) < 0)
+			continue;
+
+		if ((vendor_id != 0x0 && vendor_id != dev_vid) ||
+		    (product_id != 0x0 && product_id != dev_pid))
+			continue;
+
+		snprintf(dev_path, sizeof(dev_path), "/dev/%s", entry->d_name);
+
+		tmp = calloc(1, sizeof(struct hid_device_info));
+		if (cur_dev) {
+			cur_dev->next = tmp;
+		}
+		else {
+			root = tmp;
+		}
+		cur_dev = tmp;
+
+		cur_dev->path = strdup(dev_path);
+		cur_dev->vendor_id = dev_vid;
+		cur_dev->product_id = dev_pid;
+		cur_dev->serial_number = get_device_string(hid_device_dir, "serial", "HID_UNIQ");
+		cur_dev->manufacturer_string = get_device_string(hid_device_dir, "manufacturer", NULL);
+		cur_dev->product_string = get_device_string(hid_device_dir, "product", "HID_NAME");
+		cur_dev->interface_number = -1;
+		cur_dev->next = NULL;
+
+		usb_dir = usb_device_dir(hid_device_dir, 1);
+		if (usb_dir) {
+			str = read_sysfs_string(usb_dir, "bInterfaceNumber");
+			if (str)
+				cur_dev->interface_number = strtol(str, NULL, 16);
+			free(str);
+			free(usb_dir);
+		}
+
+		usb_dir = usb_device_dir(hid_device_dir, 2);
+		if (usb_dir) {
+			str = read_sysfs_string(usb_dir, "bcdDevice");
+			if (str)
+				cur_dev->release_number = strtol(str, NULL, 16);
+			free(str);
+			free(usb_dir);
+		}
+	}
+	closedir(dir);
+
+	return root;
+}
+
+void  HID_API_EXPORT hid_free_enumeration(struct hid_device_info *devs)
+{
+	struct hid_device_info *d = devs;
+	while (d) {
+		struct hid_device_info *next = d->next;
+		free(d->path);
+		free(d->serial_number);
+		free(d->manufacturer_string);
+		free(d->product_string);
+		free(d);
+		d = next;
+	}
+}
+
+hid_device * hid_open(unsigned short vendor_id, unsigned short product_id, wchar_t *serial_number)
+{
+	struct hid_device_info *devs, *cur_dev;
+	const char *path_to_open = NULL;
+	hid_device *handle = NULL;
+
+	devs = hid_enumerate(vendor_id, product_id);
+	cur_dev = devs;
+	while (cur_dev) {
+		if (cur_dev->vendor_id == vendor_id &&
+		    cur_dev->product_id == product_id) {
+			if (serial_number) {
+				if (cur_dev->serial_number &&
+				    wcscmp(serial_number, cur_dev->serial_number) == 0) {
+					path_to_open = cur_dev->path;
+					break;
+				}
+			}
+			else {
+				path_to_open = cur_dev->path;
+				break;
+			}
+		}
+		cur_dev = cur_dev->next;
+	}
+
+	if (path_to_open) {
+		/* Open the device */
+		handle = hid_open_path(path_to_open);
+	}
+
+	hid_free_enumeration(devs);
+
+	return handle;
+}
+
+hid_device * HID_API_EXPORT hid_open_path(const char *path)
+{
+	hid_device *dev = NULL;
+	const char *name;
+	char hid_device_dir[PATH_MAX];
+
+	hid_init();
+
+	dev = new_hid_device();
+
+	dev->device_handle = open(path, O_RDWR);
+	if (dev->device_handle < 0) {
+		LOG("can't open %s: %s\n", path, strerror(errno));
+		free_hid_device(dev);
+		return NULL;
+	}
+
+	/* Remember where the strings of this device are */
+	name = strrchr(path, '/');
+	name = name ? name + 1 : path;
+	snprintf(hid_device_dir, sizeof(hid_device_dir), "%s/%s/device", SYSFS_HIDRAW_PATH, name);
+	dev->sysfs_path = strdup(hid_device_dir);
+
+	return dev;
+}
+
+int HID_API_EXPORT hid_write(hid_device *dev, const unsigned char *data, size_t length)
+{
+	/* The kernel takes the Report ID in the first byte and strips
+	   it if it is 0x0, just like hid_write() expects. */
+	int res = write(dev->device_handle, data, length);
+	if (res < 0)
+		LOG("write() failed: %s\n", strerror(errno));
+
+	return res;
+}
+
+static void *write_thread(void *param)
+{
+	hid_device *dev = param;
+	unsigned char buf[ASYNC_OUT_MAX_LENGTH];
+	size_t length;
+
+	pthread_mutex_lock(&dev->write_mutex);
+
+	while (!dev->write_shutdown) {
+		if (dev->write_pending_len == 0) {
+			pthread_cond_wait(&dev->write_condition, &dev->write_mutex);
+			continue;
+		}
+
+		/* Take the newest report and let the producer replace it
+		   while write() is waiting for the device. */
+		length = dev->write_pending_len;
+		memcpy(buf, dev->write_pending, length);
+		dev->write_pending_len = 0;
+
+		pthread_mutex_unlock(&dev->write_mutex);
+
+		if (hid_write(dev, buf, length) < 0) {
+			pthread_mutex_lock(&dev->write_mutex);
+			dev->write_error = 1;
+			continue;
+		}
+
+		pthread_mutex_lock(&dev->write_mutex);
+	}
+
+	pthread_mutex_unlock(&dev->write_mutex);
+
+	return NULL;
+}
+
+int HID_API_EXPORT hid_write_async(hid_device *dev, const unsigned char *data, size_t length)
+{
+	int res = length;
+
+	if (length == 0 || length > ASYNC_OUT_MAX_LENGTH)
+		return -1;
+
+	pthread_mutex_lock(&dev->write_mutex);
+
+	if (!dev->write_thread_started) {
+		if (pthread_create(&dev->write_thread, NULL, write_thread, dev) != 0) {
+			pthread_mutex_unlock(&dev->write_mutex);
+			return hid_write(dev, data, length);
+		}
+		dev->write_thread_started = 1;
+	}
+
+	if (dev->write_error) {
+		/* Report the failure once, the caller is expected to reopen
+		   the device or fall back to hid_write(). */
+		dev->write_error = 0;
+		res = -1;
+	}
+	else {
+		/* One report is being written, this one replaces the report
+		   which is waiting for it, if any. */
+		memcpy(dev->write_pending, data, length);
+		dev->write_pending_len = length;
+		pthread_cond_signal(&dev->write_condition);
+	}
+
+	pthread_mutex_unlock(&dev->write_mutex);
+
+	return res;
+}
+
+int HID_API_EXPORT hid_write_async_pending(hid_device *dev)
+{
+	int res;
+
+	pthread_mutex_lock(&dev->write_mutex);
+	res = (dev->write_pending_len > 0);
+	pthread_mutex_unlock(&dev->write_mutex);
+
+	return res;
+}
+
+int HID_API_EXPORT hid_read_timeout(hid_device *dev, unsigned char *data, size_t length, int milliseconds)
+{
+	int bytes_read;
+
+	if (milliseconds != 0) {
+		/* milliseconds is -1 or > 0. In both cases, we want to
+		   call poll() and wait for data to arrive. -1 means
+		   INFINITE. */
+		struct pollfd fds;
+		int ret;
+
+		fds.fd = dev->device_handle;
+		fds.events = POLLIN;
+		fds.revents = 0;
+		ret = poll(&fds, 1, milliseconds);
+		if (ret == -1 || ret == 0) {
+			/* Error or timeout */
+			return ret;
+		}
+		if (fds.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			/* The device is gone */
+			return -1;
+		}
+	}
+
+	bytes_read = read(dev->device_handle, data, length);
+	if (bytes_read < 0 && (errno == EAGAIN || errno == EINPROGRESS))
+		bytes_read = 0;
+
+	return bytes_read;
+}
+
+int HID_API_EXPORT hid_read(hid_device *dev, unsigned char *data, size_t length)
+{
+	return hid_read_timeout(dev, data, length, (dev->blocking)? -1: 0);
+}
+
+int HID_API_EXPORT hid_set_nonblocking(hid_device *dev, int nonblock)
+{
+	int flags = fcntl(dev->device_handle, F_GETFL, 0);
+	if (flags < 0)
+		return -1;
+
+	flags = nonblock ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+	if (fcntl(dev->device_handle, F_SETFL, flags) < 0)
+		return -1;
+
+	dev->blocking = !nonblock;
+	return 0;
+}
+
+int HID_API_EXPORT hid_send_feature_report(hid_device *dev, const unsigned char *data, size_t length)
+{
+	int res = ioctl(dev->device_handle, HIDIOCSFEATURE(length), data);
+	if (res < 0)
+		LOG("ioctl (SFEATURE): %s\n", strerror(errno));
+
+	return res;
+}
+
+int HID_API_EXPORT hid_get_feature_report(hid_device *dev, unsigned char *data, size_t length)
+{
+	int res = ioctl(dev->device_handle, HIDIOCGFEATURE(length), data);
+	if (res < 0)
+		LOG("ioctl (GFEATURE): %s\n", strerror(errno));
+
+	return res;
+}
+
+void HID_API_EXPORT hid_close(hid_device *dev)
+{
+	if (!dev)
+		return;
+
+	/* Stop write_thread() after the write() it may be waiting for */
+	if (dev->write_thread_started) {
+		pthread_mutex_lock(&dev->write_mutex);
+		dev->write_shutdown = 1;
+		pthread_cond_signal(&dev->write_condition);
+		pthread_mutex_unlock(&dev->write_mutex);
+
+		pthread_join(dev->write_thread, NULL);
+	}
+
+	close(dev->device_handle);
+
+	free_hid_device(dev);
+}
+
+static int copy_device_string(hid_device *dev, const char *usb_attribute, const char *uevent_key, wchar_t *string, size_t maxlen)
+{
+	wchar_t *str = get_device_string(dev->sysfs_path, usb_attribute, uevent_key);
+
+	if (str) {
+		wcsncpy(string, str, maxlen);
+		string[maxlen-1] = L'\0';
+		free(str);
+		return 0;
+	}
+	else
+		return -1;
+}
+
+int HID_API_EXPORT_CALL hid_get_manufacturer_string(hid_device *dev, wchar_t *string, size_t maxlen)
+{
+	return copy_device_string(dev, "manufacturer", NULL, string, maxlen);
+}
+
+int HID_API_EXPORT_CALL hid_get_product_string(hid_device *dev, wchar_t *string, size_t maxlen)
+{
+	return copy_device_string(dev, "product", "HID_NAME", string, maxlen);
+}
+
+int HID_API_EXPORT_CALL hid_get_serial_number_string(hid_device *dev, wchar_t *string, size_t maxlen)
+{
+	return copy_device_string(dev, "serial", "HID_UNIQ", string, maxlen);
+}
+
+int HID_API_EXPORT_CALL hid_get_indexed_string(hid_device *dev, int string_index, wchar_t *string, size_t maxlen)
+{
+	/* hidraw gives no access to the string descriptors by index */
+	return -1;
+}
+
+
+HID_API_EXPORT const wchar_t * HID_API_CALL  hid_error(hid_device *dev)
+{
+	return NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
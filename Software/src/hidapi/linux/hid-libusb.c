@@ -63,6 +63,11 @@ Linux/libusb HIDAPI programs are encouraged to use the interface number
 instead to differentiate between interfaces on a composite HID device. */
 /*#define INVASIVE_GET_USAGE*/
 
+/* Number of interrupt OUT transfers which hid_write_async() keeps in
+   flight, and the largest report it accepts. */
+#define ASYNC_OUT_TRANSFERS 2
+#define ASYNC_OUT_MAX_LENGTH 1024
+
 /* Linked List of input reports received from the device. */
 struct input_report {
 	uint8_t *data;
@@ -101,6 +106,15 @@ struct hid_device_ {
 
 	/* List of received input reports. */
 	struct input_report *input_reports;
+
+	/* Asynchronous output objects, see hid_write_async() */
+	pthread_mutex_t out_mutex; /* Protects all the out_* members */
+	struct libusb_transfer *out_transfers[ASYNC_OUT_TRANSFERS];
+	int out_busy[ASYNC_OUT_TRANSFERS]; /* boolean */
+	unsigned char *out_pending; /* Newest report waiting for a free transfer */
+	size_t out_pending_len; /* 0 if nothing is waiting */
+	int out_error; /* boolean, set when a transfer has failed */
+	int out_closing; /* boolean */
 };
 
 static int initialized = 0;
@@ -123,8 +137,13 @@ static hid_device *new_hid_device(void)
 	dev->shutdown_thread = 0;
 	dev->transfer = NULL;
 	dev->input_reports = NULL;
+	dev->out_pending = NULL;
+	dev->out_pending_len = 0;
+	dev->out_error = 0;
+	dev->out_closing = 0;
 	
 	pthread_mutex_init(&dev->mutex, NULL);
+	pthread_mutex_init(&dev->out_mutex, NULL);
 	pthread_cond_init(&dev->condition, NULL);
 	pthread_barrier_init(&dev->barrier, NULL, 2);
 	
@@ -137,6 +156,7 @@ static void free_hid_device(hid_device *dev)
 	pthread_barrier_destroy(&dev->barrier);
 	pthread_cond_destroy(&dev->condition);
 	pthread_mutex_destroy(&dev->mutex);
+	pthread_mutex_destroy(&dev->out_mutex);
 
 	/* Free the device itself */
 	free(dev);
@@ -671,6 +691,99 @@ static void read_callback(struct libusb_transfer *transfer)
 }
 
 
+/* Copy a report into the buffer of an output transfer and submit it.
+   This should be called with dev->out_mutex locked. */
+static int submit_output_transfer(hid_device *dev, int index, const unsigned char *data, size_t length)
+{
+	struct libusb_transfer *transfer = dev->out_transfers[index];
+	int report_number = data[0];
+	int res;
+
+	if (report_number == 0x0) {
+		data++;
+		length--;
+	}
+
+	if (dev->output_endpoint <= 0) {
+		/* No interrput out endpoint. Use the Control Endpoint */
+		libusb_fill_control_setup(transfer->buffer,
+			LIBUSB_REQUEST_TYPE_CLASS|LIBUSB_RECIPIENT_INTERFACE|LIBUSB_ENDPOINT_OUT,
+			0x09/*HID Set_Report*/,
+			(2/*HID output*/ << 8) | report_number,
+			dev->interface,
+			length);
+		memcpy(transfer->buffer + LIBUSB_CONTROL_SETUP_SIZE, data, length);
+		transfer->endpoint = 0;
+		transfer->type = LIBUSB_TRANSFER_TYPE_CONTROL;
+		transfer->length = LIBUSB_CONTROL_SETUP_SIZE + length;
+	}
+	else {
+		memcpy(transfer->buffer, data, length);
+		transfer->endpoint = dev->output_endpoint;
+		transfer->type = LIBUSB_TRANSFER_TYPE_INTERRUPT;
+		transfer->length = length;
+	}
+
+	res = libusb_submit_transfer(transfer);
+	if (res < 0) {
+		LOG("Unable to submit output transfer: %d\n", res);
+		return -1;
+	}
+
+	dev->out_busy[index] = 1;
+	return 0;
+}
+
+static void write_callback(struct libusb_transfer *transfer)
+{
+	hid_device *dev = transfer->user_data;
+	int index;
+
+	pthread_mutex_lock(&dev->out_mutex);
+
+	for (index = 0; index < ASYNC_OUT_TRANSFERS; index++) {
+		if (dev->out_transfers[index] == transfer)
+			break;
+	}
+	dev->out_busy[index] = 0;
+
+	if (transfer->status != LIBUSB_TRANSFER_COMPLETED && !dev->out_closing) {
+		LOG("Output transfer failed: %d\n", transfer->status);
+		dev->out_error = 1;
+	}
+
+	/* Send the newest report which came in while all the transfers
+	   were busy. */
+	if (dev->out_pending_len > 0 && !dev->out_closing && !dev->out_error) {
+		if (submit_output_transfer(dev, index, dev->out_pending, dev->out_pending_len) < 0)
+			dev->out_error = 1;
+		dev->out_pending_len = 0;
+	}
+
+	pthread_mutex_unlock(&dev->out_mutex);
+}
+
+/* Stop sending reports and cancel the output transfers still in flight.
+   Returns the number of transfers which have not completed yet. */
+static int cancel_output_transfers(hid_device *dev)
+{
+	int i;
+	int busy = 0;
+
+	pthread_mutex_lock(&dev->out_mutex);
+	dev->out_closing = 1;
+	dev->out_pending_len = 0;
+	for (i = 0; i < ASYNC_OUT_TRANSFERS; i++) {
+		if (dev->out_busy[i]) {
+			libusb_cancel_transfer(dev->out_transfers[i]);
+			busy++;
+		}
+	}
+	pthread_mutex_unlock(&dev->out_mutex);
+
+	return busy;
+}
+
 static void *read_thread(void *param)
 {
 	hid_device *dev = param;
@@ -712,6 +825,13 @@ static void *read_thread(void *param)
 		/* The transfer was cancelled, so wait for its completion. */
 		libusb_handle_events(NULL);
 	}
+
+	/* Output transfers complete on this thread too, so wait for them
+	   before the event loop goes away. */
+	while (cancel_output_transfers(dev) > 0) {
+		if (libusb_handle_events(NULL) < 0)
+			break;
+	}
 	
 	/* Now that the read thread is stopping, Wake any threads which are
 	   waiting on data (in hid_read_timeout()). Do this under a mutex to
@@ -842,6 +962,21 @@ hid_device * HID_API_EXPORT hid_open_path(const char *path)
 							}
 						}
 						
+						/* Output transfers for hid_write_async(). They
+						   are completed by the event loop in read_thread(). */
+						for (i = 0; i < ASYNC_OUT_TRANSFERS; i++) {
+							dev->out_transfers[i] = libusb_alloc_transfer(0);
+							libusb_fill_interrupt_transfer(dev->out_transfers[i],
+								dev->device_handle,
+								dev->output_endpoint,
+								malloc(LIBUSB_CONTROL_SETUP_SIZE + ASYNC_OUT_MAX_LENGTH),
+								0,
+								write_callback,
+								dev,
+								1000/*timeout millis*/);
+						}
+						dev->out_pending = malloc(ASYNC_OUT_MAX_LENGTH);
+
 						pthread_create(&dev->thread, NULL, read_thread, dev);
 						
 						// Wait here for the read thread to be initialized.
@@ -920,6 +1055,56 @@ int HID_API_EXPORT hid_write(hid_device *dev, const unsigned char *data, size_t
 	}
 }
 
+int HID_API_EXPORT hid_write_async(hid_device *dev, const unsigned char *data, size_t length)
+{
+	int i;
+	int res = length;
+
+	if (length == 0 || length > ASYNC_OUT_MAX_LENGTH)
+		return -1;
+
+	pthread_mutex_lock(&dev->out_mutex);
+
+	if (dev->out_closing || dev->out_error) {
+		/* Report the failure once, the caller is expected to reopen
+		   the device or fall back to hid_write(). */
+		dev->out_error = 0;
+		res = -1;
+	}
+	else {
+		for (i = 0; i < ASYNC_OUT_TRANSFERS; i++) {
+			if (!dev->out_busy[i])
+				break;
+		}
+
+		if (i < ASYNC_OUT_TRANSFERS) {
+			if (submit_output_transfer(dev, i, data, length) < 0)
+				res = -1;
+		}
+		else {
+			/* All the transfers are in flight. Replace the report
+			   which is waiting for them, if any. */
+			memcpy(dev->out_pending, data, length);
+			dev->out_pending_len = length;
+		}
+	}
+
+	pthread_mutex_unlock(&dev->out_mutex);
+
+	return res;
+}
+
+int HID_API_EXPORT hid_write_async_pending(hid_device *dev)
+{
+	int res;
+
+	pthread_mutex_lock(&dev->out_mutex);
+	res = (dev->out_pending_len > 0);
+	pthread_mutex_unlock(&dev->out_mutex);
+
+	return res;
+}
+
 /* Helper function, to simplify hid_read().
    This should be called with dev->mutex locked. */
 static int return_data(hid_device *dev, unsigned char *data, size_t length)
@@ -1104,6 +1289,8 @@ int HID_API_EXPORT hid_get_feature_report(hid_device *dev, unsigned char *data,
 
 void HID_API_EXPORT hid_close(hid_device *dev)
 {
+	int i;
+
 	if (!dev)
 		return;
 	
@@ -1117,6 +1304,13 @@ void HID_API_EXPORT hid_close(hid_device *dev)
 	/* Clean up the Transfer objects allocated in read_thread(). */
 	free(dev->transfer->buffer);
 	libusb_free_transfer(dev->transfer);
+
+	/* read_thread() has waited for the output transfers to complete. */
+	for (i = 0; i < ASYNC_OUT_TRANSFERS; i++) {
+		free(dev->out_transfers[i]->buffer);
+		libusb_free_transfer(dev->out_transfers[i]);
+	}
+	free(dev->out_pending);
 	
 	/* release the interface */
 	libusb_release_interface(dev->device_handle, dev->interface);
@@ -836,6 +836,17 @@ int HID_API_EXPORT hid_write(hid_device *dev, const unsigned char *data, size_t
 	return set_report(dev, kIOHIDReportTypeOutput, data, length);
 }
 
+int HID_API_EXPORT hid_write_async(hid_device *dev, const unsigned char *data, size_t length)
+{
+	/* No asynchronous output on Mac yet */
+	return hid_write(dev, data, length);
+}
+
+int HID_API_EXPORT hid_write_async_pending(hid_device *dev)
+{
+	return 0;
+}
+
 /* Helper function, so that this isn't duplicated in hid_read(). */
 static int return_data(hid_device *dev, unsigned char *data, size_t length)
 {
@@ -598,6 +598,17 @@ int HID_API_EXPORT HID_API_CALL hid_write(hid_device *dev, const unsigned char *
 	return bytes_written;
 }
 
+int HID_API_EXPORT HID_API_CALL hid_write_async(hid_device *dev, const unsigned char *data, size_t length)
+{
+	// No asynchronous output on Windows yet
+	return hid_write(dev, data, length);
+}
+
+int HID_API_EXPORT HID_API_CALL hid_write_async_pending(hid_device *dev)
+{
+	return 0;
+}
+
 
 int HID_API_EXPORT HID_API_CALL hid_read_timeout(hid_device *dev, unsigned char *data, size_t length, int milliseconds)
 {
@@ -1476,6 +1476,20 @@ qint64 AbstractSerial::bytesToWrite() const
     return qint64(d->writeBuffer.size());
 }
 
+/*! \~english
+    \fn qint64 AbstractSerial::bytesInOutputQueue() const
+    Returns the number of bytes accepted by the serial driver but not yet transmitted
+    (TIOCOUTQ on *.nix, COMSTAT::cbOutQue on Windows).
+    \return Number of bytes or -1 if the device is not open or the query is not supported.
+*/
+qint64 AbstractSerial::bytesInOutputQueue() const
+{
+    Q_D(const AbstractSerial);
+    if (!this->isOpen() || !d->serialEngine)
+        return qint64(-1);
+    return d->serialEngine->currentTxQueue();
+}
+
 /*! \~english
     Returns true if a line of data can be read from the serial;
     otherwise returns false.
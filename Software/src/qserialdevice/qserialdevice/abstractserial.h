@@ -313,6 +313,7 @@ public:
 
     qint64 bytesAvailable() const;
     qint64 bytesToWrite() const;
+    qint64 bytesInOutputQueue() const;
 
     bool canReadLine() const;
 
@@ -120,6 +120,9 @@ public:
     virtual bool isLineNotificationEnabled() const = 0;
     virtual void setLineNotificationEnabled(bool enable, bool onClose = false) = 0;
 
+    virtual qint64 currentTxQueue() const = 0;
+    virtual qint64 currentRxQueue() const = 0;
+
     void setReceiver(AbstractSerialEngineReceiver *receiver);
 
 public Q_SLOTS:
@@ -132,10 +135,6 @@ protected:
     AbstractSerialEngine(AbstractSerialEnginePrivate &dd, QObject *parent);
     AbstractSerialEnginePrivate * const d_ptr;
 
-    //add 05.11.2009 (while is not used, reserved)
-    virtual qint64 currentTxQueue() const = 0;
-    virtual qint64 currentRxQueue() const = 0;
-
 private:
     Q_DECLARE_PRIVATE(AbstractSerialEngine)
     Q_DISABLE_COPY(AbstractSerialEngine)
@@ -172,8 +172,12 @@ qint64 NativeSerialEngine::write(const char *data, qint64 maxSize)
         qint64 bytesToWrite = qMin<qint64>(WRITE_CHUNKSIZE, maxSize - ret);
         qint64 bytesWritten = d->nativeWrite((const char*)(data + ret), bytesToWrite);
 
-        if ((bytesWritten <= 0) || (bytesWritten != bytesToWrite))
-            return qint64(-1);
+        if (bytesWritten < 0)
+            return (ret > 0) ? ret : qint64(-1);
+
+        // Output queue is full (non-blocking descriptor), report what was accepted
+        if (bytesWritten != bytesToWrite)
+            return ret + bytesWritten;
 
         ret += bytesWritten;
 
@@ -312,14 +316,12 @@ void NativeSerialEngine::clearNotification()
 //    d->notifier = 0;
 }
 
-//add 05.11.2009  (while is not used, reserved)
 qint64 NativeSerialEngine::currentTxQueue() const
 {
     Q_D(const NativeSerialEngine);
     return d->nativeCurrentQueue(txQueue);
 }
 
-//add 05.11.2009  (while is not used, reserved)
 qint64 NativeSerialEngine::currentRxQueue() const
 {
     Q_D(const NativeSerialEngine);
@@ -81,12 +81,13 @@ public:
 
     void clearNotification();
 
+    qint64 currentTxQueue() const;
+    qint64 currentRxQueue() const;
+
 protected:
 
     //add 05.11.2009
     enum ioQueue{ txQueue, rxQueue };
-    qint64 currentTxQueue() const;
-    qint64 currentRxQueue() const;
 
 private:
     Q_DECLARE_PRIVATE(NativeSerialEngine)
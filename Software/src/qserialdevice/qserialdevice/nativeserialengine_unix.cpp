@@ -824,10 +824,10 @@ qint64 NativeSerialEnginePrivate::nativeBytesAvailable() const
 
 qint64 NativeSerialEnginePrivate::nativeWrite(const char *data, qint64 len)
 {
+    // Don't wait for transmission here (tcdrain), use flush() for it.
+    // Callers can check the output queue occupancy with currentTxQueue().
     qint64 bytesWritten = qt_safe_write(this->descriptor, (const void *)data, (size_t)len);
 
-    this->nativeFlush();
-
     if (bytesWritten < 0) {
         switch (errno) {
         case EPIPE:
@@ -966,9 +966,28 @@ int NativeSerialEnginePrivate::nativeSelect(int timeout,
 //added 06.11.2009 (while is not used)
 qint64 NativeSerialEnginePrivate::nativeCurrentQueue(NativeSerialEngine::ioQueue Queue) const
 {
-    Q_UNUSED(Queue)
-    /* not supported */
-    return qint64(-1);
+    int arg = 0;
+    switch (Queue) {
+#if defined (TIOCOUTQ)
+    case NativeSerialEngine::txQueue: arg = TIOCOUTQ; break;
+#endif
+#if defined (TIOCINQ)
+    case NativeSerialEngine::rxQueue: arg = TIOCINQ; break;
+#endif
+    default:
+        /* not supported */
+        return qint64(-1);
+    }
+
+    int nbytes = 0;
+    if (-1 == ::ioctl(this->descriptor, arg, &nbytes)) {
+#if defined (NATIVESERIALENGINE_UNIX_DEBUG)
+        qDebug("Linux: NativeSerialEnginePrivate::nativeCurrentQueue(NativeSerialEngine::ioQueue Queue) \n"
+               " -> function: ::ioctl(this->descriptor, arg, &nbytes) returned: -1. Error! \n");
+#endif
+        return qint64(-1);
+    }
+    return qint64(nbytes);
 }
 
 void NativeSerialEnginePrivate::initVariables()
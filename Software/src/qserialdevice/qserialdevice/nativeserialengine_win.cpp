@@ -787,28 +787,24 @@ int NativeSerialEnginePrivate::nativeSelect(int timeout,
     return int(selectResult);
 }
 
-//added 05.11.2009 (experimental)
 qint64 NativeSerialEnginePrivate::nativeCurrentQueue(NativeSerialEngine::ioQueue Queue) const
 {
-    Q_UNUSED(Queue)
-    /*
-    COMMPROP commProp = {0};
-
-    if (!(::GetCommProperties(this->descriptor, &commProp))) {
-    #if defined (NATIVESERIALENGINE_WIN_DEBUG)
-    qDebug() << "Windows: NativeSerialEnginePrivate::nativeCurrentQueue(NativeSerialEngine::ioQueue Queue) \n"
-    " -> function: ::GetCommProperties(this->descriptor, &commProp) returned: false. Error! \n";
-    #endif
-    return (qint64)-1;
+    ::DWORD err = 0;
+    ::COMSTAT cs = {0};
+
+    if (0 == ::ClearCommError(this->descriptor, &err, &cs)) {
+#if defined (NATIVESERIALENGINE_WIN_DEBUG)
+        qDebug("Windows: NativeSerialEnginePrivate::nativeCurrentQueue(NativeSerialEngine::ioQueue Queue) \n"
+               " -> function: ::ClearCommError(this->descriptor, &err, &cs) returned: 0. Error! \n");
+#endif
+        return qint64(-1);
     }
 
     switch (Queue) {
-    case NativeSerialEngine::txQueue : return (qint64)commProp.dwCurrentTxQueue;
-    case NativeSerialEngine::rxQueue : return (qint64)commProp.dwCurrentRxQueue;
-    default: return (qint64)-1;
+    case NativeSerialEngine::txQueue : return qint64(cs.cbOutQue);
+    case NativeSerialEngine::rxQueue : return qint64(cs.cbInQue);
+    default: return qint64(-1);
     }
-    */
-    return qint64(-1);
 }
 
 // Clear all used variables.
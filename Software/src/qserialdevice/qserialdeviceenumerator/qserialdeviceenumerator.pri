@@ -1,15 +1,14 @@
-HEADERS += $$PWD/serialdeviceenumerator.h \
-    $$PWD/serialdeviceenumerator_p.h
-SOURCES += $$PWD/serialdeviceenumerator.cpp
-win32 {
-    SOURCES += $$PWD/serialdeviceenumerator_p_win.cpp
-}
-unix {
-    macx {
-        SOURCES += $$PWD/serialdeviceenumerator_p_mac.cpp
-    }
-    !macx {
-        SOURCES += $$PWD/serialdeviceenumerator_p_unix.cpp
-    }
+# Only udev implementation is enabled, Windows and Mac OS ones are commented out
+unix:!macx {
+    HEADERS += $$PWD/serialdeviceenumerator.h \
+        $$PWD/serialdeviceenumerator_p.h
+    SOURCES += $$PWD/serialdeviceenumerator.cpp \
+        $$PWD/serialdeviceenumerator_p_unix.cpp
 }
+#win32 {
+#    SOURCES += $$PWD/serialdeviceenumerator_p_win.cpp
+#}
+#macx {
+#    SOURCES += $$PWD/serialdeviceenumerator_p_mac.cpp
+#}
 INCLUDEPATH += $$PWD
@@ -39,7 +39,7 @@ TRANSLATIONS = ../res/translations/ru_RU.ts
 RESOURCES    = ../res/LightpackResources.qrc
 RC_FILE      = ../res/Lightpack.rc
 
-unix{
+unix:!hidraw{
     CONFIG    += link_pkgconfig
     PKGCONFIG += libusb-1.0
 }
@@ -56,9 +56,14 @@ win32 {
 }
 
 unix:!macx{
-    # Linux version using libusb and hidapi codes
-    SOURCES += hidapi/linux/hid-libusb.c
-    # For QSerialDevice
+    hidraw {
+        # Linux version using kernel hidraw driver, run "qmake CONFIG+=hidraw"
+        SOURCES += hidapi/linux/hid-hidraw.c
+    } else {
+        # Linux version using libusb and hidapi codes
+        SOURCES += hidapi/linux/hid-libusb.c
+    }
+    # For QSerialDevice and UsbHotplugMonitor
     LIBS += -ludev
 }
 
@@ -86,12 +91,15 @@ SOURCES += \
     Settings.cpp \
     AboutDialog.cpp \
     GrabManager.cpp \
-    GrabWidget.cpp \
+    LedZone.cpp \
+    GrabOverlay.cpp \
     GrabConfigWidget.cpp \
     SpeedTest.cpp \
     LedDeviceFactory.cpp \
     LedDeviceLightpack.cpp \
     LedDeviceAlienFx.cpp \
+    AbstractLedDevice.cpp \
+    LedDeviceSerial.cpp \
     LedDeviceAdalight.cpp \
     LedDeviceArdulight.cpp \
     LedDeviceVirtual.cpp \
@@ -106,6 +114,18 @@ SOURCES += \
     ApiServer.cpp \
     ApiServerSetColorTask.cpp \
     LightpackMath.cpp \
+    LedSamplingMatrix.cpp \
+    LedLayout.cpp \
+    LedFrameEncoder.cpp \
+    SerialFrameWriter.cpp \
+    UdpPacketSender.cpp \
+    LedDeviceUdp.cpp \
+    LedDeviceDmx.cpp \
+    UsbHotplugMonitor.cpp \
+    VirtualLedsWidget.cpp \
+    LedFrameLog.cpp \
+    LedFrameReplayer.cpp \
+    LedFrameMailbox.cpp \
     MoodLampManager.cpp
 
 HEADERS += \
@@ -117,7 +137,8 @@ HEADERS += \
     AboutDialog.hpp \
     TimeEvaluations.hpp \
     GrabManager.hpp \
-    GrabWidget.hpp \
+    LedZone.hpp \
+    GrabOverlay.hpp \
     GrabConfigWidget.hpp \
     debug.h \
     SpeedTest.hpp \
@@ -127,6 +148,8 @@ HEADERS += \
     ILedDevice.hpp \    
     LedDeviceLightpack.hpp \
     LedDeviceAlienFx.hpp \
+    AbstractLedDevice.hpp \
+    LedDeviceSerial.hpp \
     LedDeviceAdalight.hpp \
     LedDeviceArdulight.hpp \
     LedDeviceVirtual.hpp \
@@ -148,12 +171,24 @@ HEADERS += \
     ../../CommonHeaders/USB_ID.h \
     grab/D3D9Grabber.hpp \
     LightpackMath.hpp \
+    LedSamplingMatrix.hpp \
+    LedLayout.hpp \
+    LedFrameEncoder.hpp \
+    SerialFrameWriter.hpp \
+    SerialFrameEncoder.hpp \
+    UdpPacketSender.hpp \
+    LedDeviceUdp.hpp \
+    LedDeviceDmx.hpp \
+    UsbHotplugMonitor.hpp \
+    VirtualLedsWidget.hpp \
+    LedFrameLog.hpp \
+    LedFrameReplayer.hpp \
+    LedFrameMailbox.hpp \
     StructRgb.hpp \
     MoodLampManager.hpp
 
 FORMS += SettingsWindow.ui \
     AboutDialog.ui \
-    GrabWidget.ui \
     GrabConfigWidget.ui
 
 #
@@ -0,0 +1,347 @@
+/*
+ * HidrawTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtCore/QCoreApplication>
+
+#include "hidapi.h"
+#include "../../../CommonHeaders/USB_ID.h"
+#include "../../../CommonHeaders/COMMANDS.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <linux/uhid.h>
+#include <linux/input.h>
+
+// Lightpack-like device emulated with uhid: one 64 bytes input and
+// one 64 bytes output report without report ID.
+// Needs write access to /dev/uhid, i.e. run it as root.
+
+#define UHID_DEVICE_NAME    "Lightpack uhid test"
+#define REPORT_SIZE         64
+
+static const unsigned char ReportDescriptor[] = {
+    0x06, 0x00, 0xFF,   // Usage Page (Vendor Defined 0xFF00)
+    0x09, 0x01,         // Usage (0x01)
+    0xA1, 0x01,         // Collection (Application)
+    0x15, 0x00,         //   Logical Minimum (0)
+    0x26, 0xFF, 0x00,   //   Logical Maximum (255)
+    0x75, 0x08,         //   Report Size (8)
+    0x95, REPORT_SIZE,  //   Report Count (64)
+    0x09, 0x02,         //   Usage (0x02)
+    0x81, 0x02,         //   Input (Data, Variable, Absolute)
+    0x95, REPORT_SIZE,  //   Report Count (64)
+    0x09, 0x03,         //   Usage (0x03)
+    0x91, 0x02,         //   Output (Data, Variable, Absolute)
+    0xC0                // End Collection
+};
+
+class HidrawTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    HidrawTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testCase_Enumerate();
+    void testCase_Write();
+    void testCase_WriteAsyncKeepsNewest();
+    void testCase_Read();
+    void testCase_ReadNonBlocking();
+
+    void benchmark_WriteLatency();
+    void benchmark_WriteCpuUsage();
+
+private:
+    bool createUhidDevice();
+    void destroyUhidDevice();
+    bool readUhidOutput(QByteArray & output, int timeout);
+    bool writeUhidInput(const QByteArray & input);
+    QByteArray makeFrame(int seed);
+    QByteArray writeFrame(int seed);
+
+private:
+    int m_uhid;
+    hid_device *m_hidDevice;
+};
+
+HidrawTest::HidrawTest()
+{
+    m_uhid = -1;
+    m_hidDevice = NULL;
+}
+
+void HidrawTest::initTestCase()
+{
+    m_uhid = open("/dev/uhid", O_RDWR | O_CLOEXEC);
+    if (m_uhid < 0)
+        QSKIP("/dev/uhid isn't available, run tests as root with uhid module loaded", SkipAll);
+
+    QVERIFY(createUhidDevice());
+
+    // Wait for kernel to create /dev/hidrawN
+    QString path;
+    for (int i = 0; i < 100 && path.isEmpty(); i++)
+    {
+        struct hid_device_info *devs = hid_enumerate(USB_VENDOR_ID, USB_PRODUCT_ID);
+        for (struct hid_device_info *cur = devs; cur != NULL; cur = cur->next)
+        {
+            if (cur->product_string && QString::fromWCharArray(cur->product_string) == UHID_DEVICE_NAME)
+                path = cur->path;
+        }
+        hid_free_enumeration(devs);
+
+        if (path.isEmpty())
+            QTest::qWait(20);
+    }
+    QVERIFY2(!path.isEmpty(), "hidraw node of uhid device not found");
+
+    m_hidDevice = hid_open_path(path.toLocal8Bit().constData());
+    QVERIFY(m_hidDevice != NULL);
+}
+
+void HidrawTest::cleanupTestCase()
+{
+    if (m_hidDevice != NULL)
+        hid_close(m_hidDevice);
+
+    if (m_uhid >= 0)
+    {
+        destroyUhidDevice();
+        close(m_uhid);
+    }
+}
+
+void HidrawTest::testCase_Enumerate()
+{
+    struct hid_device_info *devs = hid_enumerate(USB_VENDOR_ID, USB_PRODUCT_ID);
+    bool found = false;
+
+    for (struct hid_device_info *cur = devs; cur != NULL; cur = cur->next)
+    {
+        QCOMPARE(cur->vendor_id, (unsigned short)USB_VENDOR_ID);
+        QCOMPARE(cur->product_id, (unsigned short)USB_PRODUCT_ID);
+        QVERIFY(QString(cur->path).startsWith("/dev/hidraw"));
+
+        if (cur->product_string && QString::fromWCharArray(cur->product_string) == UHID_DEVICE_NAME)
+            found = true;
+    }
+    hid_free_enumeration(devs);
+
+    QVERIFY(found);
+
+    wchar_t product[64];
+    QCOMPARE(hid_get_product_string(m_hidDevice, product, 64), 0);
+    QCOMPARE(QString::fromWCharArray(product), QString(UHID_DEVICE_NAME));
+}
+
+void HidrawTest::testCase_Write()
+{
+    QByteArray frame = makeFrame(1);
+    QCOMPARE(hid_write(m_hidDevice, (const unsigned char *)frame.constData(), frame.size()), frame.size());
+
+    QByteArray output;
+    QVERIFY(readUhidOutput(output, 1000));
+
+    // Report ID 0x00 isn't sent to device
+    QCOMPARE(output.right(REPORT_SIZE), frame.mid(1));
+}
+
+void HidrawTest::testCase_WriteAsyncKeepsNewest()
+{
+    const int framesCount = 10;
+    QByteArray frame;
+
+    for (int i = 0; i < framesCount; i++)
+    {
+        frame = makeFrame(100 + i);
+        QCOMPARE(hid_write_async(m_hidDevice, (const unsigned char *)frame.constData(), frame.size()), frame.size());
+    }
+
+    // Queued frames can be replaced, but the last one must be sent
+    QByteArray output;
+    int outputsCount = 0;
+    while (readUhidOutput(output, 200))
+    {
+        outputsCount++;
+        if (output.right(REPORT_SIZE) == frame.mid(1))
+            break;
+    }
+
+    QCOMPARE(output.right(REPORT_SIZE), frame.mid(1));
+    QVERIFY(outputsCount <= framesCount);
+}
+
+void HidrawTest::testCase_Read()
+{
+    QByteArray input = makeFrame(2).mid(1);
+    QVERIFY(writeUhidInput(input));
+
+    unsigned char buf[REPORT_SIZE + 1];
+    int bytesRead = hid_read_timeout(m_hidDevice, buf, sizeof(buf), 1000);
+
+    QCOMPARE(bytesRead, REPORT_SIZE);
+    QCOMPARE(QByteArray((const char *)buf, bytesRead), input);
+}
+
+void HidrawTest::testCase_ReadNonBlocking()
+{
+    unsigned char buf[REPORT_SIZE + 1];
+
+    QCOMPARE(hid_set_nonblocking(m_hidDevice, 1), 0);
+    QCOMPARE(hid_read(m_hidDevice, buf, sizeof(buf)), 0);
+    QCOMPARE(hid_set_nonblocking(m_hidDevice, 0), 0);
+}
+
+void HidrawTest::benchmark_WriteLatency()
+{
+    // Time from hid_write() call to the moment when "device" gets the report
+    int seed = 0;
+    QBENCHMARK {
+        writeFrame(seed++);
+    }
+}
+
+void HidrawTest::benchmark_WriteCpuUsage()
+{
+    const int framesCount = 1000;
+
+    struct rusage before, after;
+    getrusage(RUSAGE_SELF, &before);
+
+    QTime time;
+    time.start();
+
+    for (int i = 0; i < framesCount; i++)
+        QVERIFY(!writeFrame(i).isEmpty());
+
+    int elapsed = time.elapsed();
+    getrusage(RUSAGE_SELF, &after);
+
+    qint64 cpuUsec = (after.ru_utime.tv_sec - before.ru_utime.tv_sec) * 1000000LL
+            + (after.ru_utime.tv_usec - before.ru_utime.tv_usec)
+            + (after.ru_stime.tv_sec - before.ru_stime.tv_sec) * 1000000LL
+            + (after.ru_stime.tv_usec - before.ru_stime.tv_usec);
+
+    // Includes reading reports on "device" side, so it's upper bound
+    qDebug() << framesCount << "frames in" << elapsed << "ms,"
+             << "CPU time per frame:" << (double)cpuUsec / framesCount << "us";
+}
+
+bool HidrawTest::createUhidDevice()
+{
+    struct uhid_event ev;
+    memset(&ev, 0, sizeof(ev));
+
+    ev.type = UHID_CREATE2;
+    strcpy((char *)ev.u.create2.name, UHID_DEVICE_NAME);
+    memcpy(ev.u.create2.rd_data, ReportDescriptor, sizeof(ReportDescriptor));
+    ev.u.create2.rd_size = sizeof(ReportDescriptor);
+    ev.u.create2.bus = BUS_USB;
+    ev.u.create2.vendor = USB_VENDOR_ID;
+    ev.u.create2.product = USB_PRODUCT_ID;
+
+    return write(m_uhid, &ev, sizeof(ev)) == sizeof(ev);
+}
+
+void HidrawTest::destroyUhidDevice()
+{
+    struct uhid_event ev;
+    memset(&ev, 0, sizeof(ev));
+
+    ev.type = UHID_DESTROY;
+
+    if (write(m_uhid, &ev, sizeof(ev)) != sizeof(ev))
+        qWarning() << Q_FUNC_INFO << "UHID_DESTROY failed";
+}
+
+bool HidrawTest::readUhidOutput(QByteArray & output, int timeout)
+{
+    struct pollfd fds;
+    fds.fd = m_uhid;
+    fds.events = POLLIN;
+
+    // Skip UHID_START, UHID_OPEN and other events
+    while (poll(&fds, 1, timeout) > 0)
+    {
+        struct uhid_event ev;
+        if (read(m_uhid, &ev, sizeof(ev)) <= 0)
+            return false;
+
+        if (ev.type == UHID_OUTPUT)
+        {
+            output = QByteArray((const char *)ev.u.output.data, ev.u.output.size);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HidrawTest::writeUhidInput(const QByteArray & input)
+{
+    struct uhid_event ev;
+    memset(&ev, 0, sizeof(ev));
+
+    ev.type = UHID_INPUT2;
+    memcpy(ev.u.input2.data, input.constData(), input.size());
+    ev.u.input2.size = input.size();
+
+    return write(m_uhid, &ev, sizeof(ev)) == sizeof(ev);
+}
+
+QByteArray HidrawTest::makeFrame(int seed)
+{
+    // Same layout as LedDeviceLightpack write buffer: report ID, command, data
+    QByteArray frame(REPORT_SIZE + 1, 0);
+    frame[1] = CMD_UPDATE_LEDS;
+    for (int i = 2; i < frame.size(); i++)
+        frame[i] = (char)(seed + i);
+    return frame;
+}
+
+QByteArray HidrawTest::writeFrame(int seed)
+{
+    QByteArray frame = makeFrame(seed);
+    QByteArray output;
+
+    if (hid_write(m_hidDevice, (const unsigned char *)frame.constData(), frame.size()) != frame.size())
+        return QByteArray();
+
+    if (!readUhidOutput(output, 1000))
+        return QByteArray();
+
+    return output;
+}
+
+QTEST_MAIN(HidrawTest)
+
+#include "HidrawTest.moc"
@@ -0,0 +1,34 @@
+#-------------------------------------------------
+#
+# Project created by hands 2026-10-19T12:00:00
+#
+# Tests of hidraw backend of hidapi with device
+# emulated by uhid, run it as root
+#
+#-------------------------------------------------
+
+QT         += testlib
+
+QT         -= gui
+
+TARGET      = HidrawTest
+DESTDIR     = bin
+
+CONFIG     += console
+CONFIG     -= app_bundle
+
+TEMPLATE    = app
+
+# QMake and GCC produce a lot of stuff
+OBJECTS_DIR = stuff
+MOC_DIR     = stuff
+UI_DIR      = stuff
+RCC_DIR     = stuff
+
+
+INCLUDEPATH += ../../src/hidapi
+SOURCES += \
+    HidrawTest.cpp \
+    ../../src/hidapi/linux/hid-hidraw.c
+HEADERS += \
+    ../../src/hidapi/hidapi.h
@@ -0,0 +1,287 @@
+/*
+ * LedDeviceDmxTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtCore/QCoreApplication>
+#include <QtNetwork>
+
+#include "debug.h"
+#include "Settings.hpp"
+#include "LedDeviceDmx.hpp"
+#include "LedDeviceTestHelpers.hpp"
+
+using namespace SettingsScope;
+using namespace LedDeviceTestHelpers;
+
+// LedDeviceDmx sends frames to local UDP socket on E1.31 or Art-Net port,
+// which stands in for DMX over IP controller.
+
+#define START_UNIVERSE      7
+#define UNIVERSES_COUNT     24
+#define FRAME_RATE          40
+
+class LedDeviceDmxTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    LedDeviceDmxTest();
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testCase_E131Frame();
+    void testCase_ArtNetFrame();
+    void testCase_E131Sequence();
+    void testCase_FrameLongerThanMaximum();
+
+    void benchmark_E131SustainedRate();
+
+private:
+    LedDeviceDmx * createDevice(LedDeviceDmx::Protocol protocol, QUdpSocket * listener);
+
+    static int e131Universe(const QByteArray & packet) { return ((quint8)packet[113] << 8) | (quint8)packet[114]; }
+    static int e131Sequence(const QByteArray & packet) { return (quint8)packet[111]; }
+    static bool isE131Sync(const QByteArray & packet) { return packet.size() == LedDeviceDmx::E131SyncPacketSize && packet[21] == 0x08; }
+};
+
+LedDeviceDmxTest::LedDeviceDmxTest()
+{
+}
+
+void LedDeviceDmxTest::initTestCase()
+{
+    Settings::Initialize(QDir::currentPath(), true);
+}
+
+void LedDeviceDmxTest::testCase_E131Frame()
+{
+    QUdpSocket listener;
+    QVERIFY(listener.bind(QHostAddress::LocalHost, LedDeviceDmx::E131Port));
+
+    LedDeviceDmx *device = createDevice(LedDeviceDmx::ProtocolE131, &listener);
+    QVERIFY(device != NULL);
+
+    const int ledsCount = 2 * LedDeviceDmx::LedsPerUniverse + 10;
+    QList<QRgb> colors = makeColors(ledsCount, 1);
+
+    device->setColors(colors);
+
+    QList<QByteArray> packets = receivePackets(&listener, 4, 1000);
+    QCOMPARE(packets.count(), 4);
+
+    // Universes in order, then sync
+    for (int i = 0; i < 3; i++)
+    {
+        QByteArray packet = packets[i];
+        int channels = qMin(LedDeviceDmx::LedsPerUniverse, ledsCount - i * LedDeviceDmx::LedsPerUniverse) * 3;
+
+        QCOMPARE(packet.size(), LedDeviceDmx::E131HeaderSize + channels);
+        QCOMPARE(packet.mid(4, 9), QByteArray("ASC-E1.17"));
+        QCOMPARE(e131Universe(packet), START_UNIVERSE + i);
+        // Property value count includes start code
+        QCOMPARE(((quint8)packet[123] << 8) | (quint8)packet[124], channels + 1);
+        // Sync address
+        QCOMPARE(((quint8)packet[109] << 8) | (quint8)packet[110], START_UNIVERSE);
+
+        for (int j = 0; j < channels / 3; j++)
+        {
+            QRgb color = colors[i * LedDeviceDmx::LedsPerUniverse + j];
+            QCOMPARE((int)(quint8)packet[LedDeviceDmx::E131HeaderSize + j * 3 + 0], qRed(color));
+            QCOMPARE((int)(quint8)packet[LedDeviceDmx::E131HeaderSize + j * 3 + 1], qGreen(color));
+            QCOMPARE((int)(quint8)packet[LedDeviceDmx::E131HeaderSize + j * 3 + 2], qBlue(color));
+        }
+    }
+
+    QVERIFY(isE131Sync(packets[3]));
+    QCOMPARE(((quint8)packets[3][45] << 8) | (quint8)packets[3][46], START_UNIVERSE);
+
+    delete device;
+}
+
+void LedDeviceDmxTest::testCase_ArtNetFrame()
+{
+    QUdpSocket listener;
+    QVERIFY(listener.bind(QHostAddress::LocalHost, LedDeviceDmx::ArtNetPort));
+
+    LedDeviceDmx *device = createDevice(LedDeviceDmx::ProtocolArtNet, &listener);
+    QVERIFY(device != NULL);
+
+    // Odd channels count in the last universe
+    const int ledsCount = LedDeviceDmx::LedsPerUniverse + 5;
+    QList<QRgb> colors = makeColors(ledsCount, 2);
+
+    device->setColors(colors);
+
+    QList<QByteArray> packets = receivePackets(&listener, 3, 1000);
+    QCOMPARE(packets.count(), 3);
+
+    for (int i = 0; i < 2; i++)
+    {
+        QByteArray packet = packets[i];
+        QCOMPARE(packet.left(8), QByteArray("Art-Net\0", 8));
+        QCOMPARE((int)(quint8)packet[9], 0x50);     // OpDmx
+        QVERIFY(packet[12] != 0);                   // sequence enabled
+        QCOMPARE((quint8)packet[14] | (((quint8)packet[15] & 0x7f) << 8), START_UNIVERSE + i);
+
+        int length = ((quint8)packet[16] << 8) | (quint8)packet[17];
+        QCOMPARE(length % 2, 0);
+        QCOMPARE(packet.size(), LedDeviceDmx::ArtNetHeaderSize + length);
+
+        QRgb color = colors[i * LedDeviceDmx::LedsPerUniverse];
+        QCOMPARE((int)(quint8)packet[LedDeviceDmx::ArtNetHeaderSize], qRed(color));
+    }
+    QCOMPARE(((quint8)packets[1][16] << 8) | (quint8)packets[1][17], 5 * 3 + 1);
+
+    QCOMPARE(packets[2].size(), LedDeviceDmx::ArtNetSyncPacketSize);
+    QCOMPARE((int)(quint8)packets[2][9], 0x52);     // OpSync
+
+    delete device;
+}
+
+void LedDeviceDmxTest::testCase_E131Sequence()
+{
+    QUdpSocket listener;
+    QVERIFY(listener.bind(QHostAddress::LocalHost, LedDeviceDmx::E131Port));
+
+    LedDeviceDmx *device = createDevice(LedDeviceDmx::ProtocolE131, &listener);
+    QVERIFY(device != NULL);
+
+    QList<QRgb> colors = makeColors(LedDeviceDmx::LedsPerUniverse * 2, 3);
+    int lastSequence = -1;
+
+    for (int frame = 0; frame < 300; frame++)
+    {
+        device->setColors(colors);
+
+        QList<QByteArray> packets = receivePackets(&listener, 3, 1000);
+        QCOMPARE(packets.count(), 3);
+
+        // All universes of frame share sequence number, it wraps at 255
+        int sequence = e131Sequence(packets[0]);
+        QCOMPARE(e131Sequence(packets[1]), sequence);
+        QCOMPARE((int)(quint8)packets[2][44], sequence);
+
+        if (lastSequence >= 0)
+            QCOMPARE(sequence, (lastSequence + 1) & 0xff);
+        lastSequence = sequence;
+    }
+
+    delete device;
+}
+
+void LedDeviceDmxTest::testCase_FrameLongerThanMaximum()
+{
+    QUdpSocket listener;
+    QVERIFY(listener.bind(QHostAddress::LocalHost, LedDeviceDmx::E131Port));
+
+    LedDeviceDmx *device = createDevice(LedDeviceDmx::ProtocolE131, &listener);
+    QVERIFY(device != NULL);
+
+    // LEDs over maximum are dropped before gamma correction
+    const int universesCount = LedDeviceDmx::MaximumUniverses;
+    device->setColors(makeColors(LedDeviceDmx::LedsPerUniverse * universesCount + 20, 5));
+
+    QList<QByteArray> packets = receivePackets(&listener, universesCount + 2, 300);
+    QCOMPARE(packets.count(), universesCount + 1);
+    QCOMPARE(e131Universe(packets[universesCount - 1]), START_UNIVERSE + universesCount - 1);
+    QCOMPARE(packets[universesCount - 1].size(), LedDeviceDmx::E131HeaderSize + LedDeviceDmx::LedsPerUniverse * 3);
+    QVERIFY(isE131Sync(packets.last()));
+
+    delete device;
+}
+
+void LedDeviceDmxTest::benchmark_E131SustainedRate()
+{
+    QUdpSocket listener;
+    QVERIFY(listener.bind(QHostAddress::LocalHost, LedDeviceDmx::E131Port));
+
+    LedDeviceDmx *device = createDevice(LedDeviceDmx::ProtocolE131, &listener);
+    QVERIFY(device != NULL);
+
+    const int framesCount = FRAME_RATE * 3;
+    const int packetsPerFrame = UNIVERSES_COUNT + 1;
+    const int framePeriod = 1000 / FRAME_RATE;
+
+    QList<QRgb> colors = makeColors(LedDeviceDmx::LedsPerUniverse * UNIVERSES_COUNT, 4);
+
+    int framesComplete = 0;
+    int packetsLost = 0;
+
+    QTime time;
+    time.start();
+
+    for (int frame = 0; frame < framesCount; frame++)
+    {
+        colors[frame % colors.count()] = qRgb(frame, frame, frame);
+        device->setColors(colors);
+
+        QList<QByteArray> packets = receivePackets(&listener, packetsPerFrame, framePeriod);
+        packetsLost += packetsPerFrame - packets.count();
+
+        // Every universe once in order, sync packet after all of them
+        bool ok = (packets.count() == packetsPerFrame);
+        for (int i = 0; ok && i < UNIVERSES_COUNT; i++)
+            ok = (e131Universe(packets[i]) == START_UNIVERSE + i);
+        if (ok && isE131Sync(packets.last()))
+            framesComplete++;
+
+        // Hold the frame rate
+        int nextFrame = (frame + 1) * framePeriod;
+        if (time.elapsed() < nextFrame)
+            QTest::qSleep(nextFrame - time.elapsed());
+    }
+
+    int elapsed = time.elapsed();
+    double fps = framesCount * 1000.0 / elapsed;
+
+    qDebug() << framesCount << "frames of" << UNIVERSES_COUNT << "universes in" << elapsed << "ms:"
+             << fps << "FPS," << framesComplete << "complete frames," << packetsLost << "packets lost";
+
+    QCOMPARE(framesComplete, framesCount);
+    QVERIFY(fps > FRAME_RATE * 0.95);
+
+    delete device;
+}
+
+LedDeviceDmx * LedDeviceDmxTest::createDevice(LedDeviceDmx::Protocol protocol, QUdpSocket * listener)
+{
+    LedDeviceDmx *device = new LedDeviceDmx(protocol, "127.0.0.1", QString::number(START_UNIVERSE));
+
+    if (openDevice(device, listener) == false)
+    {
+        delete device;
+        return NULL;
+    }
+
+    return device;
+}
+
+unsigned g_debugLevel = Debug::LowLevel;
+
+QTEST_MAIN(LedDeviceDmxTest)
+
+#include "LedDeviceDmxTest.moc"
@@ -0,0 +1,48 @@
+#-------------------------------------------------
+#
+# Project created by hands 2026-10-19T12:00:00
+#
+# Tests of E1.31 and Art-Net LED device with local socket
+# as DMX over IP controller
+#
+#-------------------------------------------------
+
+QT         += network testlib
+
+QT         += gui
+
+TARGET      = LedDeviceDmxTest
+DESTDIR     = bin
+
+CONFIG     += console
+CONFIG     -= app_bundle
+
+TEMPLATE    = app
+
+# QMake and GCC produce a lot of stuff
+OBJECTS_DIR = stuff
+MOC_DIR     = stuff
+UI_DIR      = stuff
+RCC_DIR     = stuff
+
+
+INCLUDEPATH += ../../src/ ../common/
+SOURCES += \
+    LedDeviceDmxTest.cpp \
+    ../../src/AbstractLedDevice.cpp \
+    ../../src/LedDeviceDmx.cpp \
+    ../../src/UdpPacketSender.cpp \
+    ../../src/LedFrameMailbox.cpp \
+    ../../src/LedFrameLog.cpp \
+    ../../src/LightpackMath.cpp \
+    ../../src/Settings.cpp
+HEADERS += \
+    ../common/LedDeviceTestHelpers.hpp \
+    ../../src/ILedDevice.hpp \
+    ../../src/AbstractLedDevice.hpp \
+    ../../src/LedDeviceDmx.hpp \
+    ../../src/UdpPacketSender.hpp \
+    ../../src/LedFrameMailbox.hpp \
+    ../../src/LedFrameLog.hpp \
+    ../../src/debug.h \
+    ../../src/Settings.hpp
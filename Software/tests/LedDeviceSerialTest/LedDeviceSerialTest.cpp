@@ -0,0 +1,605 @@
+/*
+ * LedDeviceSerialTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+
+#include "debug.h"
+#include "Settings.hpp"
+#include "LedDeviceAdalight.hpp"
+#include "LedDeviceArdulight.hpp"
+#include "SerialFrameWriter.hpp"
+#include "SerialFrameEncoder.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace SettingsScope;
+
+// Real LedDeviceAdalight and LedDeviceArdulight write to the slave side of
+// pseudo-terminal. Emulator on the master side reads not faster than serial
+// line at given baud rate would deliver bytes, parses frames and saves time
+// of their arrival.
+//
+// Pty has no real output queue (TIOCOUTQ is always 0), so when the line is
+// overloaded kernel pty buffer adds latency before frames are dropped.
+
+static qint64 nowUsec()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+struct ReceivedFrame
+{
+    qint64 timeUsec;
+    QByteArray colors;
+};
+
+class SerialLedEmulator : public QThread
+{
+public:
+    enum Protocol { Adalight, Ardulight };
+
+    // Ardulight frame has no LEDs count, so it must be known
+    SerialLedEmulator(int masterFd, Protocol protocol, int ledsCount, int baudRate)
+    {
+        m_masterFd = masterFd;
+        m_protocol = protocol;
+        m_ledsCount = ledsCount;
+        m_bytesPerUsec = baudRate / 10.0 / 1000000.0; // 8N1
+        m_isStopped = false;
+        m_skippedBytesCount = 0;
+        m_badHeadersCount = 0;
+    }
+
+    void stop()
+    {
+        m_isStopped = true;
+        wait();
+    }
+
+    QList<ReceivedFrame> takeFrames()
+    {
+        QMutexLocker locker(&m_mutex);
+        QList<ReceivedFrame> frames = m_frames;
+        m_frames.clear();
+        return frames;
+    }
+
+    int skippedBytesCount() const { return m_skippedBytesCount; }
+    int badHeadersCount() const { return m_badHeadersCount; }
+
+protected:
+    void run()
+    {
+        // Bytes are read in chunks, like from FIFO of UART
+        const double ChunkSize = 16;
+
+        char buffer[256];
+        double credit = 0;
+        qint64 lastUsec = nowUsec();
+
+        while (m_isStopped == false)
+        {
+            qint64 now = nowUsec();
+            credit = qMin(credit + (now - lastUsec) * m_bytesPerUsec, (double)sizeof(buffer));
+            lastUsec = now;
+
+            if (credit < ChunkSize)
+            {
+                usleep((ChunkSize - credit) / m_bytesPerUsec);
+                continue;
+            }
+
+            struct pollfd fds;
+            fds.fd = m_masterFd;
+            fds.events = POLLIN;
+
+            if (poll(&fds, 1, 10) <= 0 || (fds.revents & POLLIN) == 0)
+            {
+                // Idle line doesn't save up bytes, slave can be closed
+                credit = 0;
+                if (fds.revents & POLLHUP)
+                    usleep(1000);
+                continue;
+            }
+
+            int bytesRead = read(m_masterFd, buffer, (int)credit);
+            if (bytesRead <= 0)
+                continue;
+
+            credit -= bytesRead;
+            parse(buffer, bytesRead, nowUsec());
+        }
+    }
+
+private:
+    void parse(const char *data, int size, qint64 timeUsec)
+    {
+        m_buffer.append(data, size);
+
+        for (;;)
+        {
+            int start = (m_protocol == Adalight) ? m_buffer.indexOf("Ada") : m_buffer.indexOf((char)0xff);
+            if (start < 0)
+            {
+                // Keep possible beginning of "Ada"
+                int keep = (m_protocol == Adalight) ? qMin(2, m_buffer.size()) : 0;
+                m_skippedBytesCount += m_buffer.size() - keep;
+                m_buffer.remove(0, m_buffer.size() - keep);
+                return;
+            }
+            m_skippedBytesCount += start;
+            m_buffer.remove(0, start);
+
+            int headerSize = 1;
+            int ledsCount = m_ledsCount;
+
+            if (m_protocol == Adalight)
+            {
+                headerSize = 6;
+                if (m_buffer.size() < headerSize)
+                    return;
+
+                quint8 hi = m_buffer[3];
+                quint8 lo = m_buffer[4];
+                quint8 checksum = m_buffer[5];
+
+                if ((hi ^ lo ^ 0x55) != checksum)
+                {
+                    m_badHeadersCount++;
+                    m_buffer.remove(0, 1);
+                    continue;
+                }
+                ledsCount = (hi << 8 | lo) + 1;
+            }
+
+            int frameSize = headerSize + ledsCount * 3;
+            if (m_buffer.size() < frameSize)
+                return;
+
+            ReceivedFrame frame;
+            frame.timeUsec = timeUsec;
+            frame.colors = m_buffer.mid(headerSize, ledsCount * 3);
+            m_buffer.remove(0, frameSize);
+
+            QMutexLocker locker(&m_mutex);
+            m_frames << frame;
+        }
+    }
+
+private:
+    int m_masterFd;
+    Protocol m_protocol;
+    int m_ledsCount;
+    double m_bytesPerUsec;
+    volatile bool m_isStopped;
+
+    QByteArray m_buffer;
+    int m_skippedBytesCount;
+    int m_badHeadersCount;
+
+    QMutex m_mutex;
+    QList<ReceivedFrame> m_frames;
+};
+
+class LedDeviceSerialTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    LedDeviceSerialTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanup();
+
+    void testCase_AdalightFrame();
+    void testCase_ArdulightFrame();
+    void testCase_FrameWriterKeepsNewest();
+    void testCase_EncoderGrb();
+    void testCase_Encoder16Bit();
+
+    void benchmark_Throughput_data();
+    void benchmark_Throughput();
+
+private:
+    bool openPty();
+    void closePty();
+    ILedDevice * createDevice(SerialLedEmulator::Protocol protocol, int baudRate);
+    QList<ReceivedFrame> receiveFrames(SerialLedEmulator *emulator, int count, int timeout);
+
+    static QList<QRgb> makeColors(int count, int frameIndex);
+    static QByteArray makeFrameColors(int count, int frameIndex);
+    static int frameIndex(const QByteArray & colors);
+
+private:
+    int m_masterFd;
+    QString m_slaveName;
+    ILedDevice *m_device;
+    SerialLedEmulator *m_emulator;
+};
+
+LedDeviceSerialTest::LedDeviceSerialTest()
+{
+    m_masterFd = -1;
+    m_device = NULL;
+    m_emulator = NULL;
+}
+
+void LedDeviceSerialTest::initTestCase()
+{
+    Settings::Initialize(QDir::currentPath(), true);
+
+    // Colors are sent as is
+    Settings::setDeviceGamma(1.0);
+    Settings::setDeviceBrightness(100);
+}
+
+void LedDeviceSerialTest::cleanup()
+{
+    if (m_emulator != NULL)
+        m_emulator->stop();
+
+    delete m_device;
+    m_device = NULL;
+
+    delete m_emulator;
+    m_emulator = NULL;
+
+    closePty();
+}
+
+void LedDeviceSerialTest::testCase_EncoderGrb()
+{
+    typedef SerialFrameEncoder<AdalightHeader, ColorOrderGrb, 8> GrbEncoder;
+
+    QList<StructRgb> colors;
+    colors << StructRgb() << StructRgb();
+    colors[0].r = 0x11; colors[0].g = 0x22; colors[0].b = 0x33;
+    colors[1].r = 0x44; colors[1].g = 0x55; colors[1].b = 0x1ff; // clamped to 0xff
+
+    QByteArray frame;
+    GrbEncoder::encodeFrame(colors, frame);
+
+    QCOMPARE((int)GrbEncoder::ColorDepth, 256);
+    QCOMPARE(frame.size(), GrbEncoder::frameSize(2));
+    QCOMPARE(frame, QByteArray("Ada\x00\x01\x54" "\x22\x11\x33" "\x55\x44\xff", 12));
+}
+
+void LedDeviceSerialTest::testCase_Encoder16Bit()
+{
+    typedef SerialFrameEncoder<NoHeader, ColorOrderBgr, 16> Bgr16Encoder;
+
+    QList<StructRgb> colors;
+    colors << StructRgb();
+    colors[0].r = 0x1234; colors[0].g = 0xabcd; colors[0].b = 0x10000; // clamped to 0xffff
+
+    QByteArray frame;
+    Bgr16Encoder::encodeFrame(colors, frame);
+
+    // Big-endian channels, blue first
+    QCOMPARE((int)Bgr16Encoder::ColorDepth, 65536);
+    QCOMPARE(frame, QByteArray("\xff\xff" "\xab\xcd" "\x12\x34", 6));
+}
+
+void LedDeviceSerialTest::testCase_AdalightFrame()
+{
+    const int ledsCount = 25;
+
+    QVERIFY(openPty());
+    m_device = createDevice(SerialLedEmulator::Adalight, 115200);
+    QVERIFY(m_device != NULL);
+
+    m_emulator = new SerialLedEmulator(m_masterFd, SerialLedEmulator::Adalight, ledsCount, 115200);
+    m_emulator->start();
+
+    QSignalSpy spyCompleted(m_device, SIGNAL(commandCompleted(bool)));
+    m_device->setColors(makeColors(ledsCount, 1));
+    QCOMPARE(spyCompleted.count(), 1);
+    QCOMPARE(spyCompleted.takeFirst().at(0).toBool(), true);
+
+    QList<ReceivedFrame> frames = receiveFrames(m_emulator, 1, 1000);
+    QCOMPARE(frames.count(), 1);
+    QCOMPARE(frames[0].colors, makeFrameColors(ledsCount, 1));
+
+    QCOMPARE(m_emulator->skippedBytesCount(), 0);
+    QCOMPARE(m_emulator->badHeadersCount(), 0);
+}
+
+void LedDeviceSerialTest::testCase_ArdulightFrame()
+{
+    const int ledsCount = 10;
+
+    QVERIFY(openPty());
+    m_device = createDevice(SerialLedEmulator::Ardulight, 115200);
+    QVERIFY(m_device != NULL);
+
+    m_emulator = new SerialLedEmulator(m_masterFd, SerialLedEmulator::Ardulight, ledsCount, 115200);
+    m_emulator->start();
+
+    m_device->setColors(makeColors(ledsCount, 2));
+
+    QList<ReceivedFrame> frames = receiveFrames(m_emulator, 1, 1000);
+    QCOMPARE(frames.count(), 1);
+    QCOMPARE(frames[0].colors, makeFrameColors(ledsCount, 2));
+
+    QCOMPARE(m_emulator->skippedBytesCount(), 0);
+
+    m_device->offLeds();
+
+    frames = receiveFrames(m_emulator, 1, 1000);
+    QCOMPARE(frames.count(), 1);
+    QCOMPARE(frames[0].colors, QByteArray(ledsCount * 3, 0));
+}
+
+void LedDeviceSerialTest::testCase_FrameWriterKeepsNewest()
+{
+    // Frames are much bigger than pty buffer can take at once
+    const int ledsCount = 500;
+    const int framesCount = 50;
+    const int baudRate = 460800;
+
+    QVERIFY(openPty());
+
+    AbstractSerial serial;
+    serial.setDeviceName(m_slaveName);
+    if (serial.open(AbstractSerial::WriteOnly | AbstractSerial::Unbuffered) == false)
+        QSKIP("Can't open pty slave, is lock directory writable?", SkipSingle);
+    QVERIFY(serial.setBaudRate(QString::number(baudRate)));
+
+    SerialFrameWriter writer;
+    writer.setDevice(&serial);
+    QCOMPARE(writer.baudRate(), baudRate);
+
+    // Emulator isn't started yet, so pty buffer fills up
+    for (int i = 0; i < framesCount; i++)
+    {
+        QByteArray frame = "Ada";
+        frame += (char)(((ledsCount - 1) >> 8) & 0xff);
+        frame += (char)((ledsCount - 1) & 0xff);
+        frame += (char)(frame[3] ^ frame[4] ^ 0x55);
+        frame += makeFrameColors(ledsCount, i);
+
+        QVERIFY(writer.writeFrame(frame));
+    }
+    QVERIFY(writer.droppedFramesCount() > 0);
+
+    m_emulator = new SerialLedEmulator(m_masterFd, SerialLedEmulator::Adalight, ledsCount, baudRate);
+    m_emulator->start();
+
+    QList<ReceivedFrame> frames = receiveFrames(m_emulator, framesCount - writer.droppedFramesCount(), 5000);
+
+    // Started frames are finished, stale pending frames are replaced
+    QCOMPARE(frames.count() + writer.droppedFramesCount(), framesCount);
+    QCOMPARE(m_emulator->skippedBytesCount(), 0);
+
+    for (int i = 0; i < frames.count(); i++)
+        QCOMPARE(frames[i].colors, makeFrameColors(ledsCount, frameIndex(frames[i].colors)));
+
+    QCOMPARE(frameIndex(frames.last().colors), framesCount - 1);
+
+    m_emulator->stop();
+    serial.close();
+}
+
+void LedDeviceSerialTest::benchmark_Throughput_data()
+{
+    QTest::addColumn<int>("protocol");
+    QTest::addColumn<int>("ledsCount");
+    QTest::addColumn<int>("baudRate");
+
+    // Frames are sent every FrameInterval ms, last rows overload the line
+    QTest::newRow("Adalight 25 LEDs 115200")    << (int)SerialLedEmulator::Adalight  << 25  << 115200;
+    QTest::newRow("Adalight 100 LEDs 115200")   << (int)SerialLedEmulator::Adalight  << 100 << 115200;
+    QTest::newRow("Adalight 500 LEDs 500000")   << (int)SerialLedEmulator::Adalight  << 500 << 500000;
+    QTest::newRow("Ardulight 25 LEDs 115200")   << (int)SerialLedEmulator::Ardulight << 25  << 115200;
+    QTest::newRow("Adalight 300 LEDs 115200")   << (int)SerialLedEmulator::Adalight  << 300 << 115200;
+    QTest::newRow("Adalight 500 LEDs 115200")   << (int)SerialLedEmulator::Adalight  << 500 << 115200;
+}
+
+void LedDeviceSerialTest::benchmark_Throughput()
+{
+    QFETCH(int, protocol);
+    QFETCH(int, ledsCount);
+    QFETCH(int, baudRate);
+
+    const int framesCount = 200;
+    const int FrameInterval = 10; // ms
+
+    QVERIFY(openPty());
+    m_device = createDevice((SerialLedEmulator::Protocol)protocol, baudRate);
+    QVERIFY(m_device != NULL);
+
+    m_emulator = new SerialLedEmulator(m_masterFd, (SerialLedEmulator::Protocol)protocol, ledsCount, baudRate);
+    m_emulator->start();
+
+    QVector<qint64> sendTimes(framesCount);
+    qint64 startUsec = nowUsec();
+
+    for (int i = 0; i < framesCount; i++)
+    {
+        sendTimes[i] = nowUsec();
+        m_device->setColors(makeColors(ledsCount, i));
+
+        // Writer finishes partially written frames from event loop
+        QTest::qWait(FrameInterval);
+    }
+
+    // Wait for the last frame, the newest frame is never dropped
+    QList<ReceivedFrame> frames;
+    QTime timeout;
+    timeout.start();
+    while (timeout.elapsed() < 10000)
+    {
+        frames += m_emulator->takeFrames();
+        if (frames.isEmpty() == false && frameIndex(frames.last().colors) == framesCount - 1)
+            break;
+        QTest::qWait(FrameInterval);
+    }
+    qint64 elapsedUsec = qMax(1LL, nowUsec() - startUsec);
+
+    QVERIFY(frames.isEmpty() == false);
+    QCOMPARE(frameIndex(frames.last().colors), framesCount - 1);
+    QCOMPARE(m_emulator->skippedBytesCount(), 0);
+
+    QList<qint64> latencies;
+    int lastIndex = -1;
+    for (int i = 0; i < frames.count(); i++)
+    {
+        int index = frameIndex(frames[i].colors);
+
+        QVERIFY(index > lastIndex && index < framesCount);
+        QCOMPARE(frames[i].colors, makeFrameColors(ledsCount, index));
+
+        latencies << frames[i].timeUsec - sendTimes[index];
+        lastIndex = index;
+    }
+    qSort(latencies);
+
+    int droppedCount = framesCount - frames.count();
+    double lineFps = SerialFrameWriter::maximumFramesPerSecond(baudRate, (protocol == SerialLedEmulator::Adalight ? 6 : 1) + ledsCount * 3);
+
+    qDebug() << QTest::currentDataTag() << ":"
+             << frames.count() * 1000000.0 / elapsedUsec << "FPS (line maximum" << lineFps << "),"
+             << "latency ms p50:" << latencies[latencies.count() / 2] / 1000.0
+             << "p95:" << latencies[latencies.count() * 95 / 100] / 1000.0
+             << "p99:" << latencies[latencies.count() * 99 / 100] / 1000.0
+             << "max:" << latencies.last() / 1000.0 << ","
+             << "dropped frames:" << droppedCount;
+
+    // Line with enough spare bandwidth must deliver every frame
+    if (lineFps > 1.5 * 1000 / FrameInterval)
+        QCOMPARE(droppedCount, 0);
+}
+
+bool LedDeviceSerialTest::openPty()
+{
+    m_masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_masterFd < 0)
+        return false;
+
+    if (grantpt(m_masterFd) != 0 || unlockpt(m_masterFd) != 0)
+    {
+        closePty();
+        return false;
+    }
+
+    m_slaveName = ptsname(m_masterFd);
+    return true;
+}
+
+void LedDeviceSerialTest::closePty()
+{
+    if (m_masterFd >= 0)
+        close(m_masterFd);
+
+    m_masterFd = -1;
+    m_slaveName.clear();
+}
+
+ILedDevice * LedDeviceSerialTest::createDevice(SerialLedEmulator::Protocol protocol, int baudRate)
+{
+    ILedDevice *device;
+
+    if (protocol == SerialLedEmulator::Adalight)
+        device = new LedDeviceAdalight(m_slaveName, QString::number(baudRate));
+    else
+        device = new LedDeviceArdulight(m_slaveName, QString::number(baudRate));
+
+    QSignalSpy spyOpen(device, SIGNAL(openDeviceSuccess(bool)));
+    device->open();
+
+    if (spyOpen.count() != 1 || spyOpen.takeFirst().at(0).toBool() == false)
+    {
+        qWarning() << Q_FUNC_INFO << "Can't open" << m_slaveName << ", is lock directory writable?";
+        delete device;
+        return NULL;
+    }
+
+    return device;
+}
+
+QList<ReceivedFrame> LedDeviceSerialTest::receiveFrames(SerialLedEmulator *emulator, int count, int timeout)
+{
+    QList<ReceivedFrame> frames;
+
+    QTime time;
+    time.start();
+
+    while (frames.count() < count && time.elapsed() < timeout)
+    {
+        // Lets writer finish partial frames
+        QTest::qWait(5);
+        frames += emulator->takeFrames();
+    }
+
+    return frames;
+}
+
+QList<QRgb> LedDeviceSerialTest::makeColors(int count, int frameIndex)
+{
+    // 0xff isn't used, it is start byte of Ardulight frame
+    QList<QRgb> colors;
+    colors << qRgb(frameIndex % 255, frameIndex / 255 % 255, 0x5a);
+
+    for (int i = 1; i < count; i++)
+        colors << qRgb((frameIndex + i) % 255, (frameIndex * 3 + i) % 255, (i * 7) % 255);
+
+    return colors;
+}
+
+QByteArray LedDeviceSerialTest::makeFrameColors(int count, int frameIndex)
+{
+    QList<QRgb> colors = makeColors(count, frameIndex);
+    QByteArray result;
+
+    for (int i = 0; i < colors.count(); i++)
+    {
+        result += (char)qRed(colors[i]);
+        result += (char)qGreen(colors[i]);
+        result += (char)qBlue(colors[i]);
+    }
+    return result;
+}
+
+int LedDeviceSerialTest::frameIndex(const QByteArray & colors)
+{
+    return (quint8)colors[0] + (quint8)colors[1] * 255;
+}
+
+unsigned g_debugLevel = Debug::LowLevel;
+
+QTEST_MAIN(LedDeviceSerialTest)
+
+#include "LedDeviceSerialTest.moc"
@@ -0,0 +1,59 @@
+#-------------------------------------------------
+#
+# Project created by hands 2026-10-19T12:00:00
+#
+# Tests of Adalight and Ardulight LED devices with
+# emulator on the master side of pseudo-terminal
+#
+#-------------------------------------------------
+
+QT         += network testlib
+
+QT         += gui
+
+TARGET      = LedDeviceSerialTest
+DESTDIR     = bin
+
+CONFIG     += console
+CONFIG     -= app_bundle
+
+TEMPLATE    = app
+
+# QMake and GCC produce a lot of stuff
+OBJECTS_DIR = stuff
+MOC_DIR     = stuff
+UI_DIR      = stuff
+RCC_DIR     = stuff
+
+
+INCLUDEPATH += ../../src/
+SOURCES += \
+    LedDeviceSerialTest.cpp \
+    ../../src/AbstractLedDevice.cpp \
+    ../../src/LedDeviceSerial.cpp \
+    ../../src/LedDeviceAdalight.cpp \
+    ../../src/LedDeviceArdulight.cpp \
+    ../../src/SerialFrameWriter.cpp \
+    ../../src/LedFrameMailbox.cpp \
+    ../../src/LedFrameLog.cpp \
+    ../../src/LightpackMath.cpp \
+    ../../src/Settings.cpp
+HEADERS += \
+    ../../src/ILedDevice.hpp \
+    ../../src/AbstractLedDevice.hpp \
+    ../../src/LedDeviceSerial.hpp \
+    ../../src/LedDeviceAdalight.hpp \
+    ../../src/LedDeviceArdulight.hpp \
+    ../../src/SerialFrameWriter.hpp \
+    ../../src/SerialFrameEncoder.hpp \
+    ../../src/LedFrameMailbox.hpp \
+    ../../src/LedFrameLog.hpp \
+    ../../src/debug.h \
+    ../../src/Settings.hpp
+
+include(../../src/qserialdevice/qserialdevice/qserialdevice.pri)
+include(../../src/qserialdevice/qserialdeviceenumerator/qserialdeviceenumerator.pri)
+include(../../src/qserialdevice/unix/ttylocker.pri)
+
+# For QSerialDevice
+LIBS += -ludev
@@ -0,0 +1,232 @@
+/*
+ * LedDeviceUdpTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtCore/QCoreApplication>
+#include <QtNetwork>
+
+#include "debug.h"
+#include "Settings.hpp"
+#include "LedDeviceUdp.hpp"
+#include "LedDeviceTestHelpers.hpp"
+
+using namespace SettingsScope;
+using namespace LedDeviceTestHelpers;
+
+// LedDeviceUdp sends frames to local UDP socket, which stands in for
+// network strip controller and counts received packets.
+
+class LedDeviceUdpTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    LedDeviceUdpTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testCase_Drgb();
+    void testCase_DnrgbSplit();
+    void testCase_FrameLongerThanMaximum();
+    void testCase_OffLeds();
+
+    void benchmark_ThroughputAndLoss();
+
+private:
+    QList<QByteArray> receivePackets(int count, int timeout);
+
+private:
+    QUdpSocket *m_listener;
+    LedDeviceUdp *m_device;
+};
+
+LedDeviceUdpTest::LedDeviceUdpTest()
+{
+    m_listener = NULL;
+    m_device = NULL;
+}
+
+void LedDeviceUdpTest::initTestCase()
+{
+    Settings::Initialize(QDir::currentPath(), true);
+
+    m_listener = new QUdpSocket(this);
+    QVERIFY(m_listener->bind(QHostAddress::LocalHost, 0));
+
+    m_device = new LedDeviceUdp("127.0.0.1", QString::number(m_listener->localPort()), this);
+    QVERIFY(openDevice(m_device, m_listener));
+}
+
+void LedDeviceUdpTest::cleanupTestCase()
+{
+    delete m_device;
+    m_device = NULL;
+}
+
+void LedDeviceUdpTest::testCase_Drgb()
+{
+    QList<QRgb> colors = makeColors(10, 1);
+
+    QSignalSpy spyCompleted(m_device, SIGNAL(commandCompleted(bool)));
+    m_device->setColors(colors);
+    QCOMPARE(spyCompleted.count(), 1);
+    QCOMPARE(spyCompleted.takeFirst().at(0).toBool(), true);
+
+    QList<QByteArray> packets = receivePackets(1, 1000);
+    QCOMPARE(packets.count(), 1);
+
+    QByteArray packet = packets[0];
+    QCOMPARE(packet.size(), 2 + 10 * 3);
+    QCOMPARE((int)packet[0], (int)LedDeviceUdp::ProtocolDrgb);
+    QCOMPARE((int)(quint8)packet[1], LedDeviceUdp::RealtimeTimeout);
+
+    for (int i = 0; i < colors.count(); i++)
+    {
+        QCOMPARE((int)(quint8)packet[2 + i * 3 + 0], qRed(colors[i]));
+        QCOMPARE((int)(quint8)packet[2 + i * 3 + 1], qGreen(colors[i]));
+        QCOMPARE((int)(quint8)packet[2 + i * 3 + 2], qBlue(colors[i]));
+    }
+}
+
+void LedDeviceUdpTest::testCase_DnrgbSplit()
+{
+    const int ledsCount = MaximumNumberOfLeds::Udp;
+    QList<QRgb> colors = makeColors(ledsCount, 2);
+
+    m_device->setColors(colors);
+
+    int packetsCount = (ledsCount + LedDeviceUdp::DnrgbMaximumLeds - 1) / LedDeviceUdp::DnrgbMaximumLeds;
+    QList<QByteArray> packets = receivePackets(packetsCount, 1000);
+    QCOMPARE(packets.count(), packetsCount);
+
+    int led = 0;
+    for (int i = 0; i < packets.count(); i++)
+    {
+        QByteArray packet = packets[i];
+        QCOMPARE((int)packet[0], (int)LedDeviceUdp::ProtocolDnrgb);
+
+        int startIndex = ((quint8)packet[2] << 8) | (quint8)packet[3];
+        QCOMPARE(startIndex, led);
+
+        int count = (packet.size() - 4) / 3;
+        QVERIFY(count <= LedDeviceUdp::DnrgbMaximumLeds);
+
+        for (int j = 0; j < count; j++, led++)
+        {
+            QCOMPARE((int)(quint8)packet[4 + j * 3 + 0], qRed(colors[led]));
+            QCOMPARE((int)(quint8)packet[4 + j * 3 + 1], qGreen(colors[led]));
+            QCOMPARE((int)(quint8)packet[4 + j * 3 + 2], qBlue(colors[led]));
+        }
+    }
+    QCOMPARE(led, ledsCount);
+}
+
+void LedDeviceUdpTest::testCase_FrameLongerThanMaximum()
+{
+    // LEDs over maximum are dropped before gamma correction
+    const int ledsCount = MaximumNumberOfLeds::Udp;
+    m_device->setColors(makeColors(ledsCount + 20, 4));
+
+    int packetsCount = (ledsCount + LedDeviceUdp::DnrgbMaximumLeds - 1) / LedDeviceUdp::DnrgbMaximumLeds;
+    QList<QByteArray> packets = receivePackets(packetsCount + 1, 300);
+    QCOMPARE(packets.count(), packetsCount);
+
+    QByteArray lastPacket = packets.last();
+    int lastStartIndex = ((quint8)lastPacket[2] << 8) | (quint8)lastPacket[3];
+    QCOMPARE(lastStartIndex + (lastPacket.size() - 4) / 3, ledsCount);
+}
+
+void LedDeviceUdpTest::testCase_OffLeds()
+{
+    m_device->setColors(makeColors(10, 3));
+    receivePackets(1, 1000);
+
+    m_device->offLeds();
+
+    QList<QByteArray> packets = receivePackets(1, 1000);
+    QCOMPARE(packets.count(), 1);
+    QCOMPARE(packets[0].mid(2), QByteArray(10 * 3, 0));
+}
+
+void LedDeviceUdpTest::benchmark_ThroughputAndLoss()
+{
+    const int framesCount = 2000;
+    const int ledsCount = MaximumNumberOfLeds::Udp;
+    const int packetsPerFrame = (ledsCount + LedDeviceUdp::DnrgbMaximumLeds - 1) / LedDeviceUdp::DnrgbMaximumLeds;
+
+    QList<QRgb> colors = makeColors(ledsCount, 4);
+
+    int packetsReceived = 0;
+    qint64 bytesReceived = 0;
+
+    QTime time;
+    time.start();
+
+    for (int i = 0; i < framesCount; i++)
+    {
+        colors[i % ledsCount] = qRgb(i, i, i);
+        m_device->setColors(colors);
+
+        // Controller reads packets while the next frame is prepared
+        while (m_listener->hasPendingDatagrams())
+        {
+            QByteArray packet(m_listener->pendingDatagramSize(), 0);
+            m_listener->readDatagram(packet.data(), packet.size());
+            packetsReceived++;
+            bytesReceived += packet.size();
+        }
+    }
+
+    QList<QByteArray> packets = receivePackets(framesCount * packetsPerFrame - packetsReceived, 200);
+    for (int i = 0; i < packets.count(); i++)
+        bytesReceived += packets[i].size();
+    packetsReceived += packets.count();
+
+    int elapsed = qMax(1, time.elapsed());
+    int packetsSent = framesCount * packetsPerFrame;
+    double loss = 100.0 * (packetsSent - packetsReceived) / packetsSent;
+
+    qDebug() << framesCount << "frames of" << ledsCount << "LEDs in" << elapsed << "ms:"
+             << framesCount * 1000.0 / elapsed << "FPS,"
+             << bytesReceived * 8.0 / 1000.0 / elapsed << "Mbit/s,"
+             << "packets lost:" << packetsSent - packetsReceived << "(" << loss << "% )";
+
+    // Loopback doesn't lose packets if the reader keeps up
+    QVERIFY(loss < 1.0);
+}
+
+QList<QByteArray> LedDeviceUdpTest::receivePackets(int count, int timeout)
+{
+    return LedDeviceTestHelpers::receivePackets(m_listener, count, timeout);
+}
+
+unsigned g_debugLevel = Debug::LowLevel;
+
+QTEST_MAIN(LedDeviceUdpTest)
+
+#include "LedDeviceUdpTest.moc"
@@ -0,0 +1,49 @@
+#-------------------------------------------------
+#
+# Project created by hands 2026-10-19T12:00:00
+#
+# Tests of UDP LED device with local socket
+# as network strip controller
+#
+#-------------------------------------------------
+
+QT         += network testlib
+
+QT         += gui
+
+TARGET      = LedDeviceUdpTest
+DESTDIR     = bin
+
+CONFIG     += console
+CONFIG     -= app_bundle
+
+TEMPLATE    = app
+
+# QMake and GCC produce a lot of stuff
+OBJECTS_DIR = stuff
+MOC_DIR     = stuff
+UI_DIR      = stuff
+RCC_DIR     = stuff
+
+
+INCLUDEPATH += ../../src/ ../common/
+SOURCES += \
+    LedDeviceUdpTest.cpp \
+    ../../src/AbstractLedDevice.cpp \
+    ../../src/LedDeviceUdp.cpp \
+    ../../src/UdpPacketSender.cpp \
+    ../../src/LedFrameMailbox.cpp \
+    ../../src/LedFrameLog.cpp \
+    ../../src/LightpackMath.cpp \
+    ../../src/Settings.cpp
+HEADERS += \
+    ../common/LedDeviceTestHelpers.hpp \
+    ../../src/ILedDevice.hpp \
+    ../../src/AbstractLedDevice.hpp \
+    ../../src/LedDeviceUdp.hpp \
+    ../../src/UdpPacketSender.hpp \
+    ../../src/LedFrameMailbox.hpp \
+    ../../src/LedFrameLog.hpp \
+    ../../src/SerialFrameEncoder.hpp \
+    ../../src/debug.h \
+    ../../src/Settings.hpp
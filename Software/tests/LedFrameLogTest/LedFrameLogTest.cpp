@@ -0,0 +1,278 @@
+/*
+ * LedFrameLogTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtCore/QCoreApplication>
+
+#include "debug.h"
+#include "Settings.hpp"
+#include "LedFrameLog.hpp"
+#include "LedFrameReplayer.hpp"
+#include "LedDeviceVirtual.hpp"
+#include "LedDeviceTestHelpers.hpp"
+
+using namespace SettingsScope;
+using namespace LedDeviceTestHelpers;
+
+// Frames are recorded to temporary log and replayed through LedDeviceVirtual
+// and null sink. Set LIGHTPACK_FRAME_LOG to also replay a log recorded with
+// "--record-frames" option of Lightpack.
+
+class LedFrameLogTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    LedFrameLogTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testCase_WriteRead();
+    void testCase_TruncatedLog();
+    void testCase_WrongHeader();
+    void testCase_ReplayVirtualDevice();
+    void testCase_ReplayRealTime();
+
+    void benchmark_Replay_data();
+    void benchmark_Replay();
+
+private:
+    void writeLog(const QString & fileName, int framesCount, int ledsCount, int intervalMsec);
+
+private:
+    QString m_logFileName;
+    QString m_outputLogFileName;
+};
+
+LedFrameLogTest::LedFrameLogTest()
+{
+}
+
+void LedFrameLogTest::initTestCase()
+{
+    Settings::Initialize(QDir::currentPath(), true);
+
+    // Colors are sent as is
+    Settings::setDeviceGamma(1.0);
+    Settings::setDeviceBrightness(100);
+
+    m_logFileName = QDir::temp().filePath("LedFrameLogTest.lpfl");
+    m_outputLogFileName = QDir::temp().filePath("LedFrameLogTest-output.lpfl");
+}
+
+void LedFrameLogTest::cleanupTestCase()
+{
+    QFile::remove(m_logFileName);
+    QFile::remove(m_outputLogFileName);
+}
+
+void LedFrameLogTest::testCase_WriteRead()
+{
+    const int framesCount = 10;
+
+    LedFrameLogWriter writer;
+    QVERIFY(writer.open(m_logFileName));
+
+    for (int i = 0; i < framesCount; i++)
+    {
+        // LEDs count can change while recording
+        writer.write(makeColors(i < 5 ? 10 : 200, i));
+        QTest::qWait(5);
+    }
+    QCOMPARE(writer.framesCount(), framesCount);
+    writer.close();
+
+    QFileInfo info(m_logFileName);
+    QCOMPARE(info.size(), (qint64)(LedFrameLog::HeaderSize + framesCount * LedFrameLog::FrameHeaderSize + (5 * 10 + 5 * 200) * 3));
+
+    LedFrameLogReader reader;
+    QVERIFY(reader.open(m_logFileName));
+
+    QList<QRgb> colors;
+    qint64 timeUsec = -1, lastTimeUsec = -1;
+
+    for (int i = 0; i < framesCount; i++)
+    {
+        QVERIFY(reader.readFrame(colors, timeUsec));
+        QCOMPARE(colors, makeColors(i < 5 ? 10 : 200, i));
+
+        if (i == 0)
+            QCOMPARE(timeUsec, 0LL);
+        else
+            QVERIFY(timeUsec - lastTimeUsec >= 4000);
+
+        lastTimeUsec = timeUsec;
+    }
+
+    QVERIFY(reader.readFrame(colors, timeUsec) == false);
+    QCOMPARE(reader.framesCount(), framesCount);
+}
+
+void LedFrameLogTest::testCase_TruncatedLog()
+{
+    writeLog(m_logFileName, 3, 10, 0);
+
+    // Application was killed in the middle of the last frame
+    QFile file(m_logFileName);
+    QVERIFY(file.resize(file.size() - 5));
+
+    LedFrameLogReader reader;
+    QVERIFY(reader.open(m_logFileName));
+
+    QList<QRgb> colors;
+    qint64 timeUsec;
+
+    QVERIFY(reader.readFrame(colors, timeUsec));
+    QVERIFY(reader.readFrame(colors, timeUsec));
+    QVERIFY(reader.readFrame(colors, timeUsec) == false);
+    QCOMPARE(reader.framesCount(), 2);
+}
+
+void LedFrameLogTest::testCase_WrongHeader()
+{
+    QFile file(m_logFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("not a frames log");
+    file.close();
+
+    LedFrameLogReader reader;
+    QVERIFY(reader.open(m_logFileName) == false);
+}
+
+void LedFrameLogTest::testCase_ReplayVirtualDevice()
+{
+    const int framesCount = 20;
+
+    writeLog(m_logFileName, framesCount, 50, 0);
+
+    LedDeviceVirtual device;
+    LedFrameLogWriter outputLog;
+    QVERIFY(outputLog.open(m_outputLogFileName));
+
+    LedFrameReplayer replayer(&device);
+    replayer.setOutputLog(&outputLog);
+
+    QVERIFY(replayer.replay(m_logFileName, LedFrameReplayer::MaximumSpeed));
+    QCOMPARE(replayer.framesCount(), framesCount);
+    QCOMPARE(replayer.failedFramesCount(), 0);
+    outputLog.close();
+
+    // With gamma 1.0 and brightness 100% output of virtual device is the same,
+    // this is how output of different versions is compared
+    LedFrameLogReader input, output;
+    QVERIFY(input.open(m_logFileName));
+    QVERIFY(output.open(m_outputLogFileName));
+
+    QList<QRgb> inputColors, outputColors;
+    qint64 timeUsec;
+
+    while (input.readFrame(inputColors, timeUsec))
+    {
+        QVERIFY(output.readFrame(outputColors, timeUsec));
+        QCOMPARE(outputColors, inputColors);
+    }
+    QCOMPARE(output.framesCount(), framesCount);
+}
+
+void LedFrameLogTest::testCase_ReplayRealTime()
+{
+    const int framesCount = 20;
+    const int intervalMsec = 10;
+
+    writeLog(m_logFileName, framesCount, 10, intervalMsec);
+
+    LedFrameReplayer replayer(NULL);
+    QVERIFY(replayer.replay(m_logFileName, LedFrameReplayer::RealTime));
+
+    QCOMPARE(replayer.framesCount(), framesCount);
+
+    // Recorded intervals are kept, timers can be a bit late
+    qint64 recordedUsec = (framesCount - 1) * intervalMsec * 1000;
+    QVERIFY(replayer.elapsedUsec() >= recordedUsec - 1000);
+    QVERIFY(replayer.elapsedUsec() < recordedUsec * 2);
+
+    qDebug() << "elapsed:" << replayer.elapsedUsec() << "us, recorded:" << recordedUsec << "us,"
+             << "late frames:" << replayer.lateFramesCount();
+}
+
+void LedFrameLogTest::benchmark_Replay_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<bool>("isNullSink");
+
+    QString fileName = QDir::temp().filePath("LedFrameLogTest-benchmark.lpfl");
+    writeLog(fileName, 2000, MaximumNumberOfLeds::AbsoluteMaximum, 0);
+
+    QTest::newRow("null sink")      << fileName << true;
+    QTest::newRow("virtual device") << fileName << false;
+
+    QString fieldLog = qgetenv("LIGHTPACK_FRAME_LOG");
+    if (fieldLog.isEmpty() == false)
+    {
+        QTest::newRow("field log, null sink")       << fieldLog << true;
+        QTest::newRow("field log, virtual device")  << fieldLog << false;
+    }
+}
+
+void LedFrameLogTest::benchmark_Replay()
+{
+    QFETCH(QString, fileName);
+    QFETCH(bool, isNullSink);
+
+    LedDeviceVirtual device;
+    LedFrameReplayer replayer(isNullSink ? NULL : &device);
+
+    QVERIFY(replayer.replay(fileName, LedFrameReplayer::MaximumSpeed));
+    QVERIFY(replayer.framesCount() > 0);
+
+    qint64 elapsedUsec = qMax(1LL, replayer.elapsedUsec());
+
+    qDebug() << QTest::currentDataTag() << ":" << replayer.framesCount() << "frames in" << elapsedUsec / 1000.0 << "ms,"
+             << replayer.framesCount() * 1000000.0 / elapsedUsec << "FPS,"
+             << "device time per frame:" << (double)replayer.deviceUsec() / replayer.framesCount() << "us,"
+             << "max:" << replayer.maximumFrameUsec() << "us";
+}
+
+void LedFrameLogTest::writeLog(const QString & fileName, int framesCount, int ledsCount, int intervalMsec)
+{
+    LedFrameLogWriter writer;
+    QVERIFY(writer.open(fileName));
+
+    for (int i = 0; i < framesCount; i++)
+    {
+        writer.write(makeColors(ledsCount, i));
+        if (intervalMsec > 0)
+            QTest::qWait(intervalMsec);
+    }
+}
+
+unsigned g_debugLevel = Debug::LowLevel;
+
+QTEST_MAIN(LedFrameLogTest)
+
+#include "LedFrameLogTest.moc"
@@ -0,0 +1,46 @@
+#-------------------------------------------------
+#
+# Project created by hands 2026-10-19T12:00:00
+#
+# Tests of frames log recording and replaying
+# through LED devices
+#
+#-------------------------------------------------
+
+QT         += network testlib
+
+QT         += gui
+
+TARGET      = LedFrameLogTest
+DESTDIR     = bin
+
+CONFIG     += console
+CONFIG     -= app_bundle
+
+TEMPLATE    = app
+
+# QMake and GCC produce a lot of stuff
+OBJECTS_DIR = stuff
+MOC_DIR     = stuff
+UI_DIR      = stuff
+RCC_DIR     = stuff
+
+
+INCLUDEPATH += ../../src/ ../common/
+SOURCES += \
+    LedFrameLogTest.cpp \
+    ../../src/LedFrameLog.cpp \
+    ../../src/LedFrameReplayer.cpp \
+    ../../src/LedDeviceVirtual.cpp \
+    ../../src/LedFrameMailbox.cpp \
+    ../../src/LightpackMath.cpp \
+    ../../src/Settings.cpp
+HEADERS += \
+    ../common/LedDeviceTestHelpers.hpp \
+    ../../src/ILedDevice.hpp \
+    ../../src/LedFrameLog.hpp \
+    ../../src/LedFrameReplayer.hpp \
+    ../../src/LedDeviceVirtual.hpp \
+    ../../src/LedFrameMailbox.hpp \
+    ../../src/debug.h \
+    ../../src/Settings.hpp
@@ -0,0 +1,301 @@
+/*
+ * LightpackMathTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <QtCore/QCoreApplication>
+
+#include "debug.h"
+#include "LightpackMath.hpp"
+
+// Zones are averaged on 32-bit BGRx buffer of the screen size, like X11 and
+// WinAPI grabbers do. Plain sRGB averaging is the loop of X11Grabber.
+
+#define SCREEN_WIDTH        1920
+#define SCREEN_HEIGHT       1080
+#define BYTES_PER_PIXEL     4
+#define ZONE_WIDTH          200
+#define ZONE_HEIGHT         152
+#define ZONES_COUNT         10
+
+class LightpackMathTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    LightpackMathTest();
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testCase_GammaTable();
+    void testCase_GammaTablesIndependent();
+    void testCase_GammaTableLinearLight();
+    void testCase_LinearLightUniform();
+    void testCase_LinearLightBlackWhite();
+
+    void benchmark_AvgColor_data();
+    void benchmark_AvgColor();
+
+private:
+    void fillScreen(int seed);
+    void fillZone(int x, int y, int width, int height, QRgb color);
+    QRgb avgColorSrgb(int x, int y, int width, int height);
+    QRgb avgZones(bool isLinearLight);
+
+private:
+    QByteArray m_screen;
+};
+
+LightpackMathTest::LightpackMathTest()
+{
+}
+
+void LightpackMathTest::initTestCase()
+{
+    m_screen = QByteArray(SCREEN_WIDTH * SCREEN_HEIGHT * BYTES_PER_PIXEL, 0);
+    fillScreen(1);
+}
+
+void LightpackMathTest::testCase_GammaTable()
+{
+    GammaTable table;
+    QList<QRgb> colors;
+    QList<StructRgb> result;
+
+    colors << qRgb(0x10, 0x80, 0xff);
+    result << StructRgb();
+
+    table.gammaCorrection(1.0, colors, result);
+    QCOMPARE(result[0].r, 0x10u);
+    QCOMPARE(result[0].g, 0x80u);
+    QCOMPARE(result[0].b, 0xffu);
+
+    // 12-bit result
+    table.gammaCorrection(1.0, colors, result, 4096);
+    QCOMPARE(result[0].r, 0x100u);
+    QCOMPARE(result[0].g, 0x800u);
+    QCOMPARE(result[0].b, 0xff0u);
+
+    table.gammaCorrection(2.0, colors, result, 4096);
+    QCOMPARE(result[0].g, (unsigned)(4096 * pow(0x80 / 256.0, 2.0)));
+}
+
+void LightpackMathTest::testCase_GammaTablesIndependent()
+{
+    // Devices with different color depth don't rebuild tables of each other
+    GammaTable table8;
+    GammaTable table12;
+    QList<QRgb> colors;
+    QList<StructRgb> result8;
+    QList<StructRgb> result12;
+
+    for (int i = 0; i < 256; i++)
+    {
+        colors << qRgb(i, i, i);
+        result8 << StructRgb();
+        result12 << StructRgb();
+    }
+
+    for (int k = 0; k < 3; k++)
+    {
+        table8.gammaCorrection(2.0, colors, result8, 256);
+        table12.gammaCorrection(2.0, colors, result12, 4096);
+
+        for (int i = 0; i < 256; i++)
+        {
+            QCOMPARE(result8[i].r, (unsigned)(256 * pow(i / 256.0, 2.0)));
+            QCOMPARE(result12[i].r, (unsigned)(4096 * pow(i / 256.0, 2.0)));
+        }
+    }
+}
+
+void LightpackMathTest::testCase_GammaTableLinearLight()
+{
+    // Linear light means are decoded to linear values of the device, gamma is not applied
+    GammaTable table;
+    QList<QRgb> colors;
+    QList<StructRgb> result;
+
+    colors << qRgb(0xff, 188, 0);
+    result << StructRgb();
+
+    table.setLinearLight(true);
+
+    table.gammaCorrection(2.0, colors, result, 256);
+    QCOMPARE(result[0].r, 255u);
+    QVERIFY(qAbs((int)result[0].g - 128) <= 1);
+    QCOMPARE(result[0].b, 0u);
+
+    table.gammaCorrection(2.0, colors, result, 4096);
+    QCOMPARE(result[0].r, 4095u);
+    QVERIFY(qAbs((int)result[0].g - 2048) <= 16);
+
+    table.setLinearLight(false);
+
+    table.gammaCorrection(2.0, colors, result, 4096);
+    QCOMPARE(result[0].g, (unsigned)(4096 * pow(188 / 256.0, 2.0)));
+}
+
+void LightpackMathTest::testCase_LinearLightUniform()
+{
+    // Average of the same pixels is the pixel itself
+    for (int c = 0; c < 256; c++)
+    {
+        fillZone(0, 0, ZONE_WIDTH, ZONE_HEIGHT, qRgb(c, 255 - c, c / 2));
+
+        QRgb avg = LightpackMath::avgColorLinearLight((const unsigned char *)m_screen.constData(),
+                                                      SCREEN_WIDTH * BYTES_PER_PIXEL, BYTES_PER_PIXEL,
+                                                      0, 0, ZONE_WIDTH, ZONE_HEIGHT);
+
+        QVERIFY(qAbs(qRed(avg) - c) <= 1);
+        QVERIFY(qAbs(qGreen(avg) - (255 - c)) <= 1);
+        QVERIFY(qAbs(qBlue(avg) - c / 2) <= 1);
+    }
+
+    fillScreen(1);
+}
+
+void LightpackMathTest::testCase_LinearLightBlackWhite()
+{
+    // Left half is black, right half is white
+    fillZone(0, 0, ZONE_WIDTH / 2, ZONE_HEIGHT, qRgb(0, 0, 0));
+    fillZone(ZONE_WIDTH / 2, 0, ZONE_WIDTH / 2, ZONE_HEIGHT, qRgb(255, 255, 255));
+
+    QRgb srgb = avgColorSrgb(0, 0, ZONE_WIDTH, ZONE_HEIGHT);
+    QRgb linear = LightpackMath::avgColorLinearLight((const unsigned char *)m_screen.constData(),
+                                                     SCREEN_WIDTH * BYTES_PER_PIXEL, BYTES_PER_PIXEL,
+                                                     0, 0, ZONE_WIDTH, ZONE_HEIGHT);
+
+    // Half of the light is sRGB 188, not 128
+    QCOMPARE(qRed(srgb), 128);
+    QVERIFY(qAbs(qRed(linear) - 188) <= 1);
+    QVERIFY(qAbs(qGreen(linear) - 188) <= 1);
+    QVERIFY(qAbs(qBlue(linear) - 188) <= 1);
+
+    fillScreen(1);
+}
+
+void LightpackMathTest::benchmark_AvgColor_data()
+{
+    // Linear light row is expected to cost under 1.3 times of sRGB row
+    QTest::addColumn<bool>("isLinearLight");
+
+    QTest::newRow("sRGB")         << false;
+    QTest::newRow("linear light") << true;
+}
+
+void LightpackMathTest::benchmark_AvgColor()
+{
+    QFETCH(bool, isLinearLight);
+
+    QRgb sum = 0;
+
+    QBENCHMARK {
+        sum += avgZones(isLinearLight);
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void LightpackMathTest::fillScreen(int seed)
+{
+    unsigned char *pixel = (unsigned char *)m_screen.data();
+
+    for (int i = 0; i < m_screen.size(); i++)
+        pixel[i] = (unsigned char)(i * 7 + (i / SCREEN_WIDTH) * 13 + seed);
+}
+
+void LightpackMathTest::fillZone(int x, int y, int width, int height, QRgb color)
+{
+    for (int j = 0; j < height; j++)
+    {
+        unsigned char *pixel = (unsigned char *)m_screen.data()
+                + (y + j) * SCREEN_WIDTH * BYTES_PER_PIXEL + x * BYTES_PER_PIXEL;
+
+        for (int i = 0; i < width; i++)
+        {
+            pixel[0] = qBlue(color);
+            pixel[1] = qGreen(color);
+            pixel[2] = qRed(color);
+
+            pixel += BYTES_PER_PIXEL;
+        }
+    }
+}
+
+QRgb LightpackMathTest::avgColorSrgb(int x, int y, int width, int height)
+{
+    const unsigned char *pbPixelsBuff = (const unsigned char *)m_screen.constData();
+    unsigned r = 0, g = 0, b = 0;
+
+    int count = 0; // count the amount of pixels taken into account
+    for(int j = 0; j < height; j++) {
+        int index = SCREEN_WIDTH * BYTES_PER_PIXEL * (y+j) + x * BYTES_PER_PIXEL;
+        for(int i = 0; i < width; i+=4) {
+            b += pbPixelsBuff[index]   + pbPixelsBuff[index + 4] + pbPixelsBuff[index + 8 ] + pbPixelsBuff[index + 12];
+            g += pbPixelsBuff[index+1] + pbPixelsBuff[index + 5] + pbPixelsBuff[index + 9 ] + pbPixelsBuff[index + 13];
+            r += pbPixelsBuff[index+2] + pbPixelsBuff[index + 6] + pbPixelsBuff[index + 10] + pbPixelsBuff[index + 14];
+            count+=4;
+            index += BYTES_PER_PIXEL * 4;
+        }
+    }
+
+    if( count != 0 ){
+        r = (unsigned)round((double) r / count) & 0xff;
+        g = (unsigned)round((double) g / count) & 0xff;
+        b = (unsigned)round((double) b / count) & 0xff;
+    }
+
+    return qRgb(r, g, b);
+}
+
+QRgb LightpackMathTest::avgZones(bool isLinearLight)
+{
+    QRgb sum = 0;
+
+    for (int z = 0; z < ZONES_COUNT; z++)
+    {
+        // Zones are spread over the screen, X11Grabber loop needs x aligned to 4 pixels
+        int x = z * (SCREEN_WIDTH - ZONE_WIDTH) / (ZONES_COUNT - 1);
+        x -= x % 4;
+        int y = (z % 2) * (SCREEN_HEIGHT - ZONE_HEIGHT);
+
+        if (isLinearLight)
+            sum += LightpackMath::avgColorLinearLight((const unsigned char *)m_screen.constData(),
+                                                      SCREEN_WIDTH * BYTES_PER_PIXEL, BYTES_PER_PIXEL,
+                                                      x, y, ZONE_WIDTH, ZONE_HEIGHT);
+        else
+            sum += avgColorSrgb(x, y, ZONE_WIDTH, ZONE_HEIGHT);
+    }
+
+    return sum;
+}
+
+unsigned g_debugLevel = Debug::LowLevel;
+
+QTEST_MAIN(LightpackMathTest)
+
+#include "LightpackMathTest.moc"
@@ -0,0 +1,36 @@
+#-------------------------------------------------
+#
+# Project created by hands 2026-10-19T12:00:00
+#
+# Tests of gamma tables and linear light averaging,
+# benchmark of averaging zones
+#
+#-------------------------------------------------
+
+QT         += testlib
+
+QT         += gui
+
+TARGET      = LightpackMathTest
+DESTDIR     = bin
+
+CONFIG     += console
+CONFIG     -= app_bundle
+
+TEMPLATE    = app
+
+# QMake and GCC produce a lot of stuff
+OBJECTS_DIR = stuff
+MOC_DIR     = stuff
+UI_DIR      = stuff
+RCC_DIR     = stuff
+
+
+INCLUDEPATH += ../../src/
+SOURCES += \
+    LightpackMathTest.cpp \
+    ../../src/LightpackMath.cpp
+HEADERS += \
+    ../../src/LightpackMath.hpp \
+    ../../src/StructRgb.hpp \
+    ../../src/debug.h
@@ -0,0 +1,82 @@
+/*
+ * LedDeviceTestHelpers.hpp
+ *
+ *  Created on: 19.10.2026
+ *     Project: Lightpack
+ *
+ *  Copyright (c) 2011 Mike Shatohin, mikeshatohin [at] gmail.com
+ *
+ *  Lightpack a USB content-driving ambient lighting system
+ *
+ *  Lightpack is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Lightpack is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QtTest/QtTest>
+#include <QtNetwork>
+
+#include "ILedDevice.hpp"
+
+// Frames and packets of LED devices tests
+namespace LedDeviceTestHelpers
+{
+
+inline QList<QRgb> makeColors(int count, int seed)
+{
+    QList<QRgb> colors;
+    for (int i = 0; i < count; i++)
+        colors << qRgb(seed + i, seed * 2 + i, seed * 3 + i);
+    return colors;
+}
+
+// Returns less than count packets on timeout
+inline QList<QByteArray> receivePackets(QUdpSocket * listener, int count, int timeout)
+{
+    QList<QByteArray> packets;
+
+    while (packets.count() < count)
+    {
+        if (listener->hasPendingDatagrams() == false && listener->waitForReadyRead(timeout) == false)
+            break;
+
+        while (listener->hasPendingDatagrams())
+        {
+            QByteArray packet(listener->pendingDatagramSize(), 0);
+            listener->readDatagram(packet.data(), packet.size());
+            packets << packet;
+        }
+    }
+
+    return packets;
+}
+
+// Opens network device sending to listener, after that colors are sent as
+// is. Frame resent because of settings change is skipped.
+inline bool openDevice(ILedDevice * device, QUdpSocket * listener)
+{
+    QSignalSpy spyOpen(device, SIGNAL(openDeviceSuccess(bool)));
+    device->open();
+
+    if (spyOpen.count() != 1 || spyOpen.takeFirst().at(0).toBool() == false)
+        return false;
+
+    device->setSettings(0, 0, 0, 1.0 /* gamma */, 100 /* brightness */);
+    receivePackets(listener, 1, 1000);
+
+    return true;
+}
+
+} /*LedDeviceTestHelpers*/
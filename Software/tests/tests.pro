@@ -7,4 +7,11 @@
 # -------------------------------------------------
 
 TEMPLATE = subdirs
-SUBDIRS = LightpackApiTest
+SUBDIRS = LightpackApiTest LedDeviceUdpTest LedDeviceDmxTest LedFrameLogTest LightpackMathTest
+
+unix:!macx{
+    # Needs /dev/uhid
+    SUBDIRS += HidrawTest
+    # Needs pseudo-terminals and writable lock directory
+    SUBDIRS += LedDeviceSerialTest
+}